@@ -21,6 +21,25 @@ extern "C" {
  */
 #define __impf_DIFF_H__				6e-4
 
+/*******************************************************************************
+ * Magic numbers used in LP models
+ ******************************************************************************/
+
+/* The largest m * n of a model whose dense coefficients are also allocated */
+#define __impf_LP_DENSE_MAX__			4194304
+
+/* The largest number of pricing rules registered by users */
+#define __impf_LP_PRICING_MAX__			16
+
+/* Controllers of LP presolve: coefficients regarded as zero, the tolerance
+ * of bounds, the largest number of passes, and the largest implied bound
+ * taken by a variable
+ */
+#define __impf_CTR_PRESOLVE_ZERO__		1e-12
+#define __impf_CTR_PRESOLVE_FEAS__		1e-9
+#define __impf_CTR_PRESOLVE_PASSES__		32
+#define __impf_CTR_PRESOLVE_BOUND__		1e6
+
 /*******************************************************************************
  * Magic numbers uses in simplex algorithm
  *
@@ -45,13 +64,203 @@ extern "C" {
 /* Checker of the checking "LP is degenerated" */
 #define __impf_CHC_SPLX_DEGENERATED__		1e-12
 
-/* Controller for pivot leaving rule */
-#define __impf_CTR_SPLX_PIV_LEV__		1e-15
+/* Controller of the largest number of geometric mean scaling passes over the
+ * constraints before equilibration
+ */
+#define __impf_CTR_SPLX_SCALE_PASSES__		8
+
+/* Controller of the smallest pivot of crash basis, relative to the largest
+ * entry of the column
+ */
+#define __impf_CTR_SPLX_CRASH_PIV__		1e-1
+
+/* Controller of the smallest number of table entries touched by each thread
+ * sharing a loop, e.g. rows of the ratio test or columns of pricing
+ */
+#define __impf_CTR_SPLX_PARALLEL__		1024
+
+/* Controller of the largest density of the pivot row whose nonzeros are
+ * gathered, so that the update of other rows only touches these columns
+ */
+#define __impf_CTR_SPLX_SPARSE__		0.3
+
+/* Controller of the shortest segment recorded by parametric LP, relative to
+ * 1 + t
+ */
+#define __impf_CTR_SPLX_PARAM_SEG__		1e-9
+
+/* Controllers for pivot leaving rule: the smallest pivot, and the tolerance
+ * of bounds of basic variables in Harris' ratio test
+ */
+#define __impf_CTR_SPLX_PIV_LEV__		1e-9
+#define __impf_CTR_SPLX_HARRIS__		1e-9
 
 /* Controllers for Bland's rule */
 #define __impf_CTR_SPLX_BLAND_EPS__		1e-6
 #define __impf_CTR_SPLX_BLAND_EPS_MIN__		__impf_IDF_SPLX_ZEROS_BETA__
 
+/* Controllers for partial and multiple pricing: the number of windows columns
+ * are divided into, and the length of the candidate list
+ */
+#define __impf_CTR_SPLX_PRICE_SEGS__		8
+#define __impf_CTR_SPLX_PRICE_CANDS__		8
+
+/* Controller of degenerate basic variables in Pan's rule */
+#define __impf_CTR_SPLX_PAN_DEGEN__		1e-9
+
+/* Controller of the relative rhs perturbation against degeneracy */
+#define __impf_CTR_SPLX_PERTURB__		1e-6
+
+/* Controller of the number of pivots without improvement before the rhs is
+ * perturbed, and then before Bland's rule is used
+ */
+#define __impf_CTR_SPLX_DEGEN__			50
+
+/* Controllers of the column-major simplex table: the least number of rows,
+ * and the largest ratio of variables to rows (see `simplex_by_col`)
+ */
+#define __impf_CTR_SPLX_COLMAJOR__		512
+#define __impf_CTR_SPLX_COLMAJOR_RATIO__	2
+
+/* Controller of the tiles copying simplex table between layouts */
+#define __impf_CTR_SPLX_TILE__			32
+
+/*******************************************************************************
+ * Magic numbers uses in revised simplex algorithm
+ ******************************************************************************/
+
+/* Identifier of singular pivot in basis factorization */
+#define __impf_IDF_RSPLX_LU_ZERO__		1e-11
+
+/* Controller of primal feasibility (basic variables within bounds) */
+#define __impf_CTR_RSPLX_PRIMAL_FEAS__		1e-7
+
+/* Controller of dual feasibility (reduced costs of nonbasic variables) */
+#define __impf_CTR_RSPLX_DUAL_FEAS__		1e-7
+
+/* Controller of the smallest pivot element accepted by the ratio test */
+#define __impf_CTR_RSPLX_PIVOT__		1e-9
+
+/* Controller of the reduced cost recomputed from the FTRAN column */
+#define __impf_CTR_RSPLX_PRICE__		1e-6
+
+/* Controller of the eta file length before the basis is refactorized */
+#define __impf_CTR_RSPLX_REFACTOR__		64
+
+/* Controller of the relative bound perturbation against degeneracy */
+#define __impf_CTR_RSPLX_PERTURB__		1e-6
+
+/* Controller of the number of degenerate pivots before bounds are perturbed,
+ * and then before Bland's rule is used
+ */
+#define __impf_CTR_RSPLX_DEGEN__		50
+
+/*******************************************************************************
+ * Magic numbers uses in interior point method
+ ******************************************************************************/
+
+/* Identifier of a vanishing Cholesky pivot (dependent row), relative to the
+ * diagonal of the normal equations
+ */
+#define __impf_IDF_IPM_CHOL_ZERO__		1e-14
+
+/* Identifier of the pivot replacing a vanishing one */
+#define __impf_IDF_IPM_CHOL_HUGE__		1e64
+
+/* Controller of relative residuals and relative duality gap of optimality */
+#define __impf_CTR_IPM_OPTIMAL__		1e-8
+
+/* Controller of the fraction of steps to the boundary */
+#define __impf_CTR_IPM_STEP__			0.9995
+
+/* Controller of the smallest step lengths before giving up */
+#define __impf_CTR_IPM_STEP_MIN__		1e-10
+
+/* Controller of the steps of iterative refinement of each direction */
+#define __impf_CTR_IPM_REFINE__			1
+
+/* Controller of the decrease of complementarity regarded as a stall, if the
+ * residuals are not small
+ */
+#define __impf_CTR_IPM_STALL__			1e-20
+
+/* Controller of the growth of iterates regarded as divergence */
+#define __impf_CTR_IPM_DIVERGE__		1e12
+
+/*******************************************************************************
+ * Magic numbers uses in primal-dual hybrid gradient method
+ ******************************************************************************/
+
+/* Controller of the iterations of Ruiz equilibration before the
+ * Pock-Chambolle scaling
+ */
+#define __impf_CTR_PDHG_RUIZ__			10
+
+/* Controller of the iterations between checks of termination, infeasibility
+ * and restarts
+ */
+#define __impf_CTR_PDHG_EVAL__			64
+
+/* Controller of the decrease of KKT error since the last restart for which a
+ * restart is done at once
+ */
+#define __impf_CTR_PDHG_RESTART_SUFFICIENT__	0.2
+
+/* Controller of the decrease of KKT error since the last restart for which a
+ * restart is done once the error stops decreasing
+ */
+#define __impf_CTR_PDHG_RESTART_NECESSARY__	0.8
+
+/* Controller of the fraction of all iterations since the last restart, after
+ * which a restart is forced
+ */
+#define __impf_CTR_PDHG_RESTART_ARTIFICIAL__	0.36
+
+/* Controller of the smoothing of the primal weight at restarts */
+#define __impf_CTR_PDHG_WEIGHT_SMOOTH__		0.5
+
+/* Controller of the smallest norms from which the primal weight is updated */
+#define __impf_CTR_PDHG_WEIGHT_ZERO__		1e-10
+
+/* Controller of the factor by which the primal weight may move away from its
+ * initial value
+ */
+#define __impf_CTR_PDHG_WEIGHT_RANGE__		1e4
+
+/* Controller of the relative residual of a ray certifying infeasibility or
+ * unboundedness
+ */
+#define __impf_CTR_PDHG_RAY__			1e-8
+
+/* Controller of the rounding of the residual of a ray, relative to the norm
+ * of the iterate from which it is taken
+ */
+#define __impf_CTR_PDHG_RAY_ROUND__		1e-14
+
+/* Controller of the smallest number of entries touched by a loop before it is
+ * shared by threads
+ */
+#define __impf_CTR_PDHG_PARALLEL__		16384
+
+/*******************************************************************************
+ * Magic numbers uses in branch-and-bound
+ ******************************************************************************/
+
+/* Controller of the distance to the nearest integer within which a variable
+ * is regarded as integer
+ */
+#define __impf_CTR_MIP_INTEGER__		1e-6
+
+/* Controller of the relative gap to the incumbent within which a node is
+ * pruned
+ */
+#define __impf_CTR_MIP_GAP__			1e-9
+
+/* Controller of the smallest estimated increase of the objective in a branch
+ * when scoring pseudo-costs
+ */
+#define __impf_CTR_MIP_PSEUDO__			1e-6
+
 #ifdef __cpluscplus
 }
 #endif /* __cpluscplus */
@@ -0,0 +1,34 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#ifndef __IMPF__SIMD_H__
+#define __IMPF__SIMD_H__
+
+#ifdef __cpluscplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* SIMD kernels of x86 are compiled with GCC or Clang, whose function attribute
+ * `target` allows instructions beyond the compiler flags. Kernels are chosen
+ * at run time (see `impf_linalg_simd`), other compilers and platforms only use
+ * the scalar loops
+ */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define IMPF_SIMD_X86
+#include <immintrin.h>
+#define IMPF_TARGET_SSE2	__attribute__((target("sse2")))
+#define IMPF_TARGET_AVX2	__attribute__((target("avx2")))
+#define IMPF_TARGET_AVX512	__attribute__((target("avx512f")))
+#endif
+
+/* Multiplications and additions of kernels are not contracted to FMA, so that
+ * results do not depend on the instruction set. Sources of kernels are built
+ * with `-ffp-contract=off` (see CMakeLists.txt and setup.py)
+ */
+
+#ifdef __cpluscplus
+}
+#endif /* __cpluscplus */
+
+#endif
@@ -12,12 +12,23 @@
 extern "C" {
 #endif /* __cplusplus */
 
-/* Linear programming model */
+/* Linear programming model
+ *
+ * Note:
+ *	1. the constraint matrix is always stored column compressed (`colptr`,
+ *		`rowidx`, `values`)
+ *	2. the row major `coefficients` (pointed by `coef` of each constraint)
+ *		is only allocated for small models, otherwise it is `NULL`
+ */
 struct impf_Model_LP {
 	int m;			/* number of constraints */
 	int n;			/* number of variables */
+	int nnz;		/* number of nonzero coefficients */
 	double *objective;
-	double *coefficients;	/* row major */
+	double *coefficients;	/* row major, or `NULL` */
+	int *colptr;		/* column starts in `rowidx` and `values` (length = n + 1) */
+	int *rowidx;		/* row indices of nonzeros (length = nnz) */
+	double *values;		/* nonzero coefficients (length = nnz) */
 	struct impf_LinearConstraint *constraints;
 	struct impf_VariableBound *bounds;
 };
@@ -36,6 +47,65 @@ struct impf_Model_LP* impf_lp_readmps(const char *file);
 /* Release the LP model */
 void impf_lp_free(struct impf_Model_LP *model);
 
+/*******************************************************************************
+ * Presolve of LP
+ ******************************************************************************/
+
+/* Presolved LP and the record to recover the solution of the original LP
+ *
+ * Note:
+ *	1. the presolved LP is of general form (see `impf_lp_simplex`), with
+ *		row major `coefficients` pointed by `coef` of each constraint
+ *	2. column `t` of the presolved LP is variable `colmap[t]` of the
+ *		original LP, or the negative of variable `-1 - colmap[t]` if
+ *		`colmap[t] < 0`
+ *	3. `ops` records the eliminated variables in order, see
+ *		`impf_lp_postsolve`
+ */
+struct impf_LP_Presolve {
+	int m;			/* number of constraints of the presolved LP */
+	int n;			/* number of variables of the presolved LP */
+	double *objective;
+	double *coefficients;
+	struct impf_LinearConstraint *constraints;
+	struct impf_VariableBound *bounds;
+	double offset;		/* objective of original LP = presolved + offset */
+	int n0;			/* number of variables of the original LP */
+	int *colmap;		/* (length = n) */
+	int nops;		/* number of eliminations */
+	struct impf_LP_PresolveOp *ops;
+};
+
+/* Presolve LP of general form (see `impf_lp_simplex` for parameters)
+ *
+ * Reductions are applied repeatedly until none is found:
+ *	1. empty rows, and singleton rows as bounds of the variable
+ *	2. forcing rows fixing all their variables, and redundant rows
+ *	3. fixed variables, empty and dominated columns
+ *	4. equations of two variables, by substituting one of them
+ *	5. rows proportional to another row
+ *	6. infinite bounds of variables tightened by rows
+ *
+ * Note:
+ *	1. infeasibility (`impf_Infeasibility`) could be detected directly,
+ *		while unboundedness is left to the solver
+ *	2. `ps` should be released by `impf_lp_presolve_free` on success
+ *
+ * Return: `EXIT_SUCCESS` or `EXIT_FAILURE`
+ */
+int impf_lp_presolve(const double *objective, const struct impf_LinearConstraint *constraints,
+		     const struct impf_VariableBound *bounds, const int m, const int n,
+		     struct impf_LP_Presolve *ps, int *code);
+
+/* Recover solution `x0` (length = `ps->n0`) and objective `value0` of the
+ * original LP from solution `x` and objective `value` of the presolved LP
+ */
+void impf_lp_postsolve(const struct impf_LP_Presolve *ps, const double *x, const double value,
+		       double *x0, double *value0);
+
+/* Release the presolved LP */
+void impf_lp_presolve_free(struct impf_LP_Presolve *ps);
+
 /*******************************************************************************
  * Optimization of "lp-simplex-family"
  ******************************************************************************/
@@ -48,6 +118,9 @@ void impf_lp_free(struct impf_Model_LP *model);
  *
  * where x is n-dimensional vector and b is m-dimensional vector
  *
+ * The LP is presolved (see `impf_lp_presolve`) before solving, see
+ * `impf_lp_simplex_gen` to solve it as it is
+ *
  * Parameters
  *	objective	coefficients of objective function (length = n)
  *	constraints	linear constraint array (length = m)
@@ -60,7 +133,15 @@ void impf_lp_free(struct impf_Model_LP *model);
  *				0) ""		default
  *				1) "dantzig"	Dantzig's original rule
  *				2) "bland"	Bland's rule
- *				3) "pan97"	Pan (1997)
+ *				3) "pan97"	Pan (1997), largest-distance rule preferring
+ *						nondegenerate pivots
+ *				4) "devex"	Devex reference weights
+ *				5) "steepest"	steepest edge
+ *				6) "partial"	Dantzig's rule with partial and multiple
+ *						pricing, for LPs with n >> m
+ *				7) "revised"	revised simplex (see `impf_lp_simplex_rev`)
+ *				or the name of a registered pricing rule (see
+ *				`impf_lp_pricing_register`)
  *	niter		iteration limit
  *	x		array of solutions (length = n)
  *	value		optimal value of the objective
@@ -73,20 +154,57 @@ int impf_lp_simplex(const double *objective, const struct impf_LinearConstraint
 		    const int m, const int n, const char *criteria, const int niter,
 		    double *x, double *value, int *code);
 
+/* Simplex algorithm of `impf_lp_simplex` without presolve, the LP is only
+ * transformed into the standard form with upper bounds (see
+ * `impf_lp_simplex_bnd`)
+ *
+ * Return: `EXIT_SUCCESS` or `EXIT_FAILURE`
+ */
+int impf_lp_simplex_gen(const double *objective, const struct impf_LinearConstraint *constraints,
+			const struct impf_VariableBound *bounds,
+			const int m, const int n, const char *criteria, const int niter,
+			double *x, double *value, int *code);
+
 /* Simplex algorithm for solving LP of general form
  * (Wrapper of `impf_fmin_lp_simplex_full` by taking `impf_Model_LP` as input)
  *
  * Note:
  * 	1. to use this method, users can either create `impf_Model_LP` manually
  *		or get a model from `impf_lp_readmps`
-	2. to manually create model, TAKE CARE of the inner relation of struct
-		`impf_Model_LP`, where you should map coefs to constraints
+ *	2. to manually create model, TAKE CARE of the inner relation of struct
+ *		`impf_Model_LP`, where you should map coefs to constraints
+ *	3. models without dense `coefficients` are solved by `impf_lp_simplex_csc`
  *
  * Return: `EXIT_SUCCESS` or `EXIT_FAILURE`
  */
 int impf_lp_simplex_wrp(const struct impf_Model_LP *model, const char *criteria, const int niter,
 			double *x, double *value, int *code);
 
+/* Solve independent LP models by `impf_lp_simplex_wrp`, shared by `nthreads`
+ * threads
+ *
+ * Parameters:
+ *	models		LP models (length = nmodel)
+ *	nmodel		number of models
+ *	criteria	pivot criteria, see `impf_lp_simplex`
+ *	niter		iteration limit of each model
+ *	nthreads	number of threads
+ *	x		solutions, `x[k]` of model k (length = `models[k].n`)
+ *	value		optimal values (length = nmodel)
+ *	code		error codes (length = nmodel)
+ *
+ * Note:
+ *	1. results do not depend on the number of threads
+ *	2. a registered pricing rule with state should not be used if
+ *		`nthreads > 1`, since its callbacks are called by all threads
+ *	3. it runs on one thread if the library is built without OpenMP
+ *	4. solvers do not print progress on threads, see `impf_prt_dev`
+ *
+ * Return: `EXIT_SUCCESS` if all models are solved, otherwise `EXIT_FAILURE`
+ */
+int impf_lp_simplex_batch(const struct impf_Model_LP *models, const int nmodel, const char *criteria,
+			  const int niter, const int nthreads, double **x, double *value, int *code);
+
 /* Simplex algorithm for solving LP of standard form
  *
  *	min  c'x
@@ -95,6 +213,13 @@ int impf_lp_simplex_wrp(const struct impf_Model_LP *model, const char *criteria,
  *
  * where x is n-dimensional vector and b is m-dimensional vector
  *
+ * Rows and columns of the constraints are scaled by powers of 2 (geometric
+ * mean scaling followed by equilibration) before solving, and the solution
+ * is unscaled afterwards
+ *
+ * Phase 1 starts from a triangular crash basis, where structural variables
+ * replace the artificial variables of EQ and GE rows if feasible
+ *
  * Parameters:
  *	objective	coefficients of objective function (length = n)
  *	constraints	linear constraint array (length = m)
@@ -104,7 +229,14 @@ int impf_lp_simplex_wrp(const struct impf_Model_LP *model, const char *criteria,
  *				0) ""		default
  *				1) "dantzig"	Dantzig's original rule
  *				2) "bland"	Bland's rule
- *				3) "pan97"	Pan (1997)
+ *				3) "pan97"	Pan (1997), largest-distance rule preferring
+ *						nondegenerate pivots
+ *				4) "devex"	Devex reference weights
+ *				5) "steepest"	steepest edge
+ *				6) "partial"	Dantzig's rule with partial and multiple
+ *						pricing, for LPs with n >> m
+ *				or the name of a registered pricing rule (see
+ *				`impf_lp_pricing_register`)
  *	x		array of solutions (length = n)
  *	value		optimal value of the objective
  *	code		error code (see basic.h)
@@ -116,10 +248,493 @@ int impf_lp_simplex_std(const double *objective, const struct impf_LinearConstra
 			const int m, const int n, const char *criteria, const int niter,
 			double *x, double *value, int *code);
 
+/* Simplex algorithm for solving LP of standard form with upper bounds
+ *
+ *	min  c'x
+ *	s.t. Ai x =(, >=, <=) bi, i = 1, ..., m
+ *		0 <= x <= ub
+ *
+ * Upper bounds are handled in the ratio test (a nonbasic variable could sit
+ * at its upper bound) instead of being added as constraints.
+ *
+ * Parameters: see `impf_lp_simplex_std`, except
+ *	ub		upper bounds (length = n, `__impf_INF__` if unbounded),
+ *			`NULL` pointer indicating no upper bound
+ *
+ * Return: `EXIT_SUCCESS` or `EXIT_FAILURE`
+ */
+int impf_lp_simplex_bnd(const double *objective, const struct impf_LinearConstraint *constraints,
+			const double *ub, const int m, const int n, const char *criteria, const int niter,
+			double *x, double *value, int *code);
+
+/* Sensitivity analysis of the optimal basis of LP of standard form with
+ * upper bounds (see `impf_lp_simplex_bnd`), each array could be `NULL` if not
+ * needed
+ *
+ * Members:
+ *	dual		shadow prices, the rate of the optimal value per unit
+ *			increase of the rhs of each constraint (length = m)
+ *	redcost		reduced costs of variables, 0 if basic (length = n)
+ *	objlo, objup	range of the cost of each variable, within which the
+ *			basis stays optimal (length = n)
+ *	rhslo, rhsup	range of the rhs of each constraint, within which the
+ *			basis stays feasible (length = m)
+ *
+ * Note: infinite ends of ranges are `__impf_NINF__` or `__impf_INF__`
+ */
+struct impf_LP_Sensitivity {
+	double *dual;
+	double *redcost;
+	double *objlo;
+	double *objup;
+	double *rhslo;
+	double *rhsup;
+};
+
+/* Simplex algorithm of `impf_lp_simplex_bnd` with sensitivity analysis
+ *
+ * Parameters: see `impf_lp_simplex_bnd`, except
+ *	sens		arrays of sensitivity analysis, filled in on success
+ *
+ * Note: duals and rhs ranges of "EQ" constraints are solved from the basis
+ *	matrix (dense, m * m), others are read from the optimal table
+ *
+ * Return: `EXIT_SUCCESS` or `EXIT_FAILURE`
+ */
+int impf_lp_simplex_sens(const double *objective, const struct impf_LinearConstraint *constraints,
+			 const double *ub, const int m, const int n, const char *criteria, const int niter,
+			 double *x, double *value, struct impf_LP_Sensitivity *sens, int *code);
+
+#define impf_BASIS_T_BASIC	0	/* basic */
+#define impf_BASIS_T_LOWER	1	/* nonbasic at lower bound */
+#define impf_BASIS_T_UPPER	2	/* nonbasic at upper bound */
+
+/* Simplex algorithm of `impf_lp_simplex_bnd` with warm start
+ *
+ * The basis is described by the status (`impf_BASIS_T_*`) of variables
+ * x_1, ..., x_n followed by the slacks of constraints 1, ..., m. The slack of
+ * an "EQ" constraint is always `impf_BASIS_T_LOWER`.
+ *
+ * Parameters: see `impf_lp_simplex_bnd`, except
+ *	status0		status of the starting basis (length = n + m), or `NULL`
+ *			pointer to start from scratch
+ *	status		status of the optimal basis (length = n + m), or `NULL`
+ *
+ * Note: Phase 1 is skipped if `status0` is a basis with feasible basic
+ *	solution, otherwise the LP is solved from scratch
+ *
+ * Return: `EXIT_SUCCESS` or `EXIT_FAILURE`
+ */
+int impf_lp_simplex_warm(const double *objective, const struct impf_LinearConstraint *constraints,
+			 const double *ub, const int m, const int n, const char *criteria, const int niter,
+			 const int *status0, int *status, double *x, double *value, int *code);
+
+/* Trace of parametric LP (see `impf_lp_simplex_param`), the optimal value is
+ * piecewise linear in t with breakpoints `t[0] = 0 < t[1] < ... < t[nseg]`,
+ * and the optimal basis is unchanged in each segment [t[k], t[k + 1]]
+ *
+ * Members:
+ *	nseg		number of segments
+ *	t		breakpoints (length = nseg + 1)
+ *	value		optimal values at breakpoints (length = nseg + 1)
+ *	x		solution at `t[k]` of the basis of segment k (of the last
+ *			segment if k = nseg), starting at `x + k * n`
+ *			(length = (nseg + 1) * n)
+ *	status		basis of segment k (see `impf_lp_simplex_warm`), starting
+ *			at `status + k * (n + m)` (length = nseg * (n + m))
+ *	stop		why the trace stops at `t[nseg]`:
+ *				0) `impf_Success`		`tmax` is reached
+ *				1) `impf_Infeasibility`	LP is infeasible beyond
+ *				2) `impf_Unboundedness`	LP is unbounded beyond
+ */
+struct impf_LP_Parametric {
+	int nseg;
+	double *t;
+	double *value;
+	double *x;
+	int *status;
+	int stop;
+};
+
+/* Parametric simplex algorithm of LP of `impf_lp_simplex_bnd`, where either
+ * the rhs or the objective moves along a direction
+ *
+ *	min  (c + t dc)'x
+ *	s.t. Ai x =(, >=, <=) bi + t dbi, i = 1, ..., m
+ *		0 <= x <= ub
+ *
+ * for t in [0, tmax]. The LP is solved at t = 0, and then the optimal basis is
+ * followed by one pivot at each breakpoint (dual simplex pivot for the rhs,
+ * primal simplex pivot for the objective)
+ *
+ * Parameters: see `impf_lp_simplex_bnd`, except
+ *	drhs		direction of the rhs (length = m), or `NULL`
+ *	dobj		direction of the objective (length = n), or `NULL`
+ *	tmax		end of the range of t (finite, >= 0)
+ *	trace		breakpoints and bases (see `impf_LP_Parametric`)
+ *
+ * Note:
+ *	1. exactly one of `drhs` and `dobj` should be given
+ *	2. `niter` limits the pivots of solving and tracing together
+ *	3. `trace` should be released by `impf_lp_parametric_free` on success
+ *
+ * Return: `EXIT_SUCCESS` or `EXIT_FAILURE`
+ */
+int impf_lp_simplex_param(const double *objective, const struct impf_LinearConstraint *constraints,
+			  const double *ub, const int m, const int n, const char *criteria, const int niter,
+			  const double *drhs, const double *dobj, const double tmax,
+			  struct impf_LP_Parametric *trace, int *code);
+
+/* Release the trace of parametric LP */
+void impf_lp_parametric_free(struct impf_LP_Parametric *trace);
+
+/* Layout of the simplex table while pivoting (see `impf_LP_Workspace`) */
+#define impf_TABLE_T_AUTO	0	/* chosen by the shape of LP */
+#define impf_TABLE_T_ROW	1	/* row-major */
+#define impf_TABLE_T_COL	2	/* column-major */
+
+/* Workspace of the simplex algorithm of standard form, holding the simplex
+ * table and all buffers of a solve, so that repeated solves of LPs of the
+ * same size allocate no memory
+ *
+ * Solves in the workspace share rows of the pivot update, the built-in
+ * pricing scans ("dantzig", "devex", "steepest") and the ratio test among
+ * `nthreads` threads on large tables. The pivots do not depend on the number
+ * of threads.
+ *
+ * Note:
+ *	1. it is created by `impf_lp_workspace_init` and released by
+ *		`impf_lp_workspace_free`
+ *	2. it is enlarged by solves of larger LPs
+ *	3. a workspace should not be shared by solves running in parallel
+ *	4. `nthreads` is 1 when created, and has no effect if the library is
+ *		built without OpenMP
+ *	5. `layout` is `impf_TABLE_T_AUTO` when created, by which tall LPs
+ *		are pivoted on a column-major copy of the table, so that the
+ *		ratio test reads contiguous columns; the copy doubles the size
+ *		of the table in the workspace. Pricing rules registered by
+ *		`impf_lp_pricing_register` always read the row-major table
+ */
+struct impf_LP_Workspace {
+	int m;			/* largest number of constraints fitted */
+	int n;			/* largest number of variables fitted */
+	int nthreads;		/* number of threads of a solve (>= 1) */
+	int layout;		/* layout of table, `impf_TABLE_T_*` */
+	int ndbl;		/* length of `dbl` */
+	int nint;		/* length of `ints` */
+	double *dbl;
+	int *ints;
+};
+
+/* Create workspace fitting LPs of standard form with `m` constraints and `n`
+ * variables
+ *
+ * Return: `EXIT_SUCCESS` or `EXIT_FAILURE`
+ */
+int impf_lp_workspace_init(struct impf_LP_Workspace *ws, const int m, const int n, int *code);
+
+/* Release the workspace */
+void impf_lp_workspace_free(struct impf_LP_Workspace *ws);
+
+/* Simplex algorithm of `impf_lp_simplex_warm` in workspace `ws`
+ *
+ * Parameters: see `impf_lp_simplex_warm`, except
+ *	ws		workspace (see `impf_LP_Workspace`)
+ *
+ * Note:
+ *	1. no memory is allocated if `ws` fits the LP (and the pricing rule
+ *		allocates none)
+ *	2. `impf_CondUnsatisfied` if `ws->nthreads < 1`
+ *
+ * Return: `EXIT_SUCCESS` or `EXIT_FAILURE`
+ */
+int impf_lp_simplex_ws(const double *objective, const struct impf_LinearConstraint *constraints,
+		       const double *ub, const int m, const int n, const char *criteria, const int niter,
+		       const int *status0, int *status, double *x, double *value,
+		       struct impf_LP_Workspace *ws, int *code);
+
+/* Solve a batch of LPs of `impf_lp_simplex_bnd` sharing the coefficients of
+ * constraints and upper bounds, shared by `nthreads` threads, each of which
+ * solves in its own workspace (see `impf_LP_Workspace`)
+ *
+ * Parameters: see `impf_lp_simplex_bnd`, except
+ *	objectives	objective of LP k starting at `objectives + k * n`
+ *			(length = nbatch * n)
+ *	rhs		rhs of LP k starting at `rhs + k * m` (length =
+ *			nbatch * m), or `NULL` pointer to use the rhs of
+ *			`constraints` for all LPs
+ *	nbatch		number of LPs
+ *	nthreads	number of threads
+ *	x		solution of LP k starting at `x + k * n` (length =
+ *			nbatch * n)
+ *	value		optimal values (length = nbatch)
+ *	code		error codes (length = nbatch)
+ *
+ * Note: see `impf_lp_simplex_batch`
+ *
+ * Return: `EXIT_SUCCESS` if all LPs are solved, otherwise `EXIT_FAILURE`
+ */
+int impf_lp_simplex_bnd_batch(const double *objectives, const struct impf_LinearConstraint *constraints,
+			      const double *rhs, const double *ub, const int m, const int n, const int nbatch,
+			      const char *criteria, const int niter, const int nthreads,
+			      double *x, double *value, int *code);
+
+/* Pricing rule of simplex table, choosing the variable to enter basis
+ *
+ * The table is stored row by row with leading dimension `ldtable`. Row 0
+ * holds `beta_j`, the negative reduced costs (a variable is attractive to
+ * enter basis if `beta_j > 0`), rows 1, ..., m hold the constraints, and the
+ * right hand side is in column n. `basis[i]` is the basic variable of row
+ * `i + 1`, `isbasic[j]` tells whether variable j is basic, and `ub[j]` is the
+ * upper bound of variable j (`__impf_INF__` if unbounded). Variables at their
+ * upper bounds are substituted by `ub - x`, so all nonbasic variables are 0.
+ * The table and `ub` are those of the scaled LP (see `impf_lp_simplex_std`).
+ *
+ * Members:
+ *	name		criteria of the rule
+ *	init		called at the beginning of each simplex phase, or `NULL`
+ *	enter		return the variable to enter basis, or n if there is none
+ *	update		called before pivoting on row `p + 1` and column `q`,
+ *			where `basis[p]` leaves and `q` enters basis, or `NULL`
+ *	state		private state of the rule, passed to the callbacks
+ *
+ * Note: the rule is resolved once from `criteria` at the beginning of solving
+ */
+struct impf_PricingRule {
+	const char *name;
+	void (*init)(void *state, const double *table, const int ldtable, const int *basis,
+		     const int m, const int n);
+	int (*enter)(void *state, const double *table, const int ldtable, const int *basis,
+		     const int *isbasic, const double *ub, const int m, const int n);
+	void (*update)(void *state, const double *table, const int ldtable, const int *basis,
+		       const int m, const int n, const int p, const int q);
+	void *state;
+};
+
+/* Register a pricing rule, to be used as `criteria` of `impf_lp_simplex`,
+ * `impf_lp_simplex_std` and `impf_lp_simplex_bnd` by its name
+ *
+ * Note:
+ *	1. the rule is not copied, it should be alive while being used
+ *	2. registered rules are searched before built-in ones, so that a
+ *		built-in rule could be replaced; a later registered one replaces
+ *		an earlier one of the same name
+ *	3. registering is not thread safe, do it before solving
+ *
+ * Return: `EXIT_SUCCESS`, or `EXIT_FAILURE` if `__impf_LP_PRICING_MAX__` rules
+ * are registered already
+ */
+int impf_lp_pricing_register(const struct impf_PricingRule *rule);
+
+/* Find the pricing rule of `criteria`, the default rule if there is none
+ */
+const struct impf_PricingRule *impf_lp_pricing_find(const char *criteria);
+
+/* Revised simplex algorithm for solving LP of general form
+ *
+ * Only the constraint matrix (column compressed) and a sparse LU factorization
+ * of the basis are kept. The factorization is updated by eta vectors between
+ * pivots and recomputed periodically. Bounds of variables and constraints are
+ * handled directly, without adding rows or artificial variables.
+ *
+ * Parameters: see `impf_lp_simplex`, where `criteria` could be:
+ *				0) ""		default ("dantzig")
+ *				1) "dantzig"	Dantzig's original rule
+ *				2) "bland"	Bland's rule
+ *
+ * Return: `EXIT_SUCCESS` or `EXIT_FAILURE`
+ */
+int impf_lp_simplex_rev(const double *objective, const struct impf_LinearConstraint *constraints,
+			const struct impf_VariableBound *bounds,
+			const int m, const int n, const char *criteria, const int niter,
+			double *x, double *value, int *code);
+
+/* Revised simplex algorithm for solving LP of general form, with the
+ * constraint matrix given column compressed
+ *
+ * Parameters: see `impf_lp_simplex_rev`, except
+ *	colptr		column starts in `rowidx` and `values` (length = n + 1)
+ *	rowidx		row indices of nonzeros (length = colptr[n])
+ *	values		nonzero coefficients (length = colptr[n])
+ *	constraints	only `rhs` and `type` are used, `coef` could be `NULL`
+ *
+ * Return: `EXIT_SUCCESS` or `EXIT_FAILURE`
+ */
+int impf_lp_simplex_csc(const double *objective, const int *colptr, const int *rowidx, const double *values,
+			const struct impf_LinearConstraint *constraints,
+			const struct impf_VariableBound *bounds,
+			const int m, const int n, const char *criteria, const int niter,
+			double *x, double *value, int *code);
+
+/* Dual simplex algorithm for re-optimizing LP of general form from a basis
+ *
+ * Starting from a dual feasible basis (e.g. the optimal basis before changing
+ * `rhs` of constraints or bounds of variables), the dual simplex restores the
+ * primal feasibility. If the basis is not dual feasible, the primal revised
+ * simplex is used from the basis instead.
+ *
+ * Parameters: see `impf_lp_simplex_rev`, and
+ *	basis		indices of basic variables (length = m), where `j < n` is a
+ *			variable and `n + i` is the slack of constraint `i`.
+ *			On input the starting basis (`basis[i] = n + i` if there is
+ *			no better choice), on output the final basis
+ *
+ * Return: `EXIT_SUCCESS` or `EXIT_FAILURE`
+ */
+int impf_lp_simplex_dual(const double *objective, const struct impf_LinearConstraint *constraints,
+			 const struct impf_VariableBound *bounds, const int m, const int n, const int niter,
+			 int *basis, double *x, double *value, int *code);
+
 /*******************************************************************************
  * Optimization of "lp-interior-point-family"
  ******************************************************************************/
 
+/* Primal-dual interior point method for solving LP of general form, with
+ * Mehrotra's predictor-corrector steps
+ *
+ * Variables with finite lower bounds are shifted to 0, variables with only
+ * upper bounds are reflected, free variables are split into two nonnegative
+ * parts and fixed variables are removed. "LE" and "GE" constraints have
+ * slacks, and upper bounds keep their own complementarity pairs. The normal
+ * equations `A D A' dy = r` of each step are solved by a sparse Cholesky
+ * factorization, whose minimum degree ordering and pattern are found once.
+ *
+ * Parameters: see `impf_lp_simplex`, except no `criteria`, and
+ *	niter		limit of predictor-corrector iterations
+ *
+ * Note:
+ *	1. the solution is accurate up to relative residuals and relative
+ *		duality gap of `__impf_CTR_IPM_OPTIMAL__`, and is not necessarily
+ *		a vertex if the optimal face is not a vertex
+ *	2. infeasibility (or unboundedness) is reported when the dual (or
+ *		primal) iterates diverge
+ *	3. dense columns are not treated separately, so a few of them make the
+ *		Cholesky factor dense
+ *
+ * Return: `EXIT_SUCCESS` or `EXIT_FAILURE`
+ */
+int impf_lp_interior(const double *objective, const struct impf_LinearConstraint *constraints,
+		     const struct impf_VariableBound *bounds, const int m, const int n, const int niter,
+		     double *x, double *value, int *code);
+
+/* Interior point method with the constraint matrix given column compressed
+ *
+ * Parameters: see `impf_lp_interior`, and `colptr`, `rowidx`, `values` of
+ *	`impf_lp_simplex_csc`
+ *
+ * Return: `EXIT_SUCCESS` or `EXIT_FAILURE`
+ */
+int impf_lp_interior_csc(const double *objective, const int *colptr, const int *rowidx, const double *values,
+			 const struct impf_LinearConstraint *constraints,
+			 const struct impf_VariableBound *bounds, const int m, const int n, const int niter,
+			 double *x, double *value, int *code);
+
+/* Wrapper of `impf_lp_interior_csc` for the `model` from `impf_lp_readmps`
+ *
+ * Return: `EXIT_SUCCESS` or `EXIT_FAILURE`
+ */
+int impf_lp_interior_wrp(const struct impf_Model_LP *model, const int niter,
+			 double *x, double *value, int *code);
+
+/*******************************************************************************
+ * Optimization of "lp-first-order-family"
+ ******************************************************************************/
+
+/* Restarted primal-dual hybrid gradient method (PDLP) for solving LP of
+ * general form
+ *
+ * Only products with the constraint matrix and its transpose are used, so
+ * the memory is linear in the number of nonzeros. The matrix is scaled by
+ * Ruiz equilibration and the Pock-Chambolle scaling. Steps are adaptive, the
+ * iterates restart from the better of the current and the average iterates
+ * by their KKT errors, and the primal weight balancing primal and dual steps
+ * is updated at restarts.
+ *
+ * Parameters: see `impf_lp_simplex`, except no `criteria`, and
+ *	niter		limit of iterations
+ *	tol		relative tolerance of the residuals and the duality
+ *			gap, such as 1e-4 for a quick approximate solution
+ *	nthreads	number of threads sharing the products with the
+ *			constraint matrix and the vector updates on large LPs
+ *
+ * Note:
+ *	1. on `impf_ExceedIterLimit`, `x` and `value` still hold the last
+ *		iterate, which is approximate
+ *	2. infeasibility (or unboundedness) is reported when the difference of
+ *		dual (or primal) iterates, or the iterate itself, becomes a
+ *		ray certifying it
+ *	3. the accuracy is moderate, the solution is not a vertex in general
+ *	4. `impf_PrecisionError` if the iterates overflow
+ *	5. the iterates depend on `nthreads` only by the rounding of partial
+ *		sums, and it has no effect if the library is built without OpenMP
+ *	6. `impf_CondUnsatisfied` if `nthreads < 1`
+ *
+ * Return: `EXIT_SUCCESS` or `EXIT_FAILURE`
+ */
+int impf_lp_pdhg(const double *objective, const struct impf_LinearConstraint *constraints,
+		 const struct impf_VariableBound *bounds, const int m, const int n, const int niter,
+		 const double tol, const int nthreads, double *x, double *value, int *code);
+
+/* PDHG method with the constraint matrix given column compressed
+ *
+ * Parameters: see `impf_lp_pdhg`, and `colptr`, `rowidx`, `values` of
+ *	`impf_lp_simplex_csc`
+ *
+ * Return: `EXIT_SUCCESS` or `EXIT_FAILURE`
+ */
+int impf_lp_pdhg_csc(const double *objective, const int *colptr, const int *rowidx, const double *values,
+		     const struct impf_LinearConstraint *constraints,
+		     const struct impf_VariableBound *bounds, const int m, const int n, const int niter,
+		     const double tol, const int nthreads, double *x, double *value, int *code);
+
+/* Wrapper of `impf_lp_pdhg_csc` for the `model` from `impf_lp_readmps`
+ *
+ * Return: `EXIT_SUCCESS` or `EXIT_FAILURE`
+ */
+int impf_lp_pdhg_wrp(const struct impf_Model_LP *model, const int niter, const double tol,
+		     const int nthreads, double *x, double *value, int *code);
+
+/*******************************************************************************
+ * Optimization of "mip-branch-and-bound-family"
+ ******************************************************************************/
+
+/* Branch-and-bound for solving LP of general form with integer variables
+ * (`v_type` of `bounds` being `impf_VAR_T_INT` or `impf_VAR_T_BIN`)
+ *
+ * The LP relaxation of each node is solved by the dual simplex (see
+ * `impf_lp_simplex_dual`) warm started from the optimal basis of its parent.
+ * The fractional variable to branch on is chosen by pseudo-costs, the
+ * average increases of the objective per unit change of variables in
+ * earlier branches. Each thread keeps its own pool of open nodes, and idle
+ * threads steal nodes from the pools of others.
+ *
+ * Parameters: see `impf_lp_simplex`, except
+ *	criteria	node selection, including:
+ *				0) ""		default, depth first until an integer
+ *						solution is found, then best bound
+ *				1) "best"	best bound
+ *				2) "depth"	depth first
+ *	niter		iteration limit of the LP of each node
+ *	nnode		limit of nodes solved
+ *	nthreads	number of threads
+ *
+ * Note:
+ *	1. the bounds of binary variables are [0, 1], those of integer
+ *		variables are rounded inwards
+ *	2. on `impf_ExceedIterLimit` (of nodes or of the LP of a node), `x`
+ *		and `value` hold the best integer solution found, if any
+ *	3. `impf_Unboundedness` is reported if an LP relaxation is unbounded
+ *	4. the optimal value does not depend on the number of threads, but
+ *		the solution may differ among alternative optima, and nodes are
+ *		searched in a different order
+ *	5. it runs on one thread if the library is built without OpenMP
+ *
+ * Return: `EXIT_SUCCESS` or `EXIT_FAILURE`
+ */
+int impf_lp_mip(const double *objective, const struct impf_LinearConstraint *constraints,
+		const struct impf_VariableBound *bounds, const int m, const int n, const char *criteria,
+		const int niter, const int nnode, const int nthreads, double *x, double *value, int *code);
+
 #ifdef __cpluscplus
 }
 #endif /* __cpluscplus */
@@ -11,12 +11,47 @@
 extern "C" {
 #endif /* __cplusplus */
 
+/*******************************************************************************
+ * Instruction sets of BLAS-1 kernels
+ ******************************************************************************/
+
+#define impf_SIMD_NONE		0	/* scalar loops */
+#define impf_SIMD_SSE2		1
+#define impf_SIMD_AVX2		2
+#define impf_SIMD_AVX512	3	/* AVX-512F */
+
+/* The instruction set used by BLAS-1 kernels, the best one supported by the
+ * CPU (detected once by CPUID) within the limit of `impf_linalg_simd_limit`
+ */
+int impf_linalg_simd(void);
+
+/* Limit the instruction set used by BLAS-1 kernels to `level` (the default
+ * limit is `impf_SIMD_AVX512`)
+ * Return the instruction set used from now on
+ */
+int impf_linalg_simd_limit(const int level);
+
 /*******************************************************************************
  * Linear algebra of "pivot-family"
+ *
+ * Note:
+ *	1. `n` is the length of arrays, of which every `inc`-th element is used
+ *	2. `dscal` and `daxpy` give the same results on all instruction sets,
+ *		while reductions (`ddot`, `dnrm2`) may differ in rounding
  ******************************************************************************/
 
 void impf_linalg_dscal(const int n, const double x, double *arr, const int inc);
 void impf_linalg_daxpy(const int n, const double a, const double *x, const int incx, double *y, const int incy);
+/* Sparse `y[indx[k]] += a * x[k]` for `k < nz`, indices should be distinct */
+void impf_linalg_daxpyi(const int nz, const double a, const double *x, const int *indx, double *y);
+double impf_linalg_ddot(const int n, const double *x, const int incx, const double *y, const int incy);
+/* Euclidean norm, scaled against overflow and underflow */
+double impf_linalg_dnrm2(const int n, const double *x, const int inc);
+/* Index of the first element of the largest absolute value, 0 if `n <= 0` */
+int impf_linalg_idamax(const int n, const double *x, const int inc);
+/* The largest absolute value of `x`, and of `x - y`, `__impf_NINF__` if `n <= 0` */
+double impf_linalg_damax(const int n, const double *x, const int inc);
+double impf_linalg_damax_gap(const int n, const double *x, const double *y, const int inc);
 void impf_linalg_ldscal(const int n, const long double x, long double *arr, const int inc);
 void impf_linalg_ldaxpy(const int n, const long double a, const long double *x, const int incx,
 			long double *y, const int incy);
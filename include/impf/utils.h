@@ -60,11 +60,17 @@ void impf_prt_arrld(const long double *arr, const int len, const int inc, const
 
 void impf_prt_matd(const double *mat, const int ld, const int nrow, const int ncol);
 
+/* `printf` of developing mode, silent inside an active parallel region (e.g. of
+ * batch solvers) so that outputs of threads are not interleaved
+ */
+void impf_prt_dev(const char *format, ...);
+
 /*******************************************************************************
  * Utils of "memory-family"
  ******************************************************************************/
 
 void *impf_malloc(size_t size);
+void *impf_realloc(void *ptr, size_t size);
 void impf_free(void *ptr);
 void *impf_memset(void *str, int c, size_t n);
 void *impf_memcpy(void *dest, const void *src, size_t n);
@@ -1,16 +1,33 @@
+import os
 from setuptools import setup, Extension
 
+# Kernels of BLAS-1 are not contracted to FMA (see include/impf/_simd.h), the
+# flag applies to all sources of the module
+fp_contract = [] if os.name == 'nt' else ['-ffp-contract=off']
+
 module_test = Extension('impf._clib_test',
 			sources=['src/pywrp_test.c'])
 module_optm = Extension('impf._clib_optm',
 			sources=[
 				'src/pywrp_optm.c',
 	    			'src/utils.c',
+				'src/linalg/simd.c',
 				'src/linalg/daxpy.c',
 				'src/linalg/dscal.c',
+				'src/linalg/ddot.c',
+				'src/linalg/dnrm2.c',
+				'src/linalg/idamax.c',
+				'src/linalg/dgels.c',
 				'src/lp/simplex_std.c',
-				'src/lp/simplex_gen.c'],
-			include_dirs=['include'])
+				'src/lp/simplex_gen.c',
+				'src/lp/simplex_wrp.c',
+				'src/lp/simplex_rev.c',
+				'src/lp/presolve.c',
+				'src/lp/interior.c',
+				'src/lp/pdhg.c',
+				'src/lp/mip.c'],
+			include_dirs=['include'],
+			extra_compile_args=fp_contract)
 
 setup(
 	name='impf',
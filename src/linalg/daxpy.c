@@ -2,8 +2,60 @@
  * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
  * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
  */
+#include <impf/_simd.h>
 #include <impf/linalg.h>
 
+/* Kernels of contiguous arrays, multiplication and addition are not fused so
+ * that all instruction sets give the same results
+ */
+#ifdef IMPF_SIMD_X86
+IMPF_TARGET_SSE2
+static void daxpy_sse2(const int n, const double a, const double *x, double *y)
+{
+	int i;
+	__m128d va = _mm_set1_pd(a);
+
+	for (i = 0; i + 4 <= n; i += 4) {
+		_mm_storeu_pd(y + i, _mm_add_pd(_mm_loadu_pd(y + i), _mm_mul_pd(va, _mm_loadu_pd(x + i))));
+		_mm_storeu_pd(y + i + 2, _mm_add_pd(_mm_loadu_pd(y + i + 2), _mm_mul_pd(va, _mm_loadu_pd(x + i + 2))));
+	}
+	for (; i < n; i++)
+		y[i] += a * x[i];
+}
+
+IMPF_TARGET_AVX2
+static void daxpy_avx2(const int n, const double a, const double *x, double *y)
+{
+	int i;
+	__m256d va = _mm256_set1_pd(a);
+
+	for (i = 0; i + 8 <= n; i += 8) {
+		_mm256_storeu_pd(y + i, _mm256_add_pd(_mm256_loadu_pd(y + i),
+						      _mm256_mul_pd(va, _mm256_loadu_pd(x + i))));
+		_mm256_storeu_pd(y + i + 4, _mm256_add_pd(_mm256_loadu_pd(y + i + 4),
+							  _mm256_mul_pd(va, _mm256_loadu_pd(x + i + 4))));
+	}
+	for (; i < n; i++)
+		y[i] += a * x[i];
+}
+
+IMPF_TARGET_AVX512
+static void daxpy_avx512(const int n, const double a, const double *x, double *y)
+{
+	int i;
+	__m512d va = _mm512_set1_pd(a);
+
+	for (i = 0; i + 16 <= n; i += 16) {
+		_mm512_storeu_pd(y + i, _mm512_add_pd(_mm512_loadu_pd(y + i),
+						      _mm512_mul_pd(va, _mm512_loadu_pd(x + i))));
+		_mm512_storeu_pd(y + i + 8, _mm512_add_pd(_mm512_loadu_pd(y + i + 8),
+							  _mm512_mul_pd(va, _mm512_loadu_pd(x + i + 8))));
+	}
+	for (; i < n; i++)
+		y[i] += a * x[i];
+}
+#endif
+
 void impf_linalg_daxpy(const int n, const double a, const double *x, const int incx, double *y, const int incy)
 {
 	int i = 0, j = 0;
@@ -11,6 +63,30 @@ void impf_linalg_daxpy(const int n, const double a, const double *x, const int i
 	assert(x != NULL);
 	assert(y != NULL);
 
+	if (incx == 1 && incy == 1) {
+		switch (impf_linalg_simd()) {
+#ifdef IMPF_SIMD_X86
+		case impf_SIMD_AVX512:
+			daxpy_avx512(n, a, x, y);
+			return;
+		case impf_SIMD_AVX2:
+			daxpy_avx2(n, a, x, y);
+			return;
+		case impf_SIMD_SSE2:
+			daxpy_sse2(n, a, x, y);
+			return;
+#endif
+		default:
+			for (i = 0; i < n; i++)
+				y[i] += a * x[i];
+			return;
+		}
+	}
+	if (incx == incy) {
+		for (i = 0; i < n; i += incx)
+			y[i] += a * x[i];
+		return;
+	}
 	while (i < n && j < n) {
 		y[i] += a * x[j];
 		i += incy;
@@ -18,6 +94,18 @@ void impf_linalg_daxpy(const int n, const double a, const double *x, const int i
 	}
 }
 
+void impf_linalg_daxpyi(const int nz, const double a, const double *x, const int *indx, double *y)
+{
+	int k;
+
+	assert(x != NULL);
+	assert(indx != NULL);
+	assert(y != NULL);
+
+	for (k = 0; k < nz; k++)
+		y[indx[k]] += a * x[k];
+}
+
 void impf_linalg_ldaxpy(const int n, const long double a, const long double *x, const int incx,
 			long double *y, const int incy)
 {
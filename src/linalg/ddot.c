@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <impf/_simd.h>
+#include <impf/linalg.h>
+
+#ifdef IMPF_SIMD_X86
+IMPF_TARGET_SSE2
+static double ddot_sse2(const int n, const double *x, const double *y)
+{
+	int i;
+	double s[2];
+	__m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+
+	for (i = 0; i + 4 <= n; i += 4) {
+		acc0 = _mm_add_pd(acc0, _mm_mul_pd(_mm_loadu_pd(x + i), _mm_loadu_pd(y + i)));
+		acc1 = _mm_add_pd(acc1, _mm_mul_pd(_mm_loadu_pd(x + i + 2), _mm_loadu_pd(y + i + 2)));
+	}
+	_mm_storeu_pd(s, _mm_add_pd(acc0, acc1));
+	s[0] += s[1];
+	for (; i < n; i++)
+		s[0] += x[i] * y[i];
+	return s[0];
+}
+
+IMPF_TARGET_AVX2
+static double ddot_avx2(const int n, const double *x, const double *y)
+{
+	int i;
+	double s[4];
+	__m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+
+	for (i = 0; i + 8 <= n; i += 8) {
+		acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i)));
+		acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(_mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4)));
+	}
+	_mm256_storeu_pd(s, _mm256_add_pd(acc0, acc1));
+	s[0] += s[1] + s[2] + s[3];
+	for (; i < n; i++)
+		s[0] += x[i] * y[i];
+	return s[0];
+}
+
+IMPF_TARGET_AVX512
+static double ddot_avx512(const int n, const double *x, const double *y)
+{
+	int i;
+	double s;
+	__m512d acc0 = _mm512_setzero_pd(), acc1 = _mm512_setzero_pd();
+
+	for (i = 0; i + 16 <= n; i += 16) {
+		acc0 = _mm512_add_pd(acc0, _mm512_mul_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i)));
+		acc1 = _mm512_add_pd(acc1, _mm512_mul_pd(_mm512_loadu_pd(x + i + 8), _mm512_loadu_pd(y + i + 8)));
+	}
+	s = _mm512_reduce_add_pd(_mm512_add_pd(acc0, acc1));
+	for (; i < n; i++)
+		s += x[i] * y[i];
+	return s;
+}
+#endif
+
+double impf_linalg_ddot(const int n, const double *x, const int incx, const double *y, const int incy)
+{
+	int i = 0, j = 0;
+	double s = 0.;
+
+	assert(x != NULL);
+	assert(y != NULL);
+
+	if (incx == 1 && incy == 1) {
+		switch (impf_linalg_simd()) {
+#ifdef IMPF_SIMD_X86
+		case impf_SIMD_AVX512:
+			return ddot_avx512(n, x, y);
+		case impf_SIMD_AVX2:
+			return ddot_avx2(n, x, y);
+		case impf_SIMD_SSE2:
+			return ddot_sse2(n, x, y);
+#endif
+		default:
+			break;
+		}
+	}
+	while (i < n && j < n) {
+		s += x[j] * y[i];
+		i += incy;
+		j += incx;
+	}
+	return s;
+}
@@ -62,13 +62,16 @@ int impf_linalg_dgels_3(const double A11, const double A12, const double A13,
 int impf_linalg_dgels_L(const int n, const int nrhs, const double *a, const int lda, const double *b, const int ldb,
 			int *ipvt, double *x, int *code)
 {
+	int state;
 	double *buffer = impf_malloc(n * (n + nrhs) * sizeof(double));
 
 	if (buffer == NULL) {
 		*code = impf_MemoryAllocError;
 		return impf_EXIT_FAILURE;
 	}
-	return impf_linalg_dgels_n(n, nrhs, a, lda, b, ldb, ipvt, x, buffer, code);
+	state = impf_linalg_dgels_n(n, nrhs, a, lda, b, ldb, ipvt, x, buffer, code);
+	impf_free(buffer);
+	return state;
 }
 
 static int select_major(const double *row, const int n, const int *ipvt, const int i)
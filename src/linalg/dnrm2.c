@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <impf/_simd.h>
+#include <impf/linalg.h>
+#include <math.h>
+
+/* Kernels of the sum of squares of `x / scale`
+ */
+#ifdef IMPF_SIMD_X86
+IMPF_TARGET_SSE2
+static double dsumsq_sse2(const int n, const double scale, const double *x)
+{
+	int i;
+	double s[2];
+	__m128d vs = _mm_set1_pd(scale), v, acc = _mm_setzero_pd();
+
+	for (i = 0; i + 2 <= n; i += 2) {
+		v = _mm_div_pd(_mm_loadu_pd(x + i), vs);
+		acc = _mm_add_pd(acc, _mm_mul_pd(v, v));
+	}
+	_mm_storeu_pd(s, acc);
+	s[0] += s[1];
+	for (; i < n; i++)
+		s[0] += (x[i] / scale) * (x[i] / scale);
+	return s[0];
+}
+
+IMPF_TARGET_AVX2
+static double dsumsq_avx2(const int n, const double scale, const double *x)
+{
+	int i;
+	double s[4];
+	__m256d vs = _mm256_set1_pd(scale), v, acc = _mm256_setzero_pd();
+
+	for (i = 0; i + 4 <= n; i += 4) {
+		v = _mm256_div_pd(_mm256_loadu_pd(x + i), vs);
+		acc = _mm256_add_pd(acc, _mm256_mul_pd(v, v));
+	}
+	_mm256_storeu_pd(s, acc);
+	s[0] += s[1] + s[2] + s[3];
+	for (; i < n; i++)
+		s[0] += (x[i] / scale) * (x[i] / scale);
+	return s[0];
+}
+
+IMPF_TARGET_AVX512
+static double dsumsq_avx512(const int n, const double scale, const double *x)
+{
+	int i;
+	double s;
+	__m512d vs = _mm512_set1_pd(scale), v, acc = _mm512_setzero_pd();
+
+	for (i = 0; i + 8 <= n; i += 8) {
+		v = _mm512_div_pd(_mm512_loadu_pd(x + i), vs);
+		acc = _mm512_add_pd(acc, _mm512_mul_pd(v, v));
+	}
+	s = _mm512_reduce_add_pd(acc);
+	for (; i < n; i++)
+		s += (x[i] / scale) * (x[i] / scale);
+	return s;
+}
+#endif
+
+/* Computed as `scale * sqrt(sum((x / scale)^2))` with `scale = max(|x|)`,
+ * dividing by `scale` since `1 / scale` overflows if it is subnormal
+ */
+double impf_linalg_dnrm2(const int n, const double *x, const int inc)
+{
+	int i;
+	double scale, s = 0.;
+
+	assert(x != NULL);
+
+	scale = impf_linalg_damax(n, x, inc);
+	if (!(scale > 0.) || scale == __impf_INF__)  /* empty, zero, infinite */
+		return __impf_MAX__(scale, 0.);
+	if (inc == 1) {
+		switch (impf_linalg_simd()) {
+#ifdef IMPF_SIMD_X86
+		case impf_SIMD_AVX512:
+			return scale * sqrt(dsumsq_avx512(n, scale, x));
+		case impf_SIMD_AVX2:
+			return scale * sqrt(dsumsq_avx2(n, scale, x));
+		case impf_SIMD_SSE2:
+			return scale * sqrt(dsumsq_sse2(n, scale, x));
+#endif
+		default:
+			break;
+		}
+	}
+	for (i = 0; i < n; i += inc)
+		s += (x[i] / scale) * (x[i] / scale);
+	return scale * sqrt(s);
+}
@@ -2,14 +2,76 @@
  * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
  * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
  */
+#include <impf/_simd.h>
 #include <impf/linalg.h>
 
+#ifdef IMPF_SIMD_X86
+IMPF_TARGET_SSE2
+static void dscal_sse2(const int n, const double x, double *arr)
+{
+	int i;
+	__m128d vx = _mm_set1_pd(x);
+
+	for (i = 0; i + 4 <= n; i += 4) {
+		_mm_storeu_pd(arr + i, _mm_mul_pd(vx, _mm_loadu_pd(arr + i)));
+		_mm_storeu_pd(arr + i + 2, _mm_mul_pd(vx, _mm_loadu_pd(arr + i + 2)));
+	}
+	for (; i < n; i++)
+		arr[i] *= x;
+}
+
+IMPF_TARGET_AVX2
+static void dscal_avx2(const int n, const double x, double *arr)
+{
+	int i;
+	__m256d vx = _mm256_set1_pd(x);
+
+	for (i = 0; i + 8 <= n; i += 8) {
+		_mm256_storeu_pd(arr + i, _mm256_mul_pd(vx, _mm256_loadu_pd(arr + i)));
+		_mm256_storeu_pd(arr + i + 4, _mm256_mul_pd(vx, _mm256_loadu_pd(arr + i + 4)));
+	}
+	for (; i < n; i++)
+		arr[i] *= x;
+}
+
+IMPF_TARGET_AVX512
+static void dscal_avx512(const int n, const double x, double *arr)
+{
+	int i;
+	__m512d vx = _mm512_set1_pd(x);
+
+	for (i = 0; i + 16 <= n; i += 16) {
+		_mm512_storeu_pd(arr + i, _mm512_mul_pd(vx, _mm512_loadu_pd(arr + i)));
+		_mm512_storeu_pd(arr + i + 8, _mm512_mul_pd(vx, _mm512_loadu_pd(arr + i + 8)));
+	}
+	for (; i < n; i++)
+		arr[i] *= x;
+}
+#endif
+
 void impf_linalg_dscal(const int n, const double x, double *arr, const int inc)
 {
 	int i;
 
 	assert(arr != NULL);
 
+	if (inc == 1) {
+		switch (impf_linalg_simd()) {
+#ifdef IMPF_SIMD_X86
+		case impf_SIMD_AVX512:
+			dscal_avx512(n, x, arr);
+			return;
+		case impf_SIMD_AVX2:
+			dscal_avx2(n, x, arr);
+			return;
+		case impf_SIMD_SSE2:
+			dscal_sse2(n, x, arr);
+			return;
+#endif
+		default:
+			break;
+		}
+	}
 	for (i = 0; i < n; i += inc)
 		arr[i] *= x;
 }
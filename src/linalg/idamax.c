@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <impf/_simd.h>
+#include <impf/linalg.h>
+
+/* Kernels of the largest absolute value of `x`, or of `x - y` if `y` is not
+ * `NULL`. The absolute value is taken by clearing the sign bit, and NaN is
+ * skipped as in the scalar loops
+ */
+#ifdef IMPF_SIMD_X86
+IMPF_TARGET_SSE2
+static double damax_sse2(const int n, const double *x, const double *y)
+{
+	int i;
+	double s[2];
+	__m128d sign = _mm_set1_pd(-0.), v, acc = _mm_set1_pd(__impf_NINF__);
+
+	for (i = 0; i + 2 <= n; i += 2) {
+		v = _mm_loadu_pd(x + i);
+		if (y != NULL)
+			v = _mm_sub_pd(v, _mm_loadu_pd(y + i));
+		acc = _mm_max_pd(_mm_andnot_pd(sign, v), acc);
+	}
+	_mm_storeu_pd(s, acc);
+	s[0] = __impf_MAX__(s[0], s[1]);
+	for (; i < n; i++)
+		s[0] = __impf_MAX__(__impf_ABS__(y != NULL ? x[i] - y[i] : x[i]), s[0]);
+	return s[0];
+}
+
+IMPF_TARGET_AVX2
+static double damax_avx2(const int n, const double *x, const double *y)
+{
+	int i;
+	double s[4];
+	__m256d sign = _mm256_set1_pd(-0.), v, acc = _mm256_set1_pd(__impf_NINF__);
+
+	for (i = 0; i + 4 <= n; i += 4) {
+		v = _mm256_loadu_pd(x + i);
+		if (y != NULL)
+			v = _mm256_sub_pd(v, _mm256_loadu_pd(y + i));
+		acc = _mm256_max_pd(_mm256_andnot_pd(sign, v), acc);
+	}
+	_mm256_storeu_pd(s, acc);
+	s[0] = __impf_MAX__(__impf_MAX__(s[0], s[1]), __impf_MAX__(s[2], s[3]));
+	for (; i < n; i++)
+		s[0] = __impf_MAX__(__impf_ABS__(y != NULL ? x[i] - y[i] : x[i]), s[0]);
+	return s[0];
+}
+
+IMPF_TARGET_AVX512
+static double damax_avx512(const int n, const double *x, const double *y)
+{
+	int i;
+	double s;
+	__m512d v, acc = _mm512_set1_pd(__impf_NINF__);
+
+	for (i = 0; i + 8 <= n; i += 8) {
+		v = _mm512_loadu_pd(x + i);
+		if (y != NULL)
+			v = _mm512_sub_pd(v, _mm512_loadu_pd(y + i));
+		acc = _mm512_max_pd(_mm512_abs_pd(v), acc);
+	}
+	s = _mm512_reduce_max_pd(acc);
+	for (; i < n; i++)
+		s = __impf_MAX__(__impf_ABS__(y != NULL ? x[i] - y[i] : x[i]), s);
+	return s;
+}
+#endif
+
+static double damax(const int n, const double *x, const double *y, const int inc)
+{
+	int i;
+	double ele, maxv = __impf_NINF__;
+
+	if (inc == 1) {
+		switch (impf_linalg_simd()) {
+#ifdef IMPF_SIMD_X86
+		case impf_SIMD_AVX512:
+			return damax_avx512(n, x, y);
+		case impf_SIMD_AVX2:
+			return damax_avx2(n, x, y);
+		case impf_SIMD_SSE2:
+			return damax_sse2(n, x, y);
+#endif
+		default:
+			break;
+		}
+	}
+	for (i = 0; i < n; i += inc) {
+		ele = __impf_ABS__(y != NULL ? x[i] - y[i] : x[i]);
+		if (ele > maxv)
+			maxv = ele;
+	}
+	return maxv;
+}
+
+double impf_linalg_damax(const int n, const double *x, const int inc)
+{
+	assert(x != NULL);
+	assert(inc >= 1);
+
+	return damax(n, x, NULL, inc);
+}
+
+double impf_linalg_damax_gap(const int n, const double *x, const double *y, const int inc)
+{
+	assert(x != NULL);
+	assert(y != NULL);
+	assert(inc >= 1);
+
+	return damax(n, x, y, inc);
+}
+
+/* The largest absolute value is found by the kernels, then its first index
+ */
+int impf_linalg_idamax(const int n, const double *x, const int inc)
+{
+	int i;
+	double maxv;
+
+	assert(x != NULL);
+	assert(inc >= 1);
+
+	maxv = damax(n, x, NULL, inc);
+	for (i = 0; i < n; i += inc) {
+		if (__impf_ABS__(x[i]) == maxv)
+			return i;
+	}
+	return 0;
+}
@@ -0,0 +1,36 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <impf/_simd.h>
+#include <impf/linalg.h>
+
+static int simd_detected = -1;  /* detected on first use */
+static int simd_limit = impf_SIMD_AVX512;
+
+static int simd_detect(void)
+{
+#ifdef IMPF_SIMD_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f"))
+		return impf_SIMD_AVX512;
+	if (__builtin_cpu_supports("avx2"))
+		return impf_SIMD_AVX2;
+	if (__builtin_cpu_supports("sse2"))
+		return impf_SIMD_SSE2;
+#endif
+	return impf_SIMD_NONE;
+}
+
+int impf_linalg_simd(void)
+{
+	if (simd_detected < 0)
+		simd_detected = simd_detect();
+	return __impf_MIN__(simd_detected, simd_limit);
+}
+
+int impf_linalg_simd_limit(const int level)
+{
+	simd_limit = __impf_MAX__(level, impf_SIMD_NONE);
+	return impf_linalg_simd();
+}
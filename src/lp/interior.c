@@ -0,0 +1,965 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <impf/_magics.h>
+#include <impf/linalg.h>
+#include <impf/fmin_lp.h>
+#include <math.h>
+
+/* Transformation of original variables into columns */
+#define IPM_VAR_LO	0	/* x = lb + x', 0 <= x' (<= ub - lb) */
+#define IPM_VAR_UP	1	/* x = ub - x', 0 <= x' */
+#define IPM_VAR_FR	2	/* x = x' - x'', 0 <= x', x'' */
+#define IPM_VAR_FX	3	/* x = lb = ub, no column */
+
+/* Sparse Cholesky factorization `P M P' = L L'` of `M = A D A'`
+ *
+ * Note:
+ *	1. the ordering P and the pattern of L are found once, only the values
+ *		change with the diagonal D
+ *	2. row `k` of `P M P'` is row `perm[k]` of M and `pinv` is the inverse
+ *	3. `cp`, `ci` hold the pattern of the upper triangle of `P M P'` column
+ *		by column, its values are formed only when factorizing
+ *	4. L is column compressed with the diagonal first in each column
+ */
+struct ipm_chol {
+	int *perm;	/* length = m */
+	int *pinv;	/* length = m */
+	int *cp;	/* length = m + 1 */
+	int *ci;
+	int *parent;	/* elimination tree, length = m */
+	int *lp;	/* length = m + 1 */
+	int *li;
+	double *lx;
+	int *next;	/* next free entry of each column of L, length = m */
+	int *stack;	/* pattern of a row of L, length = m */
+	int *mark;	/* visited stamps, length = m */
+	int stamp;
+	double *work;	/* length = m */
+};
+
+/* Interior point problem
+ *
+ * The computational form and its dual are
+ *
+ *	min  c'x			max  b'y - u'v
+ *	s.t. A x = b			s.t. A'y + z - v = c
+ *	     x + w = u (if u < INF)	     z, v >= 0
+ *	     x, w >= 0
+ *
+ * where "LE" and "GE" constraints have slack columns, and `w`, `v` stay 0 for
+ * columns without upper bound
+ */
+struct ipm {
+	int m;
+	int n;		/* number of original variables */
+	int nvar;	/* number of columns */
+	int nbnd;	/* number of columns with upper bound */
+	int *colptr;	/* A, column compressed, length = nvar + 1 */
+	int *rowidx;
+	double *values;
+	int *rowptr;	/* A, row compressed, length = m + 1 */
+	int *colidx;
+	double *rowval;
+	double *b;	/* length = m */
+	double *c;	/* length = nvar */
+	double *u;	/* length = nvar */
+	int *kind;	/* `IPM_VAR_*` of original variables, length = n */
+	int *col;	/* first column of original variables, length = n */
+	double *shift;	/* lb, or ub for `IPM_VAR_UP`, length = n */
+	double *x, *w, *z, *v, *y;		/* iterates */
+	double *dx, *dw, *dz, *dv, *dy;		/* directions */
+	double *rb, *rc, *ru, *rxz, *rwv;	/* residuals */
+	double *theta;	/* D, length = nvar */
+	double *r;	/* length = nvar */
+	double *ry;	/* length = m */
+	struct ipm_chol chol;
+};
+
+static void ipm_free(struct ipm *lp)
+{
+	struct ipm_chol *ch = &lp->chol;
+
+	impf_free(lp->colptr);
+	impf_free(lp->rowidx);
+	impf_free(lp->values);
+	impf_free(lp->rowptr);
+	impf_free(lp->colidx);
+	impf_free(lp->rowval);
+	impf_free(lp->b);
+	impf_free(lp->c);
+	impf_free(lp->u);
+	impf_free(lp->kind);
+	impf_free(lp->col);
+	impf_free(lp->shift);
+	impf_free(lp->x);
+	impf_free(ch->perm);
+	impf_free(ch->pinv);
+	impf_free(ch->cp);
+	impf_free(ch->ci);
+	impf_free(ch->parent);
+	impf_free(ch->lp);
+	impf_free(ch->li);
+	impf_free(ch->lx);
+	impf_free(ch->next);
+	impf_free(ch->stack);
+	impf_free(ch->mark);
+	impf_free(ch->work);
+	impf_memset(lp, 0, sizeof(struct ipm));
+}
+
+/* Allocate an interior point problem of `m` rows, `n` original variables,
+ * `nvar` columns and `nnz` nonzeros
+ *
+ * Note: iterates, directions and residuals share the block pointed by `x`,
+ *	the pattern of the Cholesky factor is allocated later
+ */
+static int ipm_create(struct ipm *lp, const int m, const int n, const int nvar, const int nnz)
+{
+	struct ipm_chol *ch = &lp->chol;
+	double *p;
+
+	impf_memset(lp, 0, sizeof(struct ipm));
+	lp->m = m;
+	lp->n = n;
+	lp->nvar = nvar;
+	lp->colptr = impf_malloc((nvar + 1) * sizeof(int));
+	lp->rowidx = impf_malloc((nnz + 1) * sizeof(int));
+	lp->values = impf_malloc((nnz + 1) * sizeof(double));
+	lp->rowptr = impf_malloc((m + 1) * sizeof(int));
+	lp->colidx = impf_malloc((nnz + 1) * sizeof(int));
+	lp->rowval = impf_malloc((nnz + 1) * sizeof(double));
+	lp->b = impf_malloc((m + 1) * sizeof(double));
+	lp->c = impf_malloc((nvar + 1) * sizeof(double));
+	lp->u = impf_malloc((nvar + 1) * sizeof(double));
+	lp->kind = impf_malloc((n + 1) * sizeof(int));
+	lp->col = impf_malloc((n + 1) * sizeof(int));
+	lp->shift = impf_malloc((n + 1) * sizeof(double));
+	lp->x = impf_malloc((14 * nvar + 4 * m + 1) * sizeof(double));
+	ch->perm = impf_malloc((m + 1) * sizeof(int));
+	ch->pinv = impf_malloc((m + 1) * sizeof(int));
+	ch->cp = impf_malloc((m + 1) * sizeof(int));
+	ch->parent = impf_malloc((m + 1) * sizeof(int));
+	ch->lp = impf_malloc((m + 1) * sizeof(int));
+	ch->next = impf_malloc((m + 1) * sizeof(int));
+	ch->stack = impf_malloc((m + 1) * sizeof(int));
+	ch->mark = impf_malloc((m + 1) * sizeof(int));
+	ch->work = impf_malloc((m + 1) * sizeof(double));
+
+	if (!lp->colptr || !lp->rowidx || !lp->values || !lp->rowptr || !lp->colidx || !lp->rowval
+	    || !lp->b || !lp->c || !lp->u || !lp->kind || !lp->col || !lp->shift || !lp->x
+	    || !ch->perm || !ch->pinv || !ch->cp || !ch->parent || !ch->lp
+	    || !ch->next || !ch->stack || !ch->mark || !ch->work) {
+		ipm_free(lp);
+		return impf_EXIT_FAILURE;
+	}
+	p = lp->x;
+	lp->w = p + nvar;
+	lp->z = p + 2 * nvar;
+	lp->v = p + 3 * nvar;
+	lp->dx = p + 4 * nvar;
+	lp->dw = p + 5 * nvar;
+	lp->dz = p + 6 * nvar;
+	lp->dv = p + 7 * nvar;
+	lp->rc = p + 8 * nvar;
+	lp->ru = p + 9 * nvar;
+	lp->rxz = p + 10 * nvar;
+	lp->rwv = p + 11 * nvar;
+	lp->theta = p + 12 * nvar;
+	lp->r = p + 13 * nvar;
+	lp->y = p + 14 * nvar;
+	lp->dy = lp->y + m;
+	lp->rb = lp->y + 2 * m;
+	lp->ry = lp->y + 3 * m;
+	impf_memset(p, 0, (14 * nvar + 4 * m) * sizeof(double));
+	return impf_EXIT_SUCCESS;
+}
+
+/* Bounds of an original variable, `x >= 0` if no bound is given
+ */
+static void ipm_var_bounds(const struct impf_VariableBound *bd, double *lb, double *ub)
+{
+	if (bd == NULL) {
+		*lb = 0.;
+		*ub = __impf_INF__;
+		return;
+	}
+	switch (bd->b_type) {
+	case impf_BOUND_T_FR:
+		*lb = __impf_NINF__;
+		*ub = __impf_INF__;
+		break;
+	case impf_BOUND_T_UP:
+		*lb = 0.;
+		*ub = bd->ub;
+		break;
+	case impf_BOUND_T_BS:
+		*lb = bd->lb;
+		*ub = bd->ub;
+		break;
+	default:
+		*lb = bd->lb;
+		*ub = __impf_INF__;
+		break;
+	}
+}
+
+/* Entry `p` of original column `j` (row `i`), column compressed if `values`
+ * is given, otherwise the dense `coef` of constraints
+ */
+#define ipm_coef(constraints, values, p, i, j) \
+	((values) != NULL ? (values)[p] : (constraints)[i].coef[j])
+
+/* Load a general form LP with column compressed coefficients if `colptr` is
+ * given, otherwise with dense `coef` of constraints
+ */
+static int ipm_load(struct ipm *lp, const double *objective, const int *colptr, const int *rowidx,
+		    const double *values, const struct impf_LinearConstraint *constraints,
+		    const struct impf_VariableBound *bounds, const int m, const int n, int *code)
+{
+	int i, j, k, p, p0, p1, t, ncol, nvar = 0, nnz = 0;
+	double lb, ub, a, sign;
+
+	for (j = 0; j < n; j++) {
+		ipm_var_bounds(bounds ? bounds + j : NULL, &lb, &ub);
+		if (lb > ub) {
+			*code = impf_Infeasibility;
+			return impf_EXIT_FAILURE;
+		}
+		ncol = lb == ub ? 0 : (lb == __impf_NINF__ && ub == __impf_INF__ ? 2 : 1);
+		p0 = colptr ? colptr[j] : 0;
+		p1 = colptr ? colptr[j + 1] : m;
+		for (p = p0; p < p1; p++) {
+			i = colptr ? rowidx[p] : p;
+			if (ipm_coef(constraints, values, p, i, j) != 0.)
+				nnz += ncol;
+		}
+		nvar += ncol;
+	}
+	for (i = 0; i < m; i++) {
+		if (impf_CONS_T_EQ != constraints[i].type) {
+			nvar++;
+			nnz++;
+		}
+	}
+	if (ipm_create(lp, m, n, nvar, nnz) == impf_EXIT_FAILURE) {
+		*code = impf_MemoryAllocError;
+		return impf_EXIT_FAILURE;
+	}
+	for (i = 0; i < m; i++)
+		lp->b[i] = constraints[i].rhs;
+	for (j = 0, k = 0, nnz = 0; j < n; j++) {
+		ipm_var_bounds(bounds ? bounds + j : NULL, &lb, &ub);
+		if (lb == ub)
+			lp->kind[j] = IPM_VAR_FX;
+		else if (lb > __impf_NINF__)
+			lp->kind[j] = IPM_VAR_LO;
+		else
+			lp->kind[j] = ub < __impf_INF__ ? IPM_VAR_UP : IPM_VAR_FR;
+		lp->shift[j] = IPM_VAR_UP == lp->kind[j] ? ub : (IPM_VAR_FR == lp->kind[j] ? 0. : lb);
+		lp->col[j] = k;
+		p0 = colptr ? colptr[j] : 0;
+		p1 = colptr ? colptr[j + 1] : m;
+		for (p = p0; p < p1; p++) {  /* shifted parts move to rhs */
+			i = colptr ? rowidx[p] : p;
+			a = ipm_coef(constraints, values, p, i, j);
+			if (a != 0. && lp->shift[j] != 0.)
+				lp->b[i] -= a * lp->shift[j];
+		}
+		if (IPM_VAR_FX == lp->kind[j])
+			continue;
+		for (t = 0; t < (IPM_VAR_FR == lp->kind[j] ? 2 : 1); t++, k++) {
+			sign = (IPM_VAR_UP == lp->kind[j] || t == 1) ? -1. : 1.;
+			lp->colptr[k] = nnz;
+			lp->c[k] = sign * objective[j];
+			lp->u[k] = IPM_VAR_LO == lp->kind[j] ? ub - lb : __impf_INF__;
+			for (p = p0; p < p1; p++) {
+				i = colptr ? rowidx[p] : p;
+				a = ipm_coef(constraints, values, p, i, j);
+				if (a == 0.)
+					continue;
+				lp->rowidx[nnz] = i;
+				lp->values[nnz] = sign * a;
+				nnz++;
+			}
+		}
+	}
+	for (i = 0; i < m; i++) {  /* slacks */
+		if (impf_CONS_T_EQ == constraints[i].type)
+			continue;
+		lp->colptr[k] = nnz;
+		lp->c[k] = 0.;
+		lp->u[k] = __impf_INF__;
+		lp->rowidx[nnz] = i;
+		lp->values[nnz] = impf_CONS_T_LE == constraints[i].type ? 1. : -1.;
+		nnz++;
+		k++;
+	}
+	lp->colptr[nvar] = nnz;
+	for (k = 0; k < nvar; k++)
+		lp->nbnd += lp->u[k] < __impf_INF__;
+
+	impf_memset(lp->rowptr, 0, (m + 1) * sizeof(int));  /* row compressed copy */
+	for (p = 0; p < nnz; p++)
+		lp->rowptr[lp->rowidx[p] + 1]++;
+	for (i = 0; i < m; i++) {
+		lp->rowptr[i + 1] += lp->rowptr[i];
+		lp->chol.next[i] = lp->rowptr[i];
+	}
+	for (k = 0; k < nvar; k++) {
+		for (p = lp->colptr[k]; p < lp->colptr[k + 1]; p++) {
+			t = lp->chol.next[lp->rowidx[p]]++;
+			lp->colidx[t] = k;
+			lp->rowval[t] = lp->values[p];
+		}
+	}
+	return impf_EXIT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Sparse Cholesky factorization of the normal equations
+ ******************************************************************************/
+
+/* Append `s` to the adjacency list of node `i`
+ */
+static int ipm_adj_push(int **adj, int *len, int *cap, const int i, const int s)
+{
+	int *a;
+
+	if (len[i] == cap[i]) {
+		cap[i] = cap[i] > 0 ? 2 * cap[i] : 4;
+		a = impf_realloc(adj[i], cap[i] * sizeof(int));
+		if (a == NULL)
+			return impf_EXIT_FAILURE;
+		adj[i] = a;
+	}
+	adj[i][len[i]++] = s;
+	return impf_EXIT_SUCCESS;
+}
+
+/* Minimum degree ordering of the graph of `A A'`
+ *
+ * The elimination graph is kept explicitly: the neighbors of an eliminated
+ * node become a clique. Ties are broken by the smallest index
+ */
+static int ipm_chol_order(struct ipm *lp)
+{
+	struct ipm_chol *ch = &lp->chol;
+	int m = lp->m, i, j, k, p, q, s, u, v, deg, ntag = 0, state = impf_EXIT_SUCCESS;
+	int **adj, *len, *cap, *done = ch->mark, *tag = ch->stack;
+
+	adj = impf_malloc((m + 1) * sizeof(int *));
+	len = impf_malloc((2 * m + 1) * sizeof(int));
+	if (adj == NULL || len == NULL) {
+		impf_free(adj);
+		impf_free(len);
+		return impf_EXIT_FAILURE;
+	}
+	cap = len + m;
+	for (i = 0; i < m; i++) {
+		adj[i] = NULL;
+		len[i] = 0;
+		cap[i] = 0;
+		tag[i] = -1;
+	}
+	for (i = 0; i < m && state == impf_EXIT_SUCCESS; i++) {
+		tag[i] = i;
+		for (p = lp->rowptr[i]; p < lp->rowptr[i + 1] && state == impf_EXIT_SUCCESS; p++) {
+			j = lp->colidx[p];
+			for (q = lp->colptr[j]; q < lp->colptr[j + 1]; q++) {
+				s = lp->rowidx[q];
+				if (tag[s] == i)
+					continue;
+				tag[s] = i;
+				if (ipm_adj_push(adj, len, cap, i, s) == impf_EXIT_FAILURE) {
+					state = impf_EXIT_FAILURE;
+					break;
+				}
+			}
+		}
+	}
+	for (i = 0; i < m; i++) {
+		done[i] = 0;
+		tag[i] = 0;
+	}
+	for (k = 0; k < m && state == impf_EXIT_SUCCESS; k++) {
+		for (v = -1, deg = m, i = 0; i < m; i++) {
+			if (!done[i] && (v < 0 || len[i] < deg)) {
+				deg = len[i];
+				v = i;
+			}
+		}
+		ch->perm[k] = v;
+		ch->pinv[v] = k;
+		done[v] = 1;
+		for (p = 0; p < len[v] && state == impf_EXIT_SUCCESS; p++) {
+			u = adj[v][p];  /* adj(u) = adj(u) + adj(v) - {u, v} */
+			ntag++;
+			for (q = 0, s = 0; q < len[u]; q++) {
+				if (adj[u][q] != v) {
+					tag[adj[u][q]] = ntag;
+					adj[u][s++] = adj[u][q];
+				}
+			}
+			len[u] = s;
+			for (q = 0; q < len[v]; q++) {
+				s = adj[v][q];
+				if (s == u || tag[s] == ntag)
+					continue;
+				if (ipm_adj_push(adj, len, cap, u, s) == impf_EXIT_FAILURE) {
+					state = impf_EXIT_FAILURE;
+					break;
+				}
+			}
+		}
+		impf_free(adj[v]);
+		adj[v] = NULL;
+	}
+	for (i = 0; i < m; i++)
+		impf_free(adj[i]);
+	impf_free(adj);
+	impf_free(len);
+	return state;
+}
+
+/* Pattern of the upper triangle of `P A A' P'`, counted only if `ci` is `NULL`
+ *
+ * Return the number of nonzeros
+ */
+static int ipm_chol_pattern(struct ipm *lp, int *ci)
+{
+	struct ipm_chol *ch = &lp->chol;
+	int i, j, k, p, q, t, nz = 0;
+
+	for (k = 0; k < lp->m; k++) {
+		i = ch->perm[k];
+		ch->cp[k] = nz;
+		ch->stamp++;
+		for (p = lp->rowptr[i]; p < lp->rowptr[i + 1]; p++) {
+			j = lp->colidx[p];
+			for (q = lp->colptr[j]; q < lp->colptr[j + 1]; q++) {
+				t = ch->pinv[lp->rowidx[q]];
+				if (t > k || ch->mark[t] == ch->stamp)
+					continue;
+				ch->mark[t] = ch->stamp;
+				if (ci != NULL)
+					ci[nz] = t;
+				nz++;
+			}
+		}
+	}
+	ch->cp[lp->m] = nz;
+	return nz;
+}
+
+/* Pattern of row `k` of L: the nodes reached in the elimination tree from the
+ * nonzeros of column `k` of the upper triangle, in topological order at
+ * `stack[top], ..., stack[m - 1]`
+ *
+ * Return `top`
+ */
+static int ipm_chol_ereach(struct ipm_chol *ch, const int m, const int k)
+{
+	int i, p, len, top = m;
+
+	ch->stamp++;
+	ch->mark[k] = ch->stamp;
+	for (p = ch->cp[k]; p < ch->cp[k + 1]; p++) {
+		for (i = ch->ci[p], len = 0; ch->mark[i] != ch->stamp; i = ch->parent[i]) {
+			ch->stack[len++] = i;
+			ch->mark[i] = ch->stamp;
+		}
+		while (len > 0)
+			ch->stack[--top] = ch->stack[--len];
+	}
+	return top;
+}
+
+/* Symbolic factorization: ordering, the pattern of the upper triangle, the
+ * elimination tree and the pattern of L
+ */
+static int ipm_chol_symbolic(struct ipm *lp)
+{
+	struct ipm_chol *ch = &lp->chol;
+	int m = lp->m, i, k, p, top, *ancestor = ch->next;
+
+	if (ipm_chol_order(lp) == impf_EXIT_FAILURE)
+		return impf_EXIT_FAILURE;
+	impf_memset(ch->mark, 0, (m + 1) * sizeof(int));
+	ch->stamp = 0;
+	ch->ci = impf_malloc((ipm_chol_pattern(lp, NULL) + 1) * sizeof(int));
+	if (ch->ci == NULL)
+		return impf_EXIT_FAILURE;
+	ipm_chol_pattern(lp, ch->ci);
+
+	for (k = 0; k < m; k++) {  /* elimination tree */
+		ch->parent[k] = -1;
+		ancestor[k] = -1;
+		for (p = ch->cp[k]; p < ch->cp[k + 1]; p++) {
+			for (i = ch->ci[p]; i != -1 && i < k; i = top) {
+				top = ancestor[i];
+				ancestor[i] = k;
+				if (top == -1)
+					ch->parent[i] = k;
+			}
+		}
+	}
+	for (k = 0; k < m; k++)  /* column counts of L */
+		ch->next[k] = 1;
+	for (k = 0; k < m; k++) {
+		for (top = ipm_chol_ereach(ch, m, k); top < m; top++)
+			ch->next[ch->stack[top]]++;
+	}
+	for (k = 0, ch->lp[0] = 0; k < m; k++)
+		ch->lp[k + 1] = ch->lp[k] + ch->next[k];
+	ch->li = impf_malloc((ch->lp[m] + 1) * sizeof(int));
+	ch->lx = impf_malloc((ch->lp[m] + 1) * sizeof(double));
+	if (ch->li == NULL || ch->lx == NULL)
+		return impf_EXIT_FAILURE;
+	impf_memset(ch->work, 0, (m + 1) * sizeof(double));
+	return impf_EXIT_SUCCESS;
+}
+
+/* Numeric factorization of `A D A'` (up-looking), with `D = theta`
+ *
+ * Note: a pivot vanishing against the diagonal comes from a dependent row, it
+ *	is replaced by a huge one so that the row is ignored by the solves
+ */
+static void ipm_chol_numeric(struct ipm *lp)
+{
+	struct ipm_chol *ch = &lp->chol;
+	int m = lp->m, i, j, k, p, q, t, top;
+	double d, dk, lki, a, *x = ch->work;
+
+	for (k = 0; k < m; k++)
+		ch->next[k] = ch->lp[k];
+	for (k = 0; k < m; k++) {
+		i = ch->perm[k];  /* x = column k of the upper triangle */
+		for (p = lp->rowptr[i]; p < lp->rowptr[i + 1]; p++) {
+			j = lp->colidx[p];
+			a = lp->rowval[p] * lp->theta[j];
+			for (q = lp->colptr[j]; q < lp->colptr[j + 1]; q++) {
+				t = ch->pinv[lp->rowidx[q]];
+				if (t <= k)
+					x[t] += a * lp->values[q];
+			}
+		}
+		dk = x[k];
+		d = dk;
+		x[k] = 0.;
+		for (top = ipm_chol_ereach(ch, m, k); top < m; top++) {
+			i = ch->stack[top];
+			lki = x[i] / ch->lx[ch->lp[i]];
+			x[i] = 0.;
+			for (p = ch->lp[i] + 1; p < ch->next[i]; p++)
+				x[ch->li[p]] -= ch->lx[p] * lki;
+			d -= lki * lki;
+			p = ch->next[i]++;
+			ch->li[p] = k;
+			ch->lx[p] = lki;
+		}
+		p = ch->next[k]++;
+		ch->li[p] = k;
+		ch->lx[p] = d > __impf_IDF_IPM_CHOL_ZERO__ * dk ? sqrt(d) : __impf_IDF_IPM_CHOL_HUGE__;
+	}
+}
+
+/* Solve `A D A' y = r` in place
+ */
+static void ipm_chol_solve(struct ipm *lp, double *r)
+{
+	struct ipm_chol *ch = &lp->chol;
+	int m = lp->m, k, p;
+	double *x = ch->work;
+
+	for (k = 0; k < m; k++)
+		x[k] = r[ch->perm[k]];
+	for (k = 0; k < m; k++) {
+		x[k] /= ch->lx[ch->lp[k]];
+		for (p = ch->lp[k] + 1; p < ch->lp[k + 1]; p++)
+			x[ch->li[p]] -= ch->lx[p] * x[k];
+	}
+	for (k = m - 1; k >= 0; k--) {
+		for (p = ch->lp[k] + 1; p < ch->lp[k + 1]; p++)
+			x[k] -= ch->lx[p] * x[ch->li[p]];
+		x[k] /= ch->lx[ch->lp[k]];
+	}
+	for (k = 0; k < m; k++) {
+		r[ch->perm[k]] = x[k];
+		x[k] = 0.;
+	}
+}
+
+/*******************************************************************************
+ * Primal-dual iterations
+ ******************************************************************************/
+
+/* out = A x
+ */
+static void ipm_ax(const struct ipm *lp, const double *x, double *out)
+{
+	int i, p;
+
+	for (i = 0; i < lp->m; i++) {
+		out[i] = 0.;
+		for (p = lp->rowptr[i]; p < lp->rowptr[i + 1]; p++)
+			out[i] += lp->rowval[p] * x[lp->colidx[p]];
+	}
+}
+
+/* out = A' y
+ */
+static void ipm_aty(const struct ipm *lp, const double *y, double *out)
+{
+	int j, p;
+
+	for (j = 0; j < lp->nvar; j++) {
+		out[j] = 0.;
+		for (p = lp->colptr[j]; p < lp->colptr[j + 1]; p++)
+			out[j] += lp->values[p] * y[lp->rowidx[p]];
+	}
+}
+
+/* Direction of the Newton system with residuals `rb`, `rc`, `ru`, `rxz`, `rwv`
+ * given the factorization of `A D A'`
+ *
+ *	A dx = rb,  A'dy + dz - dv = rc,  dx + dw = ru,
+ *	Z dx + X dz = rxz,  V dw + W dv = rwv
+ */
+static void ipm_direction(struct ipm *lp)
+{
+	int j, k;
+	double *r = lp->r;
+
+	for (j = 0; j < lp->nvar; j++) {
+		r[j] = lp->rc[j] - lp->rxz[j] / lp->x[j];
+		if (lp->u[j] < __impf_INF__)
+			r[j] += (lp->rwv[j] - lp->v[j] * lp->ru[j]) / lp->w[j];
+		lp->dx[j] = lp->theta[j] * r[j];
+	}
+	ipm_ax(lp, lp->dx, lp->dy);
+	for (j = 0; j < lp->m; j++)
+		lp->dy[j] += lp->rb[j];
+	ipm_chol_solve(lp, lp->dy);
+	ipm_aty(lp, lp->dy, lp->dx);
+	for (j = 0; j < lp->nvar; j++)
+		lp->dx[j] = lp->theta[j] * (lp->dx[j] - r[j]);
+	for (k = 0; k < __impf_CTR_IPM_REFINE__; k++) {  /* iterative refinement of `A dx = rb` */
+		ipm_ax(lp, lp->dx, lp->ry);
+		for (j = 0; j < lp->m; j++)
+			lp->ry[j] = lp->rb[j] - lp->ry[j];
+		ipm_chol_solve(lp, lp->ry);
+		ipm_aty(lp, lp->ry, lp->dz);
+		impf_linalg_daxpy(lp->m, 1., lp->ry, 1, lp->dy, 1);
+		for (j = 0; j < lp->nvar; j++)
+			lp->dx[j] += lp->theta[j] * lp->dz[j];
+	}
+	for (j = 0; j < lp->nvar; j++) {
+		lp->dz[j] = (lp->rxz[j] - lp->z[j] * lp->dx[j]) / lp->x[j];
+		if (lp->u[j] < __impf_INF__) {
+			lp->dw[j] = lp->ru[j] - lp->dx[j];
+			lp->dv[j] = (lp->rwv[j] - lp->v[j] * lp->dw[j]) / lp->w[j];
+		}
+	}
+}
+
+/* Largest step in [0, 1] keeping `x + a dx >= 0`, and `w + a dw >= 0` for
+ * columns with upper bound
+ */
+static double ipm_step(const struct ipm *lp, const double *x, const double *dx,
+		       const double *w, const double *dw)
+{
+	int j;
+	double a = 1.;
+
+	for (j = 0; j < lp->nvar; j++) {
+		if (dx[j] < 0. && -x[j] > a * dx[j])
+			a = -x[j] / dx[j];
+		if (lp->u[j] < __impf_INF__ && dw[j] < 0. && -w[j] > a * dw[j])
+			a = -w[j] / dw[j];
+	}
+	return a;
+}
+
+/* Complementarity `x'z + w'v` after steps `ap` and `ad`
+ */
+static double ipm_gap(const struct ipm *lp, const double ap, const double ad)
+{
+	int j;
+	double g = 0.;
+
+	for (j = 0; j < lp->nvar; j++) {
+		g += (lp->x[j] + ap * lp->dx[j]) * (lp->z[j] + ad * lp->dz[j]);
+		if (lp->u[j] < __impf_INF__)
+			g += (lp->w[j] + ap * lp->dw[j]) * (lp->v[j] + ad * lp->dv[j]);
+	}
+	return g;
+}
+
+/* Mehrotra's starting point: least squares solutions of `A x = b` and
+ * `A'y + z = c`, shifted into the interior
+ */
+static void ipm_start(struct ipm *lp)
+{
+	int j, nvar = lp->nvar;
+	double dp = 0., dd = 0., xz = 0., sx = 0., sz = 0.;
+
+	for (j = 0; j < nvar; j++)
+		lp->theta[j] = 1.;
+	ipm_chol_numeric(lp);
+	impf_memcpy(lp->dy, lp->b, lp->m * sizeof(double));
+	ipm_chol_solve(lp, lp->dy);
+	ipm_aty(lp, lp->dy, lp->x);
+	ipm_ax(lp, lp->c, lp->y);
+	ipm_chol_solve(lp, lp->y);
+	ipm_aty(lp, lp->y, lp->z);
+	for (j = 0; j < nvar; j++) {
+		lp->z[j] = lp->c[j] - lp->z[j];
+		if (lp->u[j] < __impf_INF__) {
+			lp->w[j] = lp->u[j] - lp->x[j];
+			lp->v[j] = __impf_MAX__(-lp->z[j], 0.);
+			lp->z[j] = __impf_MAX__(lp->z[j], 0.);
+			dp = __impf_MAX__(dp, -1.5 * lp->w[j]);
+		}
+		dp = __impf_MAX__(dp, -1.5 * lp->x[j]);
+		dd = __impf_MAX__(dd, -1.5 * lp->z[j]);
+	}
+	for (j = 0; j < nvar; j++) {
+		lp->x[j] += dp;
+		lp->z[j] += dd;
+		xz += lp->x[j] * lp->z[j];
+		sx += lp->x[j];
+		sz += lp->z[j];
+		if (lp->u[j] < __impf_INF__) {
+			lp->w[j] += dp;
+			lp->v[j] += dd;
+			xz += lp->w[j] * lp->v[j];
+			sx += lp->w[j];
+			sz += lp->v[j];
+		}
+	}
+	if (xz > 0.) {
+		dp = .5 * xz / sz;
+		dd = .5 * xz / sx;
+	} else {
+		dp = 1.;
+		dd = 1.;
+	}
+	for (j = 0; j < nvar; j++) {
+		lp->x[j] += dp;
+		lp->z[j] += dd;
+		if (lp->u[j] < __impf_INF__) {
+			lp->w[j] += dp;
+			lp->v[j] += dd;
+		}
+	}
+}
+
+/* Mehrotra's predictor-corrector iterations, stopping at a primal feasible
+ * point if `feasibility` is nonzero
+ */
+static int ipm_iterate(struct ipm *lp, const int niter, const int feasibility, int *code)
+{
+	int j, k, m = lp->m, nvar = lp->nvar;
+	double mu, mu0 = 0., mu_aff, sigma, ap, ad, pobj, dobj, ep, ed, nb, nc, nu, x0, y0;
+
+	ipm_start(lp);
+	nb = impf_linalg_damax(m, lp->b, 1);
+	nc = impf_linalg_damax(nvar, lp->c, 1);
+	for (j = 0, nu = 0.; j < nvar; j++)
+		nu = lp->u[j] < __impf_INF__ ? __impf_MAX__(nu, __impf_ABS__(lp->u[j])) : nu;
+	x0 = impf_linalg_damax(nvar, lp->x, 1);
+	y0 = __impf_MAX__(impf_linalg_damax(m, lp->y, 1), impf_linalg_damax(nvar, lp->z, 1));
+
+	for (k = 0; k < niter; k++) {
+		ipm_ax(lp, lp->x, lp->rb);
+		for (j = 0; j < m; j++)
+			lp->rb[j] = lp->b[j] - lp->rb[j];
+		ipm_aty(lp, lp->y, lp->rc);
+		pobj = impf_linalg_ddot(nvar, lp->c, 1, lp->x, 1);
+		dobj = impf_linalg_ddot(m, lp->b, 1, lp->y, 1);
+		for (j = 0, mu = 0.; j < nvar; j++) {
+			lp->rc[j] = lp->c[j] - lp->rc[j] - lp->z[j];
+			lp->ru[j] = 0.;
+			mu += lp->x[j] * lp->z[j];
+			if (lp->u[j] < __impf_INF__) {
+				lp->rc[j] += lp->v[j];
+				lp->ru[j] = lp->u[j] - lp->x[j] - lp->w[j];
+				mu += lp->w[j] * lp->v[j];
+				dobj -= lp->u[j] * lp->v[j];
+			}
+		}
+		mu /= nvar + lp->nbnd;
+		ep = __impf_MAX__(impf_linalg_damax(m, lp->rb, 1) / (1. + nb),
+				  impf_linalg_damax(nvar, lp->ru, 1) / (1. + nu));
+		ed = impf_linalg_damax(nvar, lp->rc, 1) / (1. + nc);
+		if (ep <= __impf_CTR_IPM_OPTIMAL__ && (feasibility || (ed <= __impf_CTR_IPM_OPTIMAL__
+		    && __impf_ABS__(pobj - dobj) <= __impf_CTR_IPM_OPTIMAL__ * (1. + __impf_ABS__(pobj))))) {
+#ifdef IMPF_MODE_DEV
+			impf_prt_dev(">>> Interior point done, niter = %i\n", k);
+#endif
+			*code = impf_Success;
+			return impf_EXIT_SUCCESS;
+		}
+		if (k == 0)
+			mu0 = mu;
+		if (!(mu > __impf_CTR_IPM_STALL__ * mu0)) {  /* complementary but not optimal */
+			*code = impf_PrecisionError;
+			return impf_EXIT_FAILURE;
+		}
+		if (impf_linalg_damax(m, lp->y, 1) > __impf_CTR_IPM_DIVERGE__ * (1. + y0)
+		    || impf_linalg_damax(nvar, lp->z, 1) > __impf_CTR_IPM_DIVERGE__ * (1. + y0)) {
+			*code = impf_Infeasibility;
+			return impf_EXIT_FAILURE;
+		}
+		if (impf_linalg_damax(nvar, lp->x, 1) > __impf_CTR_IPM_DIVERGE__ * (1. + x0)) {
+			*code = impf_Unboundedness;
+			return impf_EXIT_FAILURE;
+		}
+		for (j = 0; j < nvar; j++) {
+			lp->theta[j] = lp->z[j] / lp->x[j];
+			if (lp->u[j] < __impf_INF__)
+				lp->theta[j] += lp->v[j] / lp->w[j];
+			lp->theta[j] = 1. / lp->theta[j];
+		}
+		ipm_chol_numeric(lp);
+
+		/* predictor */
+		for (j = 0; j < nvar; j++) {
+			lp->rxz[j] = -lp->x[j] * lp->z[j];
+			lp->rwv[j] = -lp->w[j] * lp->v[j];
+		}
+		ipm_direction(lp);
+		ap = ipm_step(lp, lp->x, lp->dx, lp->w, lp->dw);
+		ad = ipm_step(lp, lp->z, lp->dz, lp->v, lp->dv);
+		mu_aff = ipm_gap(lp, ap, ad) / (nvar + lp->nbnd);
+		sigma = mu_aff / mu;
+		sigma = sigma * sigma * sigma;
+
+		/* corrector */
+		for (j = 0; j < nvar; j++) {
+			lp->rxz[j] += sigma * mu - lp->dx[j] * lp->dz[j];
+			if (lp->u[j] < __impf_INF__)
+				lp->rwv[j] += sigma * mu - lp->dw[j] * lp->dv[j];
+		}
+		ipm_direction(lp);
+		ap = __impf_MIN__(1., __impf_CTR_IPM_STEP__ * ipm_step(lp, lp->x, lp->dx, lp->w, lp->dw));
+		ad = __impf_MIN__(1., __impf_CTR_IPM_STEP__ * ipm_step(lp, lp->z, lp->dz, lp->v, lp->dv));
+		if (ap < __impf_CTR_IPM_STEP_MIN__ && ad < __impf_CTR_IPM_STEP_MIN__) {
+			*code = impf_PrecisionError;
+			return impf_EXIT_FAILURE;
+		}
+		impf_linalg_daxpy(nvar, ap, lp->dx, 1, lp->x, 1);
+		impf_linalg_daxpy(m, ad, lp->dy, 1, lp->y, 1);
+		impf_linalg_daxpy(nvar, ad, lp->dz, 1, lp->z, 1);
+		for (j = 0; j < nvar && lp->nbnd > 0; j++) {
+			if (lp->u[j] < __impf_INF__) {
+				lp->w[j] += ap * lp->dw[j];
+				lp->v[j] += ad * lp->dv[j];
+			}
+		}
+	}
+	*code = impf_ExceedIterLimit;
+	return impf_EXIT_FAILURE;
+}
+
+/* Solve the loaded LP, with the solution in original variables
+ */
+static int ipm_solve(struct ipm *lp, const double *objective, const int niter,
+		     double *x, double *value, int *code)
+{
+	int j, k, feas;
+
+	if (ipm_chol_symbolic(lp) == impf_EXIT_FAILURE) {
+		*code = impf_MemoryAllocError;
+		return impf_EXIT_FAILURE;
+	}
+	if (ipm_iterate(lp, niter, 0, code) == impf_EXIT_FAILURE) {
+		/* diverging primal iterates (or a stall) also come from LP
+		 * being infeasible, which is told by looking for a feasible
+		 * point of `c = 0`
+		 */
+		if (impf_Unboundedness == *code || impf_PrecisionError == *code
+		    || impf_ExceedIterLimit == *code) {
+			impf_memset(lp->c, 0, lp->nvar * sizeof(double));
+			if (ipm_iterate(lp, niter, 1, &feas) == impf_EXIT_FAILURE)
+				*code = impf_Infeasibility;
+		}
+		return impf_EXIT_FAILURE;
+	}
+	for (j = 0, *value = 0.; j < lp->n; j++) {
+		k = lp->col[j];
+		switch (lp->kind[j]) {
+		case IPM_VAR_LO:
+			x[j] = lp->shift[j] + lp->x[k];
+			break;
+		case IPM_VAR_UP:
+			x[j] = lp->shift[j] - lp->x[k];
+			break;
+		case IPM_VAR_FR:
+			x[j] = lp->x[k] - lp->x[k + 1];
+			break;
+		default:
+			x[j] = lp->shift[j];
+			break;
+		}
+		*value += objective[j] * x[j];
+	}
+	return impf_EXIT_SUCCESS;
+}
+
+int impf_lp_interior(const double *objective, const struct impf_LinearConstraint *constraints,
+		     const struct impf_VariableBound *bounds, const int m, const int n, const int niter,
+		     double *x, double *value, int *code)
+{
+	struct ipm lp;
+	int state;
+
+	assert(objective != NULL);
+	assert(constraints != NULL);
+	assert(x != NULL);
+	assert(value != NULL);
+	assert(code != NULL);
+
+	if (ipm_load(&lp, objective, NULL, NULL, NULL, constraints, bounds, m, n, code) == impf_EXIT_FAILURE)
+		return impf_EXIT_FAILURE;
+	state = ipm_solve(&lp, objective, niter, x, value, code);
+	ipm_free(&lp);
+	return state;
+}
+
+int impf_lp_interior_csc(const double *objective, const int *colptr, const int *rowidx, const double *values,
+			 const struct impf_LinearConstraint *constraints,
+			 const struct impf_VariableBound *bounds, const int m, const int n, const int niter,
+			 double *x, double *value, int *code)
+{
+	struct ipm lp;
+	int state;
+
+	assert(objective != NULL);
+	assert(colptr != NULL);
+	assert(rowidx != NULL);
+	assert(values != NULL);
+	assert(constraints != NULL);
+	assert(x != NULL);
+	assert(value != NULL);
+	assert(code != NULL);
+
+	if (ipm_load(&lp, objective, colptr, rowidx, values, constraints, bounds, m, n, code)
+	    == impf_EXIT_FAILURE)
+		return impf_EXIT_FAILURE;
+	state = ipm_solve(&lp, objective, niter, x, value, code);
+	ipm_free(&lp);
+	return state;
+}
+
+int impf_lp_interior_wrp(const struct impf_Model_LP *model, const int niter,
+			 double *x, double *value, int *code)
+{
+	assert(model != NULL);
+
+	return impf_lp_interior_csc(model->objective, model->colptr, model->rowidx, model->values,
+				    model->constraints, model->bounds, model->m, model->n, niter,
+				    x, value, code);
+}
@@ -0,0 +1,645 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <impf/_magics.h>
+#include <impf/linalg.h>
+#include <impf/fmin_lp.h>
+#include <math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Node selection rules */
+#define MIP_SELECT_HYBRID	0	/* depth first until an incumbent, then best bound */
+#define MIP_SELECT_BEST		1
+#define MIP_SELECT_DEPTH	2
+
+/* Node of the search tree, the LP relaxation under bounds `lb` and `ub`
+ * warm started from the optimal basis of its parent
+ */
+struct mip_node {
+	double bound;	/* optimal value of the parent LP */
+	int var;	/* branching variable of the parent, -1 at root */
+	int up;		/* whether the branch rounds `var` up */
+	double frac;	/* distance of `var` to the new bound in the parent LP */
+	double *lb;	/* length = n */
+	double *ub;	/* length = n */
+	int *basis;	/* length = m */
+};
+
+/* Open nodes of a thread, taken by the thread and stolen by others
+ */
+struct mip_pool {
+	struct mip_node **node;
+	int size;
+	int cap;
+#ifdef _OPENMP
+	omp_lock_t lock;
+#endif
+};
+
+/* Branch-and-bound search shared by threads
+ *
+ * Note: members after `pool` are guarded by the critical section `impf_mip`
+ */
+struct mip {
+	const double *objective;
+	const struct impf_LinearConstraint *constraints;
+	int m;
+	int n;
+	int niter;
+	int nnode;
+	int select;
+	int nthreads;
+	int *isint;	/* whether variables are integers, length = n */
+	struct mip_pool *pool;	/* pools of threads, length = nthreads */
+	double *pcost;	/* pseudo-cost sums of down and up branches, length = 2n */
+	int *pcount;	/* pseudo-cost counts of down and up branches, length = 2n */
+	double *x;	/* incumbent, length = n */
+	double value;	/* value of the incumbent, `__impf_INF__` if none */
+	int nopen;	/* nodes in pools */
+	int nactive;	/* threads holding a node */
+	int nsolved;	/* node LPs solved */
+	int stop;
+	int code;
+};
+
+static void mip_node_free(struct mip_node *node)
+{
+	if (node == NULL)
+		return;
+	impf_free(node->lb);
+	impf_free(node->basis);
+	impf_free(node);
+}
+
+/* Allocate a node, with `lb` and `ub` in one block
+ */
+static struct mip_node *mip_node_create(const int m, const int n)
+{
+	struct mip_node *node = impf_malloc(sizeof(struct mip_node));
+
+	if (node == NULL)
+		return NULL;
+	node->lb = impf_malloc(2 * n * sizeof(double));
+	node->basis = impf_malloc((m > 0 ? m : 1) * sizeof(int));
+	if (node->lb == NULL || node->basis == NULL) {
+		impf_free(node->lb);
+		impf_free(node->basis);
+		impf_free(node);
+		return NULL;
+	}
+	node->ub = node->lb + n;
+	node->var = -1;
+	node->up = 0;
+	node->frac = 0.;
+	node->bound = __impf_NINF__;
+	return node;
+}
+
+/* Bounds of a variable (see `impf_BOUND_T_*` in <fmin.h>), rounded inwards
+ * if it is an integer
+ */
+static void mip_var_bounds(const struct impf_VariableBound *bd, double *lb, double *ub, int *isint)
+{
+	*isint = 0;
+	if (bd == NULL) {
+		*lb = 0.;
+		*ub = __impf_INF__;
+		return;
+	}
+	switch (bd->b_type) {
+	case impf_BOUND_T_FR:
+		*lb = __impf_NINF__;
+		*ub = __impf_INF__;
+		break;
+	case impf_BOUND_T_UP:
+		*lb = 0.;
+		*ub = bd->ub;
+		break;
+	case impf_BOUND_T_BS:
+		*lb = bd->lb;
+		*ub = bd->ub;
+		break;
+	default:
+		*lb = bd->lb;
+		*ub = __impf_INF__;
+		break;
+	}
+	if (bd->v_type == impf_VAR_T_BIN) {
+		*lb = __impf_MAX__(*lb, 0.);
+		*ub = __impf_MIN__(*ub, 1.);
+	}
+	if (bd->v_type == impf_VAR_T_INT || bd->v_type == impf_VAR_T_BIN) {
+		*isint = 1;
+		if (*lb > __impf_NINF__)
+			*lb = ceil(*lb - __impf_CTR_MIP_INTEGER__);
+		if (*ub < __impf_INF__)
+			*ub = floor(*ub + __impf_CTR_MIP_INTEGER__);
+	}
+}
+
+/*******************************************************************************
+ * Pools of open nodes
+ ******************************************************************************/
+
+static void mip_lock(struct mip_pool *pool)
+{
+#ifdef _OPENMP
+	omp_set_lock(&pool->lock);
+#else
+	(void)pool;
+#endif
+}
+
+static void mip_unlock(struct mip_pool *pool)
+{
+#ifdef _OPENMP
+	omp_unset_lock(&pool->lock);
+#else
+	(void)pool;
+#endif
+}
+
+/* Put `node` to the pool of thread `t`
+ */
+static int mip_push(struct mip *mip, const int t, struct mip_node *node)
+{
+	struct mip_pool *pool = mip->pool + t;
+	struct mip_node **arr;
+	int state = impf_EXIT_SUCCESS;
+
+	mip_lock(pool);
+	if (pool->size == pool->cap) {
+		arr = impf_realloc(pool->node, 2 * pool->cap * sizeof(struct mip_node *));
+		if (arr == NULL)
+			state = impf_EXIT_FAILURE;
+		else {
+			pool->node = arr;
+			pool->cap *= 2;
+		}
+	}
+	if (state == impf_EXIT_SUCCESS)
+		pool->node[pool->size++] = node;
+	mip_unlock(pool);
+	if (state == impf_EXIT_SUCCESS) {
+#ifdef _OPENMP
+#pragma omp critical (impf_mip)
+#endif
+		mip->nopen++;
+	}
+	return state;
+}
+
+/* Remove a node from the pool, the last one if `last`, otherwise the one of
+ * the smallest bound (the earliest of ties)
+ */
+static struct mip_node *mip_pop(struct mip_pool *pool, const int last)
+{
+	struct mip_node *node = NULL;
+	int k, best = -1;
+
+	mip_lock(pool);
+	if (pool->size > 0) {
+		best = pool->size - 1;
+		if (!last) {
+			for (k = 0, best = 0; k < pool->size; k++) {
+				if (pool->node[k]->bound < pool->node[best]->bound)
+					best = k;
+			}
+		}
+		node = pool->node[best];
+		for (k = best; k < pool->size - 1; k++)
+			pool->node[k] = pool->node[k + 1];
+		pool->size--;
+	}
+	mip_unlock(pool);
+	return node;
+}
+
+/* Take a node for thread `t`: from its own pool by the selection rule, or
+ * stolen from the pools of other threads in turn. A stolen node is the one
+ * of the smallest bound, which is also the oldest one in depth-first search
+ * since bounds do not decrease down the tree.
+ *
+ * Return the node, or `NULL` if all pools are empty
+ */
+static struct mip_node *mip_take(struct mip *mip, const int t)
+{
+	struct mip_node *node;
+	int k, depth;
+
+#ifdef _OPENMP
+#pragma omp critical (impf_mip)
+#endif
+	depth = mip->select == MIP_SELECT_DEPTH
+		|| (mip->select == MIP_SELECT_HYBRID && mip->value == __impf_INF__);
+	node = mip_pop(mip->pool + t, depth);
+	for (k = 1; node == NULL && k < mip->nthreads; k++)
+		node = mip_pop(mip->pool + (t + k) % mip->nthreads, 0);
+	return node;
+}
+
+/*******************************************************************************
+ * Branching
+ ******************************************************************************/
+
+/* Average pseudo-costs of branches `dir` (0 down, 1 up) of all variables
+ * branched so far, 1 if there is none
+ * Should be called in the critical section `impf_mip`
+ */
+static double mip_pcost_avg(const struct mip *mip, const int dir)
+{
+	int k, cnt = 0;
+	double sum = 0.;
+
+	for (k = dir * mip->n; k < (dir + 1) * mip->n; k++) {
+		if (mip->pcount[k] > 0) {
+			sum += mip->pcost[k] / mip->pcount[k];
+			cnt++;
+		}
+	}
+	return cnt > 0 ? sum / cnt : 1.;
+}
+
+/* Average pseudo-cost of branches `dir` of variable `j`, `avg` if it has not
+ * been branched yet
+ * Should be called in the critical section `impf_mip`
+ */
+static double mip_pcost(const struct mip *mip, const int j, const int dir, const double avg)
+{
+	int k = j + dir * mip->n;
+
+	return mip->pcount[k] > 0 ? mip->pcost[k] / mip->pcount[k] : avg;
+}
+
+/* Choose the fractional integer variable of the largest product of the
+ * estimated increases of the objective in its down and up branches
+ *
+ * Return the variable, or -1 if `x` is integer feasible. The estimated
+ * increases of the chosen one are put in `down` and `up`.
+ */
+static int mip_branch_var(const struct mip *mip, const double *x, double *down, double *up)
+{
+	int j, q = -1;
+	double f, d, u, score, best = -1., avgd, avgu;
+	const double eps = __impf_CTR_MIP_PSEUDO__;
+
+#ifdef _OPENMP
+#pragma omp critical (impf_mip)
+#endif
+	{
+		avgd = mip_pcost_avg(mip, 0);
+		avgu = mip_pcost_avg(mip, 1);
+		for (j = 0; j < mip->n; j++) {
+			if (!mip->isint[j])
+				continue;
+			f = x[j] - floor(x[j]);
+			if (f <= __impf_CTR_MIP_INTEGER__ || f >= 1. - __impf_CTR_MIP_INTEGER__)
+				continue;
+			d = f * mip_pcost(mip, j, 0, avgd);
+			u = (1. - f) * mip_pcost(mip, j, 1, avgu);
+			score = __impf_MAX__(d, eps) * __impf_MAX__(u, eps);
+			if (score > best) {
+				best = score;
+				q = j;
+				*down = d;
+				*up = u;
+			}
+		}
+	}
+	return q;
+}
+
+/* Record the increase of the objective from the parent of `node` to `value`
+ */
+static void mip_pcost_update(struct mip *mip, const struct mip_node *node, const double value)
+{
+	int k;
+
+	if (node->var < 0 || node->frac <= 0.)
+		return;
+	k = node->var + node->up * mip->n;
+#ifdef _OPENMP
+#pragma omp critical (impf_mip)
+#endif
+	{
+		mip->pcost[k] += __impf_MAX__(value - node->bound, 0.) / node->frac;
+		mip->pcount[k]++;
+	}
+}
+
+/* Whether a node of `bound` cannot improve the incumbent
+ */
+static int mip_prune(struct mip *mip, const double bound)
+{
+	int prune;
+
+#ifdef _OPENMP
+#pragma omp critical (impf_mip)
+#endif
+	prune = mip->value < __impf_INF__
+		&& bound >= mip->value - __impf_CTR_MIP_GAP__ * (1. + __impf_ABS__(mip->value));
+	return prune;
+}
+
+/* Stop the search of all threads with error `code`
+ */
+static void mip_abort(struct mip *mip, const int code)
+{
+#ifdef _OPENMP
+#pragma omp critical (impf_mip)
+#endif
+	if (!mip->stop) {
+		mip->stop = 1;
+		mip->code = code;
+	}
+}
+
+/* Put the two children of `node` branching on `q` at `xq` to the pool of
+ * thread `t`, the preferred child (of the smaller estimated increase) is put
+ * last so that depth-first search takes it first
+ */
+static int mip_branch(struct mip *mip, const int t, const struct mip_node *node, const int *basis,
+		      const double value, const int q, const double xq, const double down, const double up)
+{
+	struct mip_node *child[2];
+	int k, first = down < up || (down == up && xq - floor(xq) >= .5) ? 1 : 0;
+
+	for (k = 0; k < 2; k++) {
+		child[k] = mip_node_create(mip->m, mip->n);
+		if (child[k] == NULL) {
+			mip_node_free(child[0]);
+			return impf_EXIT_FAILURE;
+		}
+		impf_memcpy(child[k]->lb, node->lb, 2 * mip->n * sizeof(double));
+		impf_memcpy(child[k]->basis, basis, mip->m * sizeof(int));
+		child[k]->bound = value;
+		child[k]->var = q;
+		child[k]->up = k;
+	}
+	child[0]->ub[q] = floor(xq);
+	child[0]->frac = xq - floor(xq);
+	child[1]->lb[q] = ceil(xq);
+	child[1]->frac = ceil(xq) - xq;
+	if (mip_push(mip, t, child[first]) == impf_EXIT_FAILURE) {
+		mip_node_free(child[0]);
+		mip_node_free(child[1]);
+		return impf_EXIT_FAILURE;
+	}
+	if (mip_push(mip, t, child[1 - first]) == impf_EXIT_FAILURE) {
+		mip_node_free(child[1 - first]);
+		return impf_EXIT_FAILURE;
+	}
+	return impf_EXIT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Search by threads
+ ******************************************************************************/
+
+/* Solve the LP relaxation of `node` by the dual simplex from the basis of its
+ * parent, then prune, record an incumbent or branch
+ *
+ * Buffers: `bd` (length = n), `x` (length = n) and `basis` (length = m)
+ */
+static void mip_solve_node(struct mip *mip, const int t, const struct mip_node *node,
+			   struct impf_VariableBound *bd, double *x, int *basis)
+{
+	int j, q, code, m = mip->m, n = mip->n;
+	double value, down = 0., up = 0.;
+
+	for (j = 0; j < n; j++) {
+		bd[j].lb = node->lb[j];
+		bd[j].ub = node->ub[j];
+		bd[j].b_type = impf_BOUND_T_BS;
+		bd[j].v_type = mip->isint[j] ? impf_VAR_T_INT : impf_VAR_T_REAL;
+	}
+	impf_memcpy(basis, node->basis, m * sizeof(int));
+	if (impf_lp_simplex_dual(mip->objective, mip->constraints, bd, m, n, mip->niter, basis,
+				 x, &value, &code) == impf_EXIT_FAILURE) {
+		if (code != impf_Infeasibility)
+			mip_abort(mip, code);
+		return;
+	}
+	mip_pcost_update(mip, node, value);
+	if (mip_prune(mip, value))
+		return;
+	q = mip_branch_var(mip, x, &down, &up);
+	if (q >= 0) {
+		if (mip_branch(mip, t, node, basis, value, q, x[q], down, up) == impf_EXIT_FAILURE)
+			mip_abort(mip, impf_MemoryAllocError);
+		return;
+	}
+	for (j = 0, value = 0.; j < n; j++) {  /* integer feasible */
+		if (mip->isint[j])
+			x[j] = floor(x[j] + .5);
+		value += mip->objective[j] * x[j];
+	}
+#ifdef _OPENMP
+#pragma omp critical (impf_mip)
+#endif
+	if (value < mip->value) {
+		mip->value = value;
+		impf_memcpy(mip->x, x, n * sizeof(double));
+	}
+}
+
+/* Loop of thread `t`: take a node, solve it, until all pools are empty and
+ * no thread holds a node. A thread counts as active from taking a node to
+ * failing to take one, so the children it puts to pools are always seen.
+ */
+static void mip_worker(struct mip *mip, const int t)
+{
+	struct impf_VariableBound *bd;
+	struct mip_node *node;
+	double *x;
+	int *basis, active = 0, done = 0, solve;
+
+	bd = impf_malloc(mip->n * sizeof(struct impf_VariableBound));
+	x = impf_malloc(mip->n * sizeof(double));
+	basis = impf_malloc((mip->m > 0 ? mip->m : 1) * sizeof(int));
+	if (bd == NULL || x == NULL || basis == NULL)
+		mip_abort(mip, impf_MemoryAllocError);
+	else
+		impf_memset(bd, 0, mip->n * sizeof(struct impf_VariableBound));
+
+	while (!done) {
+		node = mip_take(mip, t);
+		solve = 0;
+#ifdef _OPENMP
+#pragma omp critical (impf_mip)
+#endif
+		{
+			if (node != NULL) {
+				mip->nopen--;
+				if (!active)
+					mip->nactive++;
+				active = 1;
+				if (!mip->stop && mip->nsolved >= mip->nnode) {
+					mip->stop = 1;
+					mip->code = impf_ExceedIterLimit;
+				}
+				if (!mip->stop) {
+					mip->nsolved++;
+					solve = 1;
+				}
+			} else {
+				if (active)
+					mip->nactive--;
+				active = 0;
+			}
+			done = mip->stop || (mip->nopen == 0 && mip->nactive == 0);
+		}
+		if (solve && !mip_prune(mip, node->bound))
+			mip_solve_node(mip, t, node, bd, x, basis);
+		mip_node_free(node);
+	}
+	if (active) {
+#ifdef _OPENMP
+#pragma omp critical (impf_mip)
+#endif
+		mip->nactive--;
+	}
+	impf_free(bd);
+	impf_free(x);
+	impf_free(basis);
+}
+
+static void mip_free(struct mip *mip)
+{
+	int t, k;
+
+	if (mip->pool != NULL) {
+		for (t = 0; t < mip->nthreads; t++) {
+			for (k = 0; k < mip->pool[t].size; k++)
+				mip_node_free(mip->pool[t].node[k]);
+			impf_free(mip->pool[t].node);
+#ifdef _OPENMP
+			omp_destroy_lock(&mip->pool[t].lock);
+#endif
+		}
+	}
+	impf_free(mip->pool);
+	impf_free(mip->isint);
+	impf_free(mip->pcost);
+	impf_free(mip->pcount);
+	impf_free(mip->x);
+}
+
+/* Allocate the search and put the root node in the pool of thread 0
+ */
+static int mip_create(struct mip *mip, const struct impf_VariableBound *bounds)
+{
+	struct mip_node *root;
+	int i, j, t, m = mip->m, n = mip->n;
+
+	mip->isint = impf_malloc((n > 0 ? n : 1) * sizeof(int));
+	mip->pcost = impf_malloc((n > 0 ? 2 * n : 1) * sizeof(double));
+	mip->pcount = impf_malloc((n > 0 ? 2 * n : 1) * sizeof(int));
+	mip->x = impf_malloc((n > 0 ? n : 1) * sizeof(double));
+	mip->pool = impf_malloc(mip->nthreads * sizeof(struct mip_pool));
+	if (mip->isint == NULL || mip->pcost == NULL || mip->pcount == NULL || mip->x == NULL
+	    || mip->pool == NULL) {
+		impf_free(mip->pool);
+		mip->pool = NULL;
+		return impf_EXIT_FAILURE;
+	}
+	impf_memset(mip->pcost, 0, 2 * n * sizeof(double));
+	impf_memset(mip->pcount, 0, 2 * n * sizeof(int));
+	for (t = 0; t < mip->nthreads; t++) {
+		mip->pool[t].size = 0;
+		mip->pool[t].cap = 16;
+		mip->pool[t].node = impf_malloc(16 * sizeof(struct mip_node *));
+#ifdef _OPENMP
+		omp_init_lock(&mip->pool[t].lock);
+#endif
+	}
+	for (t = 0; t < mip->nthreads; t++) {
+		if (mip->pool[t].node == NULL)
+			return impf_EXIT_FAILURE;
+	}
+	root = mip_node_create(m, n);
+	if (root == NULL)
+		return impf_EXIT_FAILURE;
+	for (j = 0; j < n; j++)
+		mip_var_bounds(bounds ? bounds + j : NULL, root->lb + j, root->ub + j, mip->isint + j);
+	for (i = 0; i < m; i++)
+		root->basis[i] = n + i;  /* all-logical basis */
+	if (mip_push(mip, 0, root) == impf_EXIT_FAILURE) {
+		mip_node_free(root);
+		return impf_EXIT_FAILURE;
+	}
+	return impf_EXIT_SUCCESS;
+}
+
+/* Node selection rule of `criteria`
+ */
+static int mip_select(const char *criteria)
+{
+	if (criteria != NULL && 4 == impf_strlen(criteria) && 0 == impf_memcmp("best", criteria, 4))
+		return MIP_SELECT_BEST;
+	if (criteria != NULL && 5 == impf_strlen(criteria) && 0 == impf_memcmp("depth", criteria, 5))
+		return MIP_SELECT_DEPTH;
+	return MIP_SELECT_HYBRID;
+}
+
+int impf_lp_mip(const double *objective, const struct impf_LinearConstraint *constraints,
+		const struct impf_VariableBound *bounds, const int m, const int n, const char *criteria,
+		const int niter, const int nnode, const int nthreads, double *x, double *value, int *code)
+{
+	struct mip mip;
+	int state = impf_EXIT_FAILURE;
+
+	assert(objective != NULL);
+	assert(constraints != NULL);
+	assert(x != NULL);
+	assert(value != NULL);
+	assert(code != NULL);
+
+	if (nthreads < 1 || nnode < 1) {
+		*code = impf_CondUnsatisfied;
+		return impf_EXIT_FAILURE;
+	}
+	impf_memset(&mip, 0, sizeof(struct mip));
+	mip.objective = objective;
+	mip.constraints = constraints;
+	mip.m = m;
+	mip.n = n;
+	mip.niter = niter;
+	mip.nnode = nnode;
+	mip.select = mip_select(criteria);
+	mip.nthreads = 1;
+#ifdef _OPENMP
+	mip.nthreads = nthreads;
+#endif
+	mip.value = __impf_INF__;
+	mip.code = impf_Success;
+	if (mip_create(&mip, bounds) == impf_EXIT_FAILURE) {
+		mip_free(&mip);
+		*code = impf_MemoryAllocError;
+		return impf_EXIT_FAILURE;
+	}
+
+	impf_linalg_simd();  /* detected before threads start */
+#ifdef _OPENMP
+#pragma omp parallel num_threads(mip.nthreads) if (mip.nthreads > 1)
+	mip_worker(&mip, omp_get_thread_num());
+#else
+	mip_worker(&mip, 0);
+#endif
+#ifdef IMPF_MODE_DEV
+	impf_prt_dev(">>> Branch-and-bound done, nnode = %i\n", mip.nsolved);
+#endif
+
+	*code = mip.code;
+	if (mip.value < __impf_INF__ && (impf_Success == mip.code || impf_ExceedIterLimit == mip.code)) {
+		impf_memcpy(x, mip.x, n * sizeof(double));
+		*value = mip.value;
+		state = impf_Success == mip.code ? impf_EXIT_SUCCESS : impf_EXIT_FAILURE;
+	} else if (impf_Success == mip.code)
+		*code = impf_Infeasibility;
+	mip_free(&mip);
+	return state;
+}
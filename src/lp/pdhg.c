@@ -0,0 +1,832 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <impf/_magics.h>
+#include <impf/fmin_lp.h>
+#include <math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Whether a loop of `lp` touching `nwork` entries is shared by threads
+ *
+ * Note: each thread takes a contiguous block of the loop and the partial sums
+ *	of threads are added in a fixed order, so that the iterates do not
+ *	change from run to run
+ */
+#define pdhg_parallel(lp, nwork) ((lp)->nthreads > 1 && (nwork) >= __impf_CTR_PDHG_PARALLEL__)
+
+/* Number of partial sums of each thread */
+#define PDHG_NPART	2
+
+/* Scaled LP of primal-dual hybrid gradient method
+ *
+ *	min  c'x			max  q'y + l'z+ - u'z-
+ *	s.t. K x = q ("EQ" rows)	s.t. c - K'y = z+ - z-
+ *	     K x >= q (other rows)	     y >= 0 ("GE" rows), z+, z- >= 0
+ *	     l <= x <= u
+ *
+ * where `K = Dr A Dc` with "LE" rows of A negated, `q = Dr b`, `c = Dc c0`
+ * and the bounds are divided by Dc. Iterates of the original LP are `Dc x`
+ * and `Dr y`
+ */
+struct pdhg {
+	int m;
+	int n;
+	int nthreads;	/* number of threads sharing the loops */
+	int *colptr;	/* K, column compressed, length = n + 1 */
+	int *rowidx;
+	double *values;
+	int *rowptr;	/* K, row compressed, length = m + 1 */
+	int *colidx;
+	double *rowval;
+	int *eq;	/* whether a row is "EQ", length = m */
+	double *q, *dr;			/* length = m */
+	double *c, *l, *u, *dc;		/* length = n */
+	double bnorm, cnorm;		/* norms of the original b and c */
+	double *x, *kx, *y, *kty;	/* iterate, with `K x` and `K'y` */
+	double *xn, *kxn, *yn, *ktyn;	/* trial iterate */
+	double *xa, *kxa, *ya, *ktya;	/* sums weighted by steps since restart */
+	double *xr, *kxr, *yr, *ktyr;	/* iterate of the last restart */
+	double *xp, *kxp, *yp, *ktyp;	/* iterate of the last evaluation */
+	double *part;	/* partial sums of threads */
+};
+
+static void pdhg_free(struct pdhg *lp)
+{
+	impf_free(lp->colptr);
+	impf_free(lp->values);
+}
+
+static int pdhg_create(struct pdhg *lp, const int m, const int n, const int nnz, const int nthreads)
+{
+	int nint = (n + 1) + nnz + (m + 1) + nnz + m;
+	int ndbl = 2 * nnz + 14 * n + 12 * m;
+	double *d;
+
+	impf_memset(lp, 0, sizeof(struct pdhg));
+	lp->m = m;
+	lp->n = n;
+	lp->nthreads = 1;
+#ifdef _OPENMP
+	lp->nthreads = nthreads;
+#endif
+	ndbl += PDHG_NPART * lp->nthreads;
+	lp->colptr = impf_malloc(nint * sizeof(int));
+	lp->values = impf_malloc(ndbl * sizeof(double));
+	if (lp->colptr == NULL || lp->values == NULL) {
+		pdhg_free(lp);
+		return impf_EXIT_FAILURE;
+	}
+	impf_memset(lp->values, 0, ndbl * sizeof(double));
+	lp->rowidx = lp->colptr + n + 1;
+	lp->rowptr = lp->rowidx + nnz;
+	lp->colidx = lp->rowptr + m + 1;
+	lp->eq = lp->colidx + nnz;
+	d = lp->values + nnz;
+	lp->rowval = d;
+	d += nnz;
+	lp->c = d;
+	lp->l = d + n;
+	lp->u = d + 2 * n;
+	lp->dc = d + 3 * n;
+	lp->x = d + 4 * n;
+	lp->kty = d + 5 * n;
+	lp->xn = d + 6 * n;
+	lp->ktyn = d + 7 * n;
+	lp->xa = d + 8 * n;
+	lp->ktya = d + 9 * n;
+	lp->xr = d + 10 * n;
+	lp->ktyr = d + 11 * n;
+	lp->xp = d + 12 * n;
+	lp->ktyp = d + 13 * n;
+	d += 14 * n;
+	lp->q = d;
+	lp->dr = d + m;
+	lp->kx = d + 2 * m;
+	lp->y = d + 3 * m;
+	lp->kxn = d + 4 * m;
+	lp->yn = d + 5 * m;
+	lp->kxa = d + 6 * m;
+	lp->ya = d + 7 * m;
+	lp->yr = d + 8 * m;
+	lp->kxr = d + 9 * m;
+	lp->kxp = d + 10 * m;
+	lp->yp = d + 11 * m;
+	lp->part = d + 12 * m;
+	return impf_EXIT_SUCCESS;
+}
+
+/* Bounds of an original variable, `x >= 0` if no bound is given
+ */
+static void pdhg_var_bounds(const struct impf_VariableBound *bd, double *lb, double *ub)
+{
+	if (bd == NULL) {
+		*lb = 0.;
+		*ub = __impf_INF__;
+		return;
+	}
+	switch (bd->b_type) {
+	case impf_BOUND_T_FR:
+		*lb = __impf_NINF__;
+		*ub = __impf_INF__;
+		break;
+	case impf_BOUND_T_UP:
+		*lb = 0.;
+		*ub = bd->ub;
+		break;
+	case impf_BOUND_T_BS:
+		*lb = bd->lb;
+		*ub = bd->ub;
+		break;
+	default:
+		*lb = bd->lb;
+		*ub = __impf_INF__;
+		break;
+	}
+}
+
+/* Entry `p` of original column `j` (row `i`), column compressed if `values`
+ * is given, otherwise the dense `coef` of constraints
+ */
+#define pdhg_coef(constraints, values, p, i, j) \
+	((values) != NULL ? (values)[p] : (constraints)[i].coef[j])
+
+/* Diagonal preconditioning of K: Ruiz equilibration in the max norm, followed
+ * by the Pock-Chambolle scaling (`alpha = 1`) in the 1-norm
+ */
+static void pdhg_scale(struct pdhg *lp)
+{
+	int i, j, k, p, m = lp->m, n = lp->n;
+	double a, *rs = lp->kxn, *cs = lp->ktyn;  /* trial buffers are free here */
+
+	for (i = 0; i < m; i++)
+		lp->dr[i] = 1.;
+	for (j = 0; j < n; j++)
+		lp->dc[j] = 1.;
+	for (k = 0; k <= __impf_CTR_PDHG_RUIZ__; k++) {
+		impf_memset(rs, 0, m * sizeof(double));
+		impf_memset(cs, 0, n * sizeof(double));
+		for (j = 0; j < n; j++) {
+			for (p = lp->colptr[j]; p < lp->colptr[j + 1]; p++) {
+				a = __impf_ABS__(lp->values[p]);
+				i = lp->rowidx[p];
+				if (k < __impf_CTR_PDHG_RUIZ__) {
+					rs[i] = __impf_MAX__(rs[i], a);
+					cs[j] = __impf_MAX__(cs[j], a);
+				} else {
+					rs[i] += a;
+					cs[j] += a;
+				}
+			}
+		}
+		for (i = 0; i < m; i++) {
+			rs[i] = rs[i] > 0. ? 1. / sqrt(rs[i]) : 1.;
+			lp->dr[i] *= rs[i];
+		}
+		for (j = 0; j < n; j++) {
+			cs[j] = cs[j] > 0. ? 1. / sqrt(cs[j]) : 1.;
+			lp->dc[j] *= cs[j];
+			for (p = lp->colptr[j]; p < lp->colptr[j + 1]; p++)
+				lp->values[p] *= rs[lp->rowidx[p]] * cs[j];
+		}
+	}
+	for (i = 0; i < m; i++)
+		lp->q[i] *= lp->dr[i];
+	for (j = 0; j < n; j++) {
+		lp->c[j] *= lp->dc[j];
+		lp->l[j] /= lp->dc[j];  /* infinite bounds stay infinite */
+		lp->u[j] /= lp->dc[j];
+	}
+}
+
+/* Load and scale a general form LP with column compressed coefficients if
+ * `colptr` is given, otherwise with dense `coef` of constraints
+ */
+static int pdhg_load(struct pdhg *lp, const double *objective, const int *colptr, const int *rowidx,
+		     const double *values, const struct impf_LinearConstraint *constraints,
+		     const struct impf_VariableBound *bounds, const int m, const int n,
+		     const int nthreads, int *code)
+{
+	int i, j, p, p0, p1, t, nnz = 0;
+	double a, lb, ub;
+
+	if (nthreads < 1) {
+		*code = impf_CondUnsatisfied;
+		return impf_EXIT_FAILURE;
+	}
+	for (j = 0; j < n; j++) {
+		pdhg_var_bounds(bounds ? bounds + j : NULL, &lb, &ub);
+		if (lb > ub) {
+			*code = impf_Infeasibility;
+			return impf_EXIT_FAILURE;
+		}
+		p0 = colptr ? colptr[j] : 0;
+		p1 = colptr ? colptr[j + 1] : m;
+		for (p = p0; p < p1; p++) {
+			i = colptr ? rowidx[p] : p;
+			nnz += pdhg_coef(constraints, values, p, i, j) != 0.;
+		}
+	}
+	if (pdhg_create(lp, m, n, nnz, nthreads) == impf_EXIT_FAILURE) {
+		*code = impf_MemoryAllocError;
+		return impf_EXIT_FAILURE;
+	}
+	for (i = 0; i < m; i++) {
+		lp->eq[i] = impf_CONS_T_EQ == constraints[i].type;
+		lp->q[i] = impf_CONS_T_LE == constraints[i].type ? -constraints[i].rhs : constraints[i].rhs;
+		lp->bnorm += lp->q[i] * lp->q[i];
+	}
+	for (j = 0, nnz = 0; j < n; j++) {
+		pdhg_var_bounds(bounds ? bounds + j : NULL, lp->l + j, lp->u + j);
+		lp->c[j] = objective[j];
+		lp->cnorm += lp->c[j] * lp->c[j];
+		lp->colptr[j] = nnz;
+		p0 = colptr ? colptr[j] : 0;
+		p1 = colptr ? colptr[j + 1] : m;
+		for (p = p0; p < p1; p++) {
+			i = colptr ? rowidx[p] : p;
+			a = pdhg_coef(constraints, values, p, i, j);
+			if (a == 0.)
+				continue;
+			lp->rowidx[nnz] = i;
+			lp->values[nnz] = impf_CONS_T_LE == constraints[i].type ? -a : a;
+			nnz++;
+		}
+	}
+	lp->colptr[n] = nnz;
+	lp->bnorm = sqrt(lp->bnorm);
+	lp->cnorm = sqrt(lp->cnorm);
+	pdhg_scale(lp);
+
+	impf_memset(lp->rowptr, 0, (m + 1) * sizeof(int));  /* row compressed copy */
+	for (p = 0; p < nnz; p++)
+		lp->rowptr[lp->rowidx[p] + 1]++;
+	for (i = 0; i < m; i++)
+		lp->rowptr[i + 1] += lp->rowptr[i];
+	for (j = 0; j < n; j++) {
+		for (p = lp->colptr[j]; p < lp->colptr[j + 1]; p++) {
+			t = lp->rowptr[lp->rowidx[p]]++;
+			lp->colidx[t] = j;
+			lp->rowval[t] = lp->values[p];
+		}
+	}
+	for (i = m; i > 0; i--)  /* shift back the row starts */
+		lp->rowptr[i] = lp->rowptr[i - 1];
+	lp->rowptr[0] = 0;
+	return impf_EXIT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Steps shared by threads
+ ******************************************************************************/
+
+/* Contiguous block [start, end) of a loop of `len` entries taken by the
+ * calling thread `t`
+ */
+static void pdhg_block(const int len, int *t, int *start, int *end)
+{
+	int nt = 1;
+
+	*t = 0;
+#ifdef _OPENMP
+	nt = omp_get_num_threads();
+	*t = omp_get_thread_num();
+#endif
+	*start = len / nt * *t + __impf_MIN__(*t, len % nt);
+	*end = *start + len / nt + (*t < len % nt);
+}
+
+/* Sum of partial sums `k` of threads
+ */
+static double pdhg_part_sum(const struct pdhg *lp, const int k)
+{
+	int t;
+	double s = 0.;
+
+	for (t = 0; t < lp->nthreads; t++)
+		s += lp->part[k + t * PDHG_NPART];
+	return s;
+}
+
+/* Primal step `xn = proj(x - tau (c - K'y))`
+ * Return `||xn - x||^2`
+ */
+static double pdhg_primal(struct pdhg *lp, const double tau)
+{
+	int n = lp->n;
+
+	impf_memset(lp->part, 0, PDHG_NPART * lp->nthreads * sizeof(double));
+#ifdef _OPENMP
+#pragma omp parallel num_threads(lp->nthreads) if (pdhg_parallel(lp, n))
+#endif
+	{
+		int j, t, start, end;
+		double v, d, s = 0.;
+
+		pdhg_block(n, &t, &start, &end);
+		for (j = start; j < end; j++) {
+			v = lp->x[j] - tau * (lp->c[j] - lp->kty[j]);
+			v = __impf_MIN__(__impf_MAX__(v, lp->l[j]), lp->u[j]);
+			d = v - lp->x[j];
+			lp->xn[j] = v;
+			s += d * d;
+		}
+		lp->part[t * PDHG_NPART] = s;
+	}
+	return pdhg_part_sum(lp, 0);
+}
+
+/* Dual step `yn = proj(y + sigma (q - K (2 xn - x)))` with `K xn`
+ * Return `||yn - y||^2` and `(yn - y)' K (xn - x)` by `inter`
+ */
+static double pdhg_dual(struct pdhg *lp, const double sigma, double *inter)
+{
+	int m = lp->m;
+
+	impf_memset(lp->part, 0, PDHG_NPART * lp->nthreads * sizeof(double));
+#ifdef _OPENMP
+#pragma omp parallel num_threads(lp->nthreads) if (pdhg_parallel(lp, lp->rowptr[m]))
+#endif
+	{
+		int i, p, t, start, end;
+		double kx, v, d, s = 0., w = 0.;
+
+		pdhg_block(m, &t, &start, &end);
+		for (i = start; i < end; i++) {
+			for (p = lp->rowptr[i], kx = 0.; p < lp->rowptr[i + 1]; p++)
+				kx += lp->rowval[p] * lp->xn[lp->colidx[p]];
+			lp->kxn[i] = kx;
+			v = lp->y[i] + sigma * (lp->q[i] - 2. * kx + lp->kx[i]);
+			if (!lp->eq[i] && v < 0.)
+				v = 0.;
+			d = v - lp->y[i];
+			lp->yn[i] = v;
+			s += d * d;
+			w += d * (kx - lp->kx[i]);
+		}
+		lp->part[t * PDHG_NPART] = s;
+		lp->part[t * PDHG_NPART + 1] = w;
+	}
+	*inter = pdhg_part_sum(lp, 1);
+	return pdhg_part_sum(lp, 0);
+}
+
+/* Accept the trial iterate of step `eta`: `K'yn`, and the weighted sums
+ */
+static void pdhg_accept(struct pdhg *lp, const double eta)
+{
+	int m = lp->m, n = lp->n;
+	double *tmp;
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(lp->nthreads) if (pdhg_parallel(lp, lp->colptr[n]))
+#endif
+	{
+		int i, j, p, t, start, end;
+		double kty;
+
+		pdhg_block(n, &t, &start, &end);
+		for (j = start; j < end; j++) {
+			for (p = lp->colptr[j], kty = 0.; p < lp->colptr[j + 1]; p++)
+				kty += lp->values[p] * lp->yn[lp->rowidx[p]];
+			lp->ktyn[j] = kty;
+			lp->xa[j] += eta * lp->xn[j];
+			lp->ktya[j] += eta * kty;
+		}
+		pdhg_block(m, &t, &start, &end);
+		for (i = start; i < end; i++) {
+			lp->ya[i] += eta * lp->yn[i];
+			lp->kxa[i] += eta * lp->kxn[i];
+		}
+	}
+	tmp = lp->x, lp->x = lp->xn, lp->xn = tmp;
+	tmp = lp->kx, lp->kx = lp->kxn, lp->kxn = tmp;
+	tmp = lp->y, lp->y = lp->yn, lp->yn = tmp;
+	tmp = lp->kty, lp->kty = lp->ktyn, lp->ktyn = tmp;
+}
+
+/*******************************************************************************
+ * Restarts, termination and infeasibility
+ ******************************************************************************/
+
+/* Errors of `(x, y)` with `kx = K x` and `kty = K'y`
+ *
+ *	err[0], err[1]	norms of primal and dual residuals of the original LP
+ *	err[2], err[3]	primal and dual objectives
+ *	err[4], err[5]	norms of primal and dual residuals of the scaled LP
+ */
+static void pdhg_errors(const struct pdhg *lp, const double *x, const double *kx, const double *y,
+			const double *kty, double *err)
+{
+	int i, j;
+	double r, z;
+
+	impf_memset(err, 0, 6 * sizeof(double));
+	for (i = 0; i < lp->m; i++) {
+		r = lp->q[i] - kx[i];
+		if (!lp->eq[i] && r < 0.)
+			r = 0.;
+		err[0] += r * r / (lp->dr[i] * lp->dr[i]);
+		err[3] += lp->q[i] * y[i];
+		err[4] += r * r;
+	}
+	for (j = 0; j < lp->n; j++) {
+		z = lp->c[j] - kty[j];
+		err[2] += lp->c[j] * x[j];
+		if (z > 0. && lp->l[j] > __impf_NINF__)
+			err[3] += lp->l[j] * z;
+		else if (z < 0. && lp->u[j] < __impf_INF__)
+			err[3] += lp->u[j] * z;
+		else {
+			err[1] += z * z / (lp->dc[j] * lp->dc[j]);
+			err[5] += z * z;
+		}
+	}
+	err[0] = sqrt(err[0]);
+	err[1] = sqrt(err[1]);
+	err[4] = sqrt(err[4]);
+	err[5] = sqrt(err[5]);
+}
+
+/* Whether the errors are within the relative tolerance `tol`
+ */
+static int pdhg_optimal(const struct pdhg *lp, const double *err, const double tol)
+{
+	return err[0] <= tol * (1. + lp->bnorm) && err[1] <= tol * (1. + lp->cnorm)
+	       && __impf_ABS__(err[2] - err[3]) <= tol * (1. + __impf_ABS__(err[2]) + __impf_ABS__(err[3]));
+}
+
+/* KKT error of the scaled LP in the norm of primal weight `omega`, which
+ * decides the restarts
+ */
+static double pdhg_kkt(const double *err, const double omega)
+{
+	double gap = err[2] - err[3];
+
+	return sqrt(omega * err[4] * err[4] + err[5] * err[5] / omega + gap * gap);
+}
+
+/* Whether the difference `(dx, dy)` of iterates (with `K dx` and `K'dy`)
+ * certifies infeasibility (`impf_Infeasibility`) or unboundedness
+ * (`impf_Unboundedness`) of the LP, where a primal ray means unboundedness
+ * only if the LP is feasible
+ * Return the code, or `impf_Success` if there is no certificate
+ *
+ * Note: a dual ray has `b'dy` beyond the support of `A'dy` on the bounds, a
+ *	primal ray keeps the constraints and decreases `c'x`, both up to
+ *	relative residuals of `__impf_CTR_PDHG_RAY__`, and with objectives
+ *	not lost in the cancellation of their terms. The residuals are known
+ *	only up to the rounding of the current iterate, so a fraction
+ *	`__impf_CTR_PDHG_RAY_ROUND__` of its norm is added to them.
+ */
+static int pdhg_ray(const struct pdhg *lp, const double *dx, const double *kdx, const double *dy,
+		    const double *kdy)
+{
+	int i, j;
+	double obj = 0., mag = 0., res = 0., size = 0., r;
+
+	for (i = 0; i < lp->m; i++) {  /* dual ray */
+		obj += lp->q[i] * dy[i];
+		mag += __impf_ABS__(lp->q[i] * dy[i]);
+		r = !lp->eq[i] && dy[i] < 0. ? dy[i] * lp->dr[i] : 0.;
+		res += r * r;
+		size += lp->y[i] * lp->y[i] * lp->dr[i] * lp->dr[i];
+	}
+	for (j = 0; j < lp->n; j++) {
+		size += lp->kty[j] * lp->kty[j] / (lp->dc[j] * lp->dc[j]);
+		if (kdy[j] > 0. && lp->u[j] < __impf_INF__)
+			r = lp->u[j] * kdy[j];
+		else if (kdy[j] < 0. && lp->l[j] > __impf_NINF__)
+			r = lp->l[j] * kdy[j];
+		else {
+			r = 0.;
+			res += kdy[j] * kdy[j] / (lp->dc[j] * lp->dc[j]);
+		}
+		obj -= r;
+		mag += __impf_ABS__(r);
+	}
+	if (obj > __impf_CTR_PDHG_RAY__ * mag
+	    && sqrt(res) + __impf_CTR_PDHG_RAY_ROUND__ * sqrt(size) <= __impf_CTR_PDHG_RAY__ * obj)
+		return impf_Infeasibility;
+
+	for (i = 0, obj = 0., mag = 0., res = 0., size = 0.; i < lp->m; i++) {  /* primal ray */
+		r = lp->eq[i] || kdx[i] < 0. ? kdx[i] / lp->dr[i] : 0.;
+		res += r * r;
+		size += lp->kx[i] * lp->kx[i] / (lp->dr[i] * lp->dr[i]);
+	}
+	for (j = 0; j < lp->n; j++) {
+		size += lp->x[j] * lp->x[j] * lp->dc[j] * lp->dc[j];
+		obj += lp->c[j] * dx[j];
+		mag += __impf_ABS__(lp->c[j] * dx[j]);
+		if ((dx[j] < 0. && lp->l[j] > __impf_NINF__) || (dx[j] > 0. && lp->u[j] < __impf_INF__))
+			res += dx[j] * dx[j] * lp->dc[j] * lp->dc[j];
+	}
+	if (-obj > __impf_CTR_PDHG_RAY__ * mag
+	    && sqrt(res) + __impf_CTR_PDHG_RAY_ROUND__ * sqrt(size) <= -__impf_CTR_PDHG_RAY__ * obj)
+		return impf_Unboundedness;
+	return impf_Success;
+}
+
+/* Squared distance between vectors
+ */
+static double pdhg_dist2(const double *a, const double *b, const int len)
+{
+	int k;
+	double d, s = 0.;
+
+	for (k = 0; k < len; k++) {
+		d = a[k] - b[k];
+		s += d * d;
+	}
+	return s;
+}
+
+/* Copy the iterate `(x, kx, y, kty)` into the current one
+ */
+static void pdhg_set(struct pdhg *lp, const double *x, const double *kx, const double *y, const double *kty)
+{
+	impf_memcpy(lp->x, x, lp->n * sizeof(double));
+	impf_memcpy(lp->kty, kty, lp->n * sizeof(double));
+	impf_memcpy(lp->kx, kx, lp->m * sizeof(double));
+	impf_memcpy(lp->y, y, lp->m * sizeof(double));
+}
+
+/* Start again from the current iterate, update the primal weight by the
+ * move since the last restart. The weight stays within a range around the
+ * initial `omega0`, since on an infeasible LP only one of the moves grows
+ * and the weight would otherwise drift without bound
+ */
+static void pdhg_restart(struct pdhg *lp, const double omega0, double *omega)
+{
+	double dx = sqrt(pdhg_dist2(lp->x, lp->xr, lp->n));
+	double dy = sqrt(pdhg_dist2(lp->y, lp->yr, lp->m));
+	double theta = __impf_CTR_PDHG_WEIGHT_SMOOTH__, range = __impf_CTR_PDHG_WEIGHT_RANGE__;
+
+	if (dx > __impf_CTR_PDHG_WEIGHT_ZERO__ && dy > __impf_CTR_PDHG_WEIGHT_ZERO__)
+		*omega = exp(theta * log(dy / dx) + (1. - theta) * log(*omega));
+	*omega = __impf_MIN__(__impf_MAX__(*omega, omega0 / range), omega0 * range);
+	impf_memcpy(lp->xr, lp->x, lp->n * sizeof(double));
+	impf_memcpy(lp->ktyr, lp->kty, lp->n * sizeof(double));
+	impf_memcpy(lp->yr, lp->y, lp->m * sizeof(double));
+	impf_memcpy(lp->kxr, lp->kx, lp->m * sizeof(double));
+	impf_memset(lp->xa, 0, lp->n * sizeof(double));
+	impf_memset(lp->ktya, 0, lp->n * sizeof(double));
+	impf_memset(lp->ya, 0, lp->m * sizeof(double));
+	impf_memset(lp->kxa, 0, lp->m * sizeof(double));
+}
+
+/* Initial iterate: `x` is the projection of 0 on the bounds, `y = 0`
+ */
+static void pdhg_start(struct pdhg *lp)
+{
+	int j, p;
+
+	for (j = 0; j < lp->n; j++)
+		lp->x[j] = __impf_MIN__(__impf_MAX__(0., lp->l[j]), lp->u[j]);
+	impf_memset(lp->kx, 0, lp->m * sizeof(double));
+	for (j = 0; j < lp->n; j++) {
+		if (lp->x[j] == 0.)
+			continue;
+		for (p = lp->colptr[j]; p < lp->colptr[j + 1]; p++)
+			lp->kx[lp->rowidx[p]] += lp->values[p] * lp->x[j];
+	}
+	impf_memset(lp->y, 0, lp->m * sizeof(double));
+	impf_memset(lp->kty, 0, lp->n * sizeof(double));
+}
+
+/*******************************************************************************
+ * Restarted primal-dual hybrid gradient iterations
+ ******************************************************************************/
+
+/* Iterate with adaptive steps and restarts (see Applegate et al. 2021,
+ * "Practical large-scale linear programming using primal-dual hybrid
+ * gradient"), stopping at a solution within the relative tolerance `tol`
+ * in the current iterate
+ */
+static int pdhg_iterate(struct pdhg *lp, const int niter, const double tol, int *code)
+{
+	int i, j, p, k = 0, t = 0, kr = 0, nrestart = 0, m = lp->m, n = lp->n, stop, ray = 0;
+	double eta = 0., eta0, omega = 1., omega0, wsum = 0., eta_max, eta_new, dx2, dy2, inter;
+	double err[6], erra[6], kkt, kkta, kkt_r, kkt_p = __impf_INF__, qnorm = 0., cnorm = 0.;
+
+	for (j = 0; j < n; j++) {
+		for (p = lp->colptr[j]; p < lp->colptr[j + 1]; p++)
+			eta = __impf_MAX__(eta, __impf_ABS__(lp->values[p]));
+		cnorm += lp->c[j] * lp->c[j];
+	}
+	for (i = 0; i < m; i++)
+		qnorm += lp->q[i] * lp->q[i];
+	eta = eta > 0. ? 1. / eta : 1.;
+	eta0 = eta;
+	if (cnorm > __impf_CTR_PDHG_WEIGHT_ZERO__ && qnorm > __impf_CTR_PDHG_WEIGHT_ZERO__)
+		omega = sqrt(cnorm / qnorm);
+	omega0 = omega;
+	pdhg_start(lp);
+	pdhg_restart(lp, omega0, &omega);
+	pdhg_errors(lp, lp->x, lp->kx, lp->y, lp->kty, err);
+	kkt_r = pdhg_kkt(err, omega);
+
+	while (1) {
+		if (k % __impf_CTR_PDHG_EVAL__ == 0 || k >= niter) {
+			pdhg_errors(lp, lp->x, lp->kx, lp->y, lp->kty, err);
+			if (pdhg_optimal(lp, err, tol))
+				break;
+			if (wsum > 0.) {  /* the average */
+				for (j = 0; j < n; j++) {
+					lp->xn[j] = lp->xa[j] / wsum;
+					lp->ktyn[j] = lp->ktya[j] / wsum;
+				}
+				for (i = 0; i < m; i++) {
+					lp->yn[i] = lp->ya[i] / wsum;
+					lp->kxn[i] = lp->kxa[i] / wsum;
+				}
+				pdhg_errors(lp, lp->xn, lp->kxn, lp->yn, lp->ktyn, erra);
+				if (pdhg_optimal(lp, erra, tol)) {
+					pdhg_set(lp, lp->xn, lp->kxn, lp->yn, lp->ktyn);
+					break;
+				}
+			}
+			if (k >= niter) {
+				*code = impf_ExceedIterLimit;
+				return impf_EXIT_FAILURE;
+			}
+			if (k > 0) {  /* differences since the last evaluation */
+				for (j = 0; j < n; j++) {
+					lp->xp[j] = lp->x[j] - lp->xp[j];
+					lp->ktyp[j] = lp->kty[j] - lp->ktyp[j];
+				}
+				for (i = 0; i < m; i++) {
+					lp->yp[i] = lp->y[i] - lp->yp[i];
+					lp->kxp[i] = lp->kx[i] - lp->kxp[i];
+				}
+				stop = pdhg_ray(lp, lp->xp, lp->kxp, lp->yp, lp->ktyp);
+				if (stop == impf_Success && wsum > 0.) {  /* average since restart */
+					for (j = 0; j < n; j++) {
+						lp->xp[j] = lp->xn[j] - lp->xr[j];
+						lp->ktyp[j] = lp->ktyn[j] - lp->ktyr[j];
+					}
+					for (i = 0; i < m; i++) {
+						lp->yp[i] = lp->yn[i] - lp->yr[i];
+						lp->kxp[i] = lp->kxn[i] - lp->kxr[i];
+					}
+					stop = pdhg_ray(lp, lp->xp, lp->kxp, lp->yp, lp->ktyp);
+				}
+				if (stop == impf_Success)  /* the iterate, grown along a ray */
+					stop = pdhg_ray(lp, lp->x, lp->kx, lp->y, lp->kty);
+				if (stop == impf_Unboundedness && err[0] > tol * (1. + lp->bnorm)) {
+					/* a primal ray before a feasible iterate, drop the
+					 * objective to find either a feasible point or a
+					 * dual ray, starting again since the iterates
+					 * and the step may have grown large along the ray
+					 */
+					impf_memset(lp->c, 0, n * sizeof(double));
+					eta = eta0;
+					t = 0;
+					pdhg_start(lp);
+					pdhg_restart(lp, omega0, &omega);
+					omega = omega0;
+					pdhg_errors(lp, lp->x, lp->kx, lp->y, lp->kty, err);
+					kkt_r = pdhg_kkt(err, omega);
+					kkt_p = __impf_INF__;
+					wsum = 0.;
+					kr = k;
+					ray = 1;
+					stop = impf_Success;
+				}
+				if (stop != impf_Success) {
+					*code = stop;
+					return impf_EXIT_FAILURE;
+				}
+			}
+			if (wsum > 0.) {  /* restart to the better of current and average */
+				kkt = pdhg_kkt(err, omega);
+				kkta = pdhg_kkt(erra, omega);
+				if (kkta < kkt)
+					kkt = kkta;
+				if (kkt <= __impf_CTR_PDHG_RESTART_SUFFICIENT__ * kkt_r
+				    || (kkt <= __impf_CTR_PDHG_RESTART_NECESSARY__ * kkt_r && kkt > kkt_p)
+				    || k - kr >= __impf_CTR_PDHG_RESTART_ARTIFICIAL__ * k) {
+					if (kkta <= kkt)
+						pdhg_set(lp, lp->xn, lp->kxn, lp->yn, lp->ktyn);
+					pdhg_restart(lp, omega0, &omega);
+					pdhg_errors(lp, lp->x, lp->kx, lp->y, lp->kty, err);
+					kkt_r = pdhg_kkt(err, omega);
+					kkt_p = __impf_INF__;
+					wsum = 0.;
+					kr = k;
+					nrestart++;
+				} else
+					kkt_p = kkt;
+			}
+			impf_memcpy(lp->xp, lp->x, n * sizeof(double));
+			impf_memcpy(lp->ktyp, lp->kty, n * sizeof(double));
+			impf_memcpy(lp->kxp, lp->kx, m * sizeof(double));
+			impf_memcpy(lp->yp, lp->y, m * sizeof(double));
+		}
+		while (1) {  /* adaptive step */
+			dx2 = pdhg_primal(lp, eta / omega);
+			dy2 = pdhg_dual(lp, eta * omega, &inter);
+			t++;
+			if (!(dx2 + dy2 < __impf_INF__)) {  /* overflow */
+				*code = impf_PrecisionError;
+				return impf_EXIT_FAILURE;
+			}
+			inter = __impf_ABS__(inter);
+			eta_max = inter > 0. ? (omega * dx2 + dy2 / omega) / (2. * inter) : __impf_INF__;
+			eta_new = __impf_MIN__((1. - pow(t + 1., -.3)) * eta_max, (1. + pow(t + 1., -.6)) * eta);
+			if (inter == 0.)  /* no bound on the step is seen, keep it */
+				eta_new = eta;
+			if (eta <= eta_max)
+				break;
+			eta = eta_new;
+		}
+		pdhg_accept(lp, eta);
+		wsum += eta;
+		eta = eta_new;
+		k++;
+	}
+#ifdef IMPF_MODE_DEV
+	impf_prt_dev(">>> PDHG done, niter = %i, nrestart = %i\n", k, nrestart);
+#endif
+	if (ray) {
+		*code = impf_Unboundedness;
+		return impf_EXIT_FAILURE;
+	}
+	return impf_EXIT_SUCCESS;
+}
+
+static int pdhg_solve(struct pdhg *lp, const double *objective, const int niter, const double tol,
+		      double *x, double *value, int *code)
+{
+	int j;
+
+	if (tol <= 0.) {
+		*code = impf_CondUnsatisfied;
+		return impf_EXIT_FAILURE;
+	}
+	*code = impf_Success;
+	if (pdhg_iterate(lp, niter, tol, code) == impf_EXIT_FAILURE && impf_ExceedIterLimit != *code)
+		return impf_EXIT_FAILURE;
+	*value = 0.;
+	for (j = 0; j < lp->n; j++) {
+		x[j] = lp->x[j] * lp->dc[j];
+		*value += objective[j] * x[j];
+	}
+	return impf_Success == *code ? impf_EXIT_SUCCESS : impf_EXIT_FAILURE;
+}
+
+int impf_lp_pdhg(const double *objective, const struct impf_LinearConstraint *constraints,
+		 const struct impf_VariableBound *bounds, const int m, const int n, const int niter,
+		 const double tol, const int nthreads, double *x, double *value, int *code)
+{
+	struct pdhg lp;
+	int state;
+
+	assert(objective != NULL);
+	assert(constraints != NULL);
+	assert(x != NULL);
+	assert(value != NULL);
+	assert(code != NULL);
+
+	if (pdhg_load(&lp, objective, NULL, NULL, NULL, constraints, bounds, m, n, nthreads, code) == impf_EXIT_FAILURE)
+		return impf_EXIT_FAILURE;
+	state = pdhg_solve(&lp, objective, niter, tol, x, value, code);
+	pdhg_free(&lp);
+	return state;
+}
+
+int impf_lp_pdhg_csc(const double *objective, const int *colptr, const int *rowidx, const double *values,
+		     const struct impf_LinearConstraint *constraints,
+		     const struct impf_VariableBound *bounds, const int m, const int n, const int niter,
+		     const double tol, const int nthreads, double *x, double *value, int *code)
+{
+	struct pdhg lp;
+	int state;
+
+	assert(objective != NULL);
+	assert(colptr != NULL);
+	assert(rowidx != NULL);
+	assert(values != NULL);
+	assert(constraints != NULL);
+	assert(x != NULL);
+	assert(value != NULL);
+	assert(code != NULL);
+
+	if (pdhg_load(&lp, objective, colptr, rowidx, values, constraints, bounds, m, n, nthreads, code)
+	    == impf_EXIT_FAILURE)
+		return impf_EXIT_FAILURE;
+	state = pdhg_solve(&lp, objective, niter, tol, x, value, code);
+	pdhg_free(&lp);
+	return state;
+}
+
+int impf_lp_pdhg_wrp(const struct impf_Model_LP *model, const int niter, const double tol,
+		     const int nthreads, double *x, double *value, int *code)
+{
+	assert(model != NULL);
+	return impf_lp_pdhg_csc(model->objective, model->colptr, model->rowidx, model->values,
+				model->constraints, model->bounds, model->m, model->n, niter, tol,
+				nthreads, x, value, code);
+}
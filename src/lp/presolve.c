@@ -0,0 +1,758 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <impf/_magics.h>
+#include <impf/fmin_lp.h>
+
+/* Eliminations recorded for postsolve */
+#define PRESOLVE_FIX		0	/* x_j = b */
+#define PRESOLVE_DOUBLETON	1	/* x_k = (b - a_j x_j) / a_k */
+
+struct impf_LP_PresolveOp {
+	int type;
+	int j;
+	int k;
+	double a_j;
+	double a_k;
+	double b;
+};
+
+/* Working LP of presolve, rows and columns are removed by flags
+ *
+ *	a		coefficients, row major (m x n)
+ *	cost		coefficients of objective
+ *	lb, ub		bounds of variables, including those implied by rows
+ *	lbx, ubx	explicit bounds of variables, never derived from rows kept
+ *			in the LP, so that rows could be checked against them
+ *	rlo, rup	bounds of row activities
+ *	rowact, colact	whether a row (column) is kept
+ *	offset		constant of objective from the eliminated variables
+ */
+struct presolve_lp {
+	int m;
+	int n;
+	double *a;
+	double *cost;
+	double *lb;
+	double *ub;
+	double *lbx;
+	double *ubx;
+	double *rlo;
+	double *rup;
+	int *rowact;
+	int *colact;
+	double offset;
+	struct impf_LP_PresolveOp *ops;
+	int nops;
+	int capops;
+};
+
+static double presolve_tol(const double v)
+{
+	return __impf_CTR_PRESOLVE_FEAS__ * (1. + __impf_ABS__(v));
+}
+
+static int presolve_create(struct presolve_lp *lp, const double *objective,
+			   const struct impf_LinearConstraint *constraints,
+			   const struct impf_VariableBound *bounds, const int m, const int n)
+{
+	int i, j;
+
+	lp->m = m;
+	lp->n = n;
+	lp->offset = 0.;
+	lp->nops = 0;
+	lp->capops = 0;
+	lp->ops = NULL;
+	lp->rowact = NULL;
+	lp->a = impf_malloc((m * n + 6 * n + 2 * m + 1) * sizeof(double));
+	if (lp->a == NULL)
+		return impf_EXIT_FAILURE;
+	lp->rowact = impf_malloc((m + n + 1) * sizeof(int));
+	if (lp->rowact == NULL) {
+		impf_free(lp->a);
+		return impf_EXIT_FAILURE;
+	}
+	lp->cost = lp->a + m * n;
+	lp->lb = lp->cost + n;
+	lp->ub = lp->lb + n;
+	lp->lbx = lp->ub + n;
+	lp->ubx = lp->lbx + n;
+	lp->rlo = lp->ubx + n;
+	lp->rup = lp->rlo + m;
+	lp->colact = lp->rowact + m;
+
+	for (i = 0; i < m; i++) {
+		impf_memcpy(lp->a + i * n, constraints[i].coef, n * sizeof(double));
+		lp->rlo[i] = constraints[i].type == impf_CONS_T_LE ? __impf_NINF__ : constraints[i].rhs;
+		lp->rup[i] = constraints[i].type == impf_CONS_T_GE ? __impf_INF__ : constraints[i].rhs;
+		lp->rowact[i] = 1;
+	}
+	for (j = 0; j < n; j++) {
+		lp->cost[j] = objective[j];
+		lp->lb[j] = 0.;
+		lp->ub[j] = __impf_INF__;
+		if (bounds != NULL) {
+			switch (bounds[j].b_type) {
+			case impf_BOUND_T_FR:
+				lp->lb[j] = __impf_NINF__;
+				break;
+			case impf_BOUND_T_UP:
+				lp->ub[j] = bounds[j].ub;
+				break;
+			case impf_BOUND_T_BS:
+				lp->lb[j] = bounds[j].lb;
+				lp->ub[j] = bounds[j].ub;
+				break;
+			default:
+				lp->lb[j] = bounds[j].lb;
+				break;
+			}
+		}
+		lp->lbx[j] = lp->lb[j];
+		lp->ubx[j] = lp->ub[j];
+		lp->colact[j] = 1;
+	}
+	return impf_EXIT_SUCCESS;
+}
+
+static void presolve_free(struct presolve_lp *lp)
+{
+	impf_free(lp->a);
+	impf_free(lp->rowact);
+	if (lp->ops)
+		impf_free(lp->ops);
+}
+
+static int presolve_push(struct presolve_lp *lp, const int type, const int j, const int k,
+			 const double a_j, const double a_k, const double b)
+{
+	struct impf_LP_PresolveOp *op;
+
+	if (lp->nops == lp->capops) {
+		int cap = lp->capops ? 2 * lp->capops : 64;
+
+		op = impf_realloc(lp->ops, cap * sizeof(struct impf_LP_PresolveOp));
+		if (op == NULL)
+			return impf_EXIT_FAILURE;
+		lp->ops = op;
+		lp->capops = cap;
+	}
+	op = lp->ops + lp->nops++;
+	op->type = type;
+	op->j = j;
+	op->k = k;
+	op->a_j = a_j;
+	op->a_k = a_k;
+	op->b = b;
+	return impf_EXIT_SUCCESS;
+}
+
+/* Fix variable `j` at `v` and remove it
+ */
+static int presolve_fix(struct presolve_lp *lp, const int j, const double v)
+{
+	int i;
+	double a_ij;
+
+	if (presolve_push(lp, PRESOLVE_FIX, j, j, 0., 0., v) == impf_EXIT_FAILURE)
+		return impf_EXIT_FAILURE;
+	for (i = 0; i < lp->m; i++) {
+		a_ij = lp->a[j + i * lp->n];
+		if (!lp->rowact[i] || a_ij == 0.)
+			continue;
+		lp->rlo[i] -= a_ij * v;
+		lp->rup[i] -= a_ij * v;
+	}
+	lp->offset += lp->cost[j] * v;
+	lp->colact[j] = 0;
+	return impf_EXIT_SUCCESS;
+}
+
+/* Intersect bounds of variable `j` with `[lo, up]`, also the explicit ones if
+ * `both`
+ * Return `impf_EXIT_FAILURE` if the bounds become inconsistent
+ */
+static int presolve_bound(struct presolve_lp *lp, const int j, const double lo, const double up,
+			  const int both)
+{
+	if (lo > lp->lb[j])
+		lp->lb[j] = lo;
+	if (up < lp->ub[j])
+		lp->ub[j] = up;
+	if (both) {
+		if (lo > lp->lbx[j])
+			lp->lbx[j] = lo;
+		if (up < lp->ubx[j])
+			lp->ubx[j] = up;
+		if (lp->lbx[j] > lp->ubx[j]) {
+			if (lp->lbx[j] > lp->ubx[j] + presolve_tol(lp->ubx[j]))
+				return impf_EXIT_FAILURE;
+			lp->lbx[j] = lp->ubx[j];
+		}
+	}
+	if (lp->lb[j] > lp->ub[j]) {
+		if (lp->lb[j] > lp->ub[j] + presolve_tol(lp->ub[j]))
+			return impf_EXIT_FAILURE;
+		lp->lb[j] = lp->ub[j];
+	}
+	return impf_EXIT_SUCCESS;
+}
+
+/* Number of nonzeros of row `i` over kept columns, the first two of which
+ * are returned in `j` and `k`
+ */
+static int presolve_row_nnz(const struct presolve_lp *lp, const int i, int *j, int *k)
+{
+	int l, nnz = 0;
+	const double *a_i = lp->a + i * lp->n;
+
+	*j = -1;
+	*k = -1;
+	for (l = 0; l < lp->n; l++) {
+		if (!lp->colact[l] || __impf_ABS__(a_i[l]) <= __impf_CTR_PRESOLVE_ZERO__)
+			continue;
+		if (nnz == 0)
+			*j = l;
+		else if (nnz == 1)
+			*k = l;
+		nnz++;
+	}
+	return nnz;
+}
+
+/* Range of activity of row `i` given bounds `lb`, `ub`: the finite parts of
+ * the smallest and the largest activities, and the numbers of infinite terms
+ */
+static void presolve_activity(const struct presolve_lp *lp, const int i, const double *lb, const double *ub,
+			      double *minact, double *maxact, int *nminf, int *nmaxinf)
+{
+	int j;
+	double a_ij;
+
+	*minact = 0.;
+	*maxact = 0.;
+	*nminf = 0;
+	*nmaxinf = 0;
+	for (j = 0; j < lp->n; j++) {
+		a_ij = lp->a[j + i * lp->n];
+		if (!lp->colact[j] || a_ij == 0.)
+			continue;
+		if (a_ij > 0.) {
+			if (lb[j] > __impf_NINF__)
+				*minact += a_ij * lb[j];
+			else
+				(*nminf)++;
+			if (ub[j] < __impf_INF__)
+				*maxact += a_ij * ub[j];
+			else
+				(*nmaxinf)++;
+		} else {
+			if (ub[j] < __impf_INF__)
+				*minact += a_ij * ub[j];
+			else
+				(*nminf)++;
+			if (lb[j] > __impf_NINF__)
+				*maxact += a_ij * lb[j];
+			else
+				(*nmaxinf)++;
+		}
+	}
+}
+
+/* Fix variables of a forcing row at the bounds giving the smallest (`upper`
+ * = 0) or the largest (`upper` = 1) activity
+ */
+static int presolve_forcing(struct presolve_lp *lp, const int i, const int upper)
+{
+	int j;
+	double a_ij;
+
+	for (j = 0; j < lp->n; j++) {
+		a_ij = lp->a[j + i * lp->n];
+		if (!lp->colact[j] || a_ij == 0.)
+			continue;
+		if ((a_ij > 0.) == (upper != 0)) {
+			if (presolve_fix(lp, j, lp->ubx[j]) == impf_EXIT_FAILURE)
+				return impf_EXIT_FAILURE;
+		} else {
+			if (presolve_fix(lp, j, lp->lbx[j]) == impf_EXIT_FAILURE)
+				return impf_EXIT_FAILURE;
+		}
+	}
+	return impf_EXIT_SUCCESS;
+}
+
+/* Remove empty rows, singleton rows (as bounds of the variable), forcing rows
+ * and redundant rows checked against the explicit bounds
+ */
+static int presolve_rows(struct presolve_lp *lp, int *changed, int *code)
+{
+	int i, j, k, nnz, nminf, nmaxinf;
+	double a_ij, lo, up, minact, maxact;
+
+	for (i = 0; i < lp->m; i++) {
+		if (!lp->rowact[i])
+			continue;
+		nnz = presolve_row_nnz(lp, i, &j, &k);
+		if (nnz == 0) {
+			if (lp->rlo[i] > presolve_tol(lp->rlo[i]) || lp->rup[i] < -presolve_tol(lp->rup[i])) {
+				*code = impf_Infeasibility;
+				return impf_EXIT_FAILURE;
+			}
+			lp->rowact[i] = 0;
+			*changed = 1;
+			continue;
+		}
+		if (nnz == 1) {
+			a_ij = lp->a[j + i * lp->n];
+			lo = (a_ij > 0. ? lp->rlo[i] : lp->rup[i]) / a_ij;
+			up = (a_ij > 0. ? lp->rup[i] : lp->rlo[i]) / a_ij;
+			if (presolve_bound(lp, j, lo, up, 1) == impf_EXIT_FAILURE) {
+				*code = impf_Infeasibility;
+				return impf_EXIT_FAILURE;
+			}
+			lp->rowact[i] = 0;
+			*changed = 1;
+			continue;
+		}
+		presolve_activity(lp, i, lp->lbx, lp->ubx, &minact, &maxact, &nminf, &nmaxinf);
+		if ((nminf == 0 && minact > lp->rup[i] + presolve_tol(lp->rup[i]))
+		    || (nmaxinf == 0 && maxact < lp->rlo[i] - presolve_tol(lp->rlo[i]))) {
+			*code = impf_Infeasibility;
+			return impf_EXIT_FAILURE;
+		}
+		if (nminf == 0 && lp->rup[i] < __impf_INF__ && minact >= lp->rup[i] - presolve_tol(lp->rup[i])) {
+			if (presolve_forcing(lp, i, 0) == impf_EXIT_FAILURE) {
+				*code = impf_MemoryAllocError;
+				return impf_EXIT_FAILURE;
+			}
+			lp->rowact[i] = 0;
+			*changed = 1;
+			continue;
+		}
+		if (nmaxinf == 0 && lp->rlo[i] > __impf_NINF__ && maxact <= lp->rlo[i] + presolve_tol(lp->rlo[i])) {
+			if (presolve_forcing(lp, i, 1) == impf_EXIT_FAILURE) {
+				*code = impf_MemoryAllocError;
+				return impf_EXIT_FAILURE;
+			}
+			lp->rowact[i] = 0;
+			*changed = 1;
+			continue;
+		}
+		if (nmaxinf == 0 && lp->rup[i] < __impf_INF__ && maxact <= lp->rup[i] + presolve_tol(lp->rup[i])) {
+			lp->rup[i] = __impf_INF__;
+			*changed = 1;
+		}
+		if (nminf == 0 && lp->rlo[i] > __impf_NINF__ && minact >= lp->rlo[i] - presolve_tol(lp->rlo[i])) {
+			lp->rlo[i] = __impf_NINF__;
+			*changed = 1;
+		}
+		if (lp->rlo[i] == __impf_NINF__ && lp->rup[i] == __impf_INF__)
+			lp->rowact[i] = 0;
+	}
+	return impf_EXIT_SUCCESS;
+}
+
+/* Eliminate one variable of each equation with two nonzeros, i.e. substitute
+ * `x_k = (b - a_j x_j) / a_k` where `|a_k| >= |a_j|`, the bounds of `x_k`
+ * become bounds of `x_j`
+ */
+static int presolve_doubletons(struct presolve_lp *lp, int *changed, int *code)
+{
+	int i, r, j, k, l;
+	double a_j, a_k, b, a_rk, lo, up, lox, upx, tmp;
+
+	for (i = 0; i < lp->m; i++) {
+		if (!lp->rowact[i] || lp->rlo[i] != lp->rup[i] || presolve_row_nnz(lp, i, &j, &k) != 2)
+			continue;
+		if (__impf_ABS__(lp->a[j + i * lp->n]) > __impf_ABS__(lp->a[k + i * lp->n])) {
+			l = j;
+			j = k;
+			k = l;
+		}
+		a_j = lp->a[j + i * lp->n];
+		a_k = lp->a[k + i * lp->n];
+		b = lp->rup[i];
+		/* a_j x_j = b - a_k x_k */
+		lo = b - a_k * (a_k > 0. ? lp->ub[k] : lp->lb[k]);
+		up = b - a_k * (a_k > 0. ? lp->lb[k] : lp->ub[k]);
+		lox = b - a_k * (a_k > 0. ? lp->ubx[k] : lp->lbx[k]);
+		upx = b - a_k * (a_k > 0. ? lp->lbx[k] : lp->ubx[k]);
+		if (a_j < 0.) {
+			tmp = lo;
+			lo = up;
+			up = tmp;
+			tmp = lox;
+			lox = upx;
+			upx = tmp;
+		}
+		if (presolve_bound(lp, j, lox / a_j, upx / a_j, 1) == impf_EXIT_FAILURE
+		    || presolve_bound(lp, j, lo / a_j, up / a_j, 0) == impf_EXIT_FAILURE) {
+			*code = impf_Infeasibility;
+			return impf_EXIT_FAILURE;
+		}
+		if (presolve_push(lp, PRESOLVE_DOUBLETON, j, k, a_j, a_k, b) == impf_EXIT_FAILURE) {
+			*code = impf_MemoryAllocError;
+			return impf_EXIT_FAILURE;
+		}
+		for (r = 0; r < lp->m; r++) {
+			double *a_r = lp->a + r * lp->n;
+
+			a_rk = a_r[k];
+			if (!lp->rowact[r] || r == i || a_rk == 0.)
+				continue;
+			a_r[j] -= a_rk * a_j / a_k;
+			if (__impf_ABS__(a_r[j]) <= __impf_CTR_PRESOLVE_ZERO__)
+				a_r[j] = 0.;
+			lp->rlo[r] -= a_rk * b / a_k;
+			lp->rup[r] -= a_rk * b / a_k;
+		}
+		lp->cost[j] -= lp->cost[k] * a_j / a_k;
+		lp->offset += lp->cost[k] * b / a_k;
+		lp->colact[k] = 0;
+		lp->rowact[i] = 0;
+		*changed = 1;
+	}
+	return impf_EXIT_SUCCESS;
+}
+
+/* Remove fixed variables, and empty or dominated columns, i.e. those never
+ * making a row harder to satisfy when moving towards the cheaper bound
+ */
+static int presolve_cols(struct presolve_lp *lp, int *changed, int *code)
+{
+	int i, j, down, up;
+	double a_ij, c_j, v;
+
+	for (j = 0; j < lp->n; j++) {
+		if (!lp->colact[j])
+			continue;
+		if (lp->lb[j] > __impf_NINF__ && lp->ub[j] < __impf_INF__
+		    && lp->ub[j] - lp->lb[j] <= presolve_tol(lp->ub[j])) {
+			v = lp->lbx[j] > lp->ubx[j] - presolve_tol(lp->ubx[j]) ? lp->ubx[j] : lp->ub[j];
+			if (presolve_fix(lp, j, v) == impf_EXIT_FAILURE) {
+				*code = impf_MemoryAllocError;
+				return impf_EXIT_FAILURE;
+			}
+			*changed = 1;
+			continue;
+		}
+		down = 1;  /* decreasing x_j keeps rows satisfied */
+		up = 1;  /* increasing x_j keeps rows satisfied */
+		for (i = 0; i < lp->m && (down || up); i++) {
+			a_ij = lp->a[j + i * lp->n];
+			if (!lp->rowact[i] || __impf_ABS__(a_ij) <= __impf_CTR_PRESOLVE_ZERO__)
+				continue;
+			if (a_ij > 0.) {
+				down = down && lp->rlo[i] == __impf_NINF__;
+				up = up && lp->rup[i] == __impf_INF__;
+			} else {
+				down = down && lp->rup[i] == __impf_INF__;
+				up = up && lp->rlo[i] == __impf_NINF__;
+			}
+		}
+		c_j = lp->cost[j];
+		if (c_j > __impf_CTR_PRESOLVE_ZERO__)
+			up = 0;
+		else if (c_j < -__impf_CTR_PRESOLVE_ZERO__)
+			down = 0;
+		if (down && lp->lb[j] > __impf_NINF__)
+			v = lp->lb[j];
+		else if (up && lp->ub[j] < __impf_INF__)
+			v = lp->ub[j];
+		else if (down && up)  /* empty column of zero cost */
+			v = 0.;
+		else  /* the cheaper bound is infinite: LP is unbounded unless it is
+		       * infeasible, which is left to the simplex
+		       */
+			continue;
+		if (presolve_fix(lp, j, v) == impf_EXIT_FAILURE) {
+			*code = impf_MemoryAllocError;
+			return impf_EXIT_FAILURE;
+		}
+		*changed = 1;
+	}
+	return impf_EXIT_SUCCESS;
+}
+
+/* The smallest (largest) activity of a row without the term `a_ij x_j`,
+ * given that of the whole row `act` with `ninf` infinite terms, and `bound`
+ * the bound of `x_j` it takes
+ * Return `__impf_INF__` if it is infinite
+ */
+static double presolve_rest(const double act, const int ninf, const double a_ij, const double bound)
+{
+	if (bound == __impf_INF__ || bound == __impf_NINF__)
+		return ninf == 1 ? act : __impf_INF__;
+	return ninf == 0 ? act - a_ij * bound : __impf_INF__;
+}
+
+/* Tighten infinite bounds of variables by those implied by rows, relaxed by
+ * the tolerance
+ *
+ * Note: implied bounds larger than `__impf_CTR_PRESOLVE_BOUND__` are ignored
+ */
+static int presolve_tighten(struct presolve_lp *lp, int *changed, int *code)
+{
+	int i, j, nminf, nmaxinf;
+	double a_ij, minact, maxact, rmin, rmax, lo, up;
+
+	for (i = 0; i < lp->m; i++) {
+		if (!lp->rowact[i])
+			continue;
+		presolve_activity(lp, i, lp->lb, lp->ub, &minact, &maxact, &nminf, &nmaxinf);
+		for (j = 0; j < lp->n; j++) {
+			a_ij = lp->a[j + i * lp->n];
+			if (!lp->colact[j] || __impf_ABS__(a_ij) <= __impf_CTR_PRESOLVE_ZERO__)
+				continue;
+			rmin = presolve_rest(minact, nminf, a_ij, a_ij > 0. ? lp->lb[j] : lp->ub[j]);
+			rmax = presolve_rest(maxact, nmaxinf, a_ij, a_ij > 0. ? lp->ub[j] : lp->lb[j]);
+			lo = __impf_NINF__;
+			up = __impf_INF__;
+			/* rlo - rmax <= a_ij x_j <= rup - rmin */
+			if (lp->rup[i] < __impf_INF__ && rmin < __impf_INF__) {
+				if (a_ij > 0.)
+					up = (lp->rup[i] - rmin) / a_ij;
+				else
+					lo = (lp->rup[i] - rmin) / a_ij;
+			}
+			if (lp->rlo[i] > __impf_NINF__ && rmax < __impf_INF__) {
+				if (a_ij > 0.)
+					lo = (lp->rlo[i] - rmax) / a_ij;
+				else
+					up = (lp->rlo[i] - rmax) / a_ij;
+			}
+			if (lp->lb[j] == __impf_NINF__ && __impf_ABS__(lo) <= __impf_CTR_PRESOLVE_BOUND__) {
+				lp->lb[j] = lo - presolve_tol(lo);
+				*changed = 1;
+			}
+			if (lp->ub[j] == __impf_INF__ && __impf_ABS__(up) <= __impf_CTR_PRESOLVE_BOUND__) {
+				lp->ub[j] = up + presolve_tol(up);
+				*changed = 1;
+			}
+			if (presolve_bound(lp, j, lp->lb[j], lp->ub[j], 0) == impf_EXIT_FAILURE) {
+				*code = impf_Infeasibility;
+				return impf_EXIT_FAILURE;
+			}
+		}
+	}
+	return impf_EXIT_SUCCESS;
+}
+
+/* Merge rows proportional to each other, if the intersection of their ranges
+ * is still an equation or a one-sided inequality
+ */
+static int presolve_duplicates(struct presolve_lp *lp, int *changed, int *code)
+{
+	int i, k, l, *nnz, *first;
+	double ratio, lo, up, *a_i, *a_k;
+
+	nnz = impf_malloc((2 * lp->m + 1) * sizeof(int));
+	if (nnz == NULL) {
+		*code = impf_MemoryAllocError;
+		return impf_EXIT_FAILURE;
+	}
+	first = nnz + lp->m;
+	for (i = 0; i < lp->m; i++)
+		nnz[i] = lp->rowact[i] ? presolve_row_nnz(lp, i, first + i, &l) : 0;
+	for (i = 0; i < lp->m; i++) {
+		a_i = lp->a + i * lp->n;
+		for (k = i + 1; k < lp->m && lp->rowact[i] && nnz[i] > 0; k++) {
+			if (!lp->rowact[k] || nnz[k] != nnz[i] || first[k] != first[i])
+				continue;
+			a_k = lp->a + k * lp->n;
+			ratio = a_k[first[i]] / a_i[first[i]];
+			for (l = 0; l < lp->n; l++) {
+				if (lp->colact[l] && __impf_ABS__(a_k[l] - ratio * a_i[l])
+				    > __impf_CTR_PRESOLVE_ZERO__ * (1. + __impf_ABS__(a_k[l])))
+					break;
+			}
+			if (l < lp->n)
+				continue;
+			lo = (ratio > 0. ? lp->rlo[k] : lp->rup[k]) / ratio;
+			up = (ratio > 0. ? lp->rup[k] : lp->rlo[k]) / ratio;
+			lo = __impf_MAX__(lo, lp->rlo[i]);
+			up = __impf_MIN__(up, lp->rup[i]);
+			if (lo > up + presolve_tol(up)) {
+				impf_free(nnz);
+				*code = impf_Infeasibility;
+				return impf_EXIT_FAILURE;
+			}
+			if (lo >= up - presolve_tol(up))
+				lo = up;
+			else if (lo > __impf_NINF__ && up < __impf_INF__)  /* a ranged row, kept as two rows */
+				continue;
+			lp->rlo[i] = lo;
+			lp->rup[i] = up;
+			lp->rowact[k] = 0;
+			*changed = 1;
+		}
+	}
+	impf_free(nnz);
+	return impf_EXIT_SUCCESS;
+}
+
+/* Write the kept rows and columns to the presolved LP, rows left without
+ * nonzeros are dropped
+ *
+ * Note: a variable only bounded from above is negated, since "x <= ub" of
+ * `impf_VariableBound` always comes with "x >= 0"
+ */
+static int presolve_build(struct presolve_lp *lp, struct impf_LP_Presolve *ps)
+{
+	int i, j, t, r, l, m = 0, n = 0, neg;
+	double sign;
+
+	for (i = 0; i < lp->m; i++) {
+		if (lp->rowact[i] && presolve_row_nnz(lp, i, &j, &l) == 0)
+			lp->rowact[i] = 0;
+		m += lp->rowact[i];
+	}
+	for (j = 0; j < lp->n; j++)
+		n += lp->colact[j];
+	ps->objective = impf_malloc((n + 1) * sizeof(double));
+	ps->coefficients = impf_malloc((m * n + 1) * sizeof(double));
+	ps->constraints = impf_malloc((m + 1) * sizeof(struct impf_LinearConstraint));
+	ps->bounds = impf_malloc((n + 1) * sizeof(struct impf_VariableBound));
+	ps->colmap = impf_malloc((n + 1) * sizeof(int));
+	ps->ops = impf_malloc((lp->nops + 1) * sizeof(struct impf_LP_PresolveOp));
+	if (!ps->objective || !ps->coefficients || !ps->constraints || !ps->bounds || !ps->colmap || !ps->ops)
+		return impf_EXIT_FAILURE;
+	ps->m = m;
+	ps->n = n;
+	ps->n0 = lp->n;
+	ps->offset = lp->offset;
+	ps->nops = lp->nops;
+	impf_memcpy(ps->ops, lp->ops, lp->nops * sizeof(struct impf_LP_PresolveOp));
+
+	for (i = 0, r = 0; i < lp->m; i++) {
+		struct impf_LinearConstraint *cons = ps->constraints + r;
+
+		if (!lp->rowact[i])
+			continue;
+		assert(lp->rlo[i] == lp->rup[i] || lp->rlo[i] == __impf_NINF__ || lp->rup[i] == __impf_INF__);
+		impf_memset(cons->name, '\0', 16);
+		cons->coef = ps->coefficients + r * n;
+		if (lp->rlo[i] == lp->rup[i]) {
+			cons->type = impf_CONS_T_EQ;
+			cons->rhs = lp->rup[i];
+		} else if (lp->rlo[i] == __impf_NINF__) {
+			cons->type = impf_CONS_T_LE;
+			cons->rhs = lp->rup[i];
+		} else {
+			cons->type = impf_CONS_T_GE;
+			cons->rhs = lp->rlo[i];
+		}
+		for (j = 0, t = 0; j < lp->n; j++) {
+			if (!lp->colact[j])
+				continue;
+			neg = lp->lb[j] == __impf_NINF__ && lp->ub[j] < __impf_INF__;
+			cons->coef[t++] = neg ? -lp->a[j + i * lp->n] : lp->a[j + i * lp->n];
+		}
+		r++;
+	}
+	for (j = 0, t = 0; j < lp->n; j++) {
+		struct impf_VariableBound *bd = ps->bounds + t;
+
+		if (!lp->colact[j])
+			continue;
+		neg = lp->lb[j] == __impf_NINF__ && lp->ub[j] < __impf_INF__;
+		sign = neg ? -1. : 1.;
+		ps->colmap[t] = neg ? -1 - j : j;
+		ps->objective[t] = sign * lp->cost[j];
+		impf_memset(bd->name, '\0', 16);
+		bd->lb = neg ? -lp->ub[j] : lp->lb[j];
+		bd->ub = neg ? __impf_INF__ : lp->ub[j];
+		bd->v_type = impf_VAR_T_REAL;
+		if (bd->lb == __impf_NINF__)
+			bd->b_type = impf_BOUND_T_FR;
+		else if (bd->ub == __impf_INF__)
+			bd->b_type = impf_BOUND_T_LO;
+		else
+			bd->b_type = impf_BOUND_T_BS;
+		t++;
+	}
+	return impf_EXIT_SUCCESS;
+}
+
+int impf_lp_presolve(const double *objective, const struct impf_LinearConstraint *constraints,
+		     const struct impf_VariableBound *bounds, const int m, const int n,
+		     struct impf_LP_Presolve *ps, int *code)
+{
+	struct presolve_lp lp;
+	int pass, changed = 1, state = impf_EXIT_SUCCESS;
+
+	assert(objective != NULL);
+	assert(constraints != NULL);
+	assert(ps != NULL);
+	assert(code != NULL);
+
+	impf_memset(ps, 0, sizeof(struct impf_LP_Presolve));
+	if (presolve_create(&lp, objective, constraints, bounds, m, n) == impf_EXIT_FAILURE) {
+		*code = impf_MemoryAllocError;
+		return impf_EXIT_FAILURE;
+	}
+	for (pass = 0; changed && pass < __impf_CTR_PRESOLVE_PASSES__; pass++) {
+		changed = 0;
+		if (presolve_rows(&lp, &changed, code) == impf_EXIT_FAILURE
+		    || presolve_cols(&lp, &changed, code) == impf_EXIT_FAILURE
+		    || presolve_doubletons(&lp, &changed, code) == impf_EXIT_FAILURE
+		    || (pass == 0 && presolve_duplicates(&lp, &changed, code) == impf_EXIT_FAILURE)
+		    || presolve_tighten(&lp, &changed, code) == impf_EXIT_FAILURE) {
+			state = impf_EXIT_FAILURE;
+			break;
+		}
+	}
+	if (state == impf_EXIT_SUCCESS && presolve_build(&lp, ps) == impf_EXIT_FAILURE) {
+		impf_lp_presolve_free(ps);
+		*code = impf_MemoryAllocError;
+		state = impf_EXIT_FAILURE;
+	}
+#ifdef IMPF_MODE_DEV
+	if (state == impf_EXIT_SUCCESS)
+		impf_prt_dev(">>> Presolve: m = %i -> %i, n = %i -> %i, passes = %i\n", m, ps->m, n, ps->n, pass);
+#endif
+	presolve_free(&lp);
+	return state;
+}
+
+void impf_lp_postsolve(const struct impf_LP_Presolve *ps, const double *x, const double value,
+		       double *x0, double *value0)
+{
+	int t, l;
+	const struct impf_LP_PresolveOp *op;
+
+	for (t = 0; t < ps->n; t++) {
+		if (ps->colmap[t] >= 0)
+			x0[ps->colmap[t]] = x[t];
+		else
+			x0[-1 - ps->colmap[t]] = -x[t];
+	}
+	for (l = ps->nops - 1; l >= 0; l--) {
+		op = ps->ops + l;
+		if (op->type == PRESOLVE_FIX)
+			x0[op->j] = op->b;
+		else
+			x0[op->k] = (op->b - op->a_j * x0[op->j]) / op->a_k;
+	}
+	*value0 = value + ps->offset;
+}
+
+void impf_lp_presolve_free(struct impf_LP_Presolve *ps)
+{
+	if (ps->objective)
+		impf_free(ps->objective);
+	if (ps->coefficients)
+		impf_free(ps->coefficients);
+	if (ps->constraints)
+		impf_free(ps->constraints);
+	if (ps->bounds)
+		impf_free(ps->bounds);
+	if (ps->colmap)
+		impf_free(ps->colmap);
+	if (ps->ops)
+		impf_free(ps->ops);
+	impf_memset(ps, 0, sizeof(struct impf_LP_Presolve));
+}
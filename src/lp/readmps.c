@@ -2,65 +2,51 @@
  * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
  * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
  */
+#include <impf/_magics.h>
 #include <impf/fmin_lp.h>
 #include <stdio.h>
 
-static struct impf_Model_LP *create_model(const int m, const int n)
+static struct impf_Model_LP *create_model(const int m, const int n, const int nnz)
 {
-	double *obj = NULL;
-	double *coefficients = NULL;
-	struct impf_LinearConstraint *constraints = NULL;
-	struct impf_VariableBound *bounds = NULL;
 	struct impf_Model_LP *model = NULL;
 	int i;
 
 	model = impf_malloc(sizeof(struct impf_Model_LP));
 	if (model == NULL)
 		return NULL;
-	obj = impf_malloc(n * sizeof(double));
-	if (obj == NULL) {
-		impf_free(model);
-		return NULL;
-	}
-	coefficients = impf_malloc(m * n * sizeof(double));
-	if (coefficients == NULL) {
-		impf_free(model);
-		impf_free(obj);
-		return NULL;
-	}
-	constraints = impf_malloc(m * sizeof(struct impf_LinearConstraint));
-	if (constraints == NULL) {
-		impf_free(model);
-		impf_free(obj);
-		impf_free(coefficients);
-		return NULL;
-	}
-	bounds = impf_malloc(n * sizeof(struct impf_VariableBound));
-	if (bounds == NULL) {
-		impf_free(model);
-		impf_free(obj);
-		impf_free(coefficients);
-		impf_free(constraints);
-		return NULL;
-	}
+	impf_memset(model, 0, sizeof(struct impf_Model_LP));
 	model->m = m;
 	model->n = n;
-	model->objective = obj;
-	model->coefficients = coefficients;
-	model->constraints = constraints;
-	model->bounds = bounds;
-	impf_memset(coefficients, 0., m * n * sizeof(double));
+	model->objective = impf_malloc(n * sizeof(double));
+	model->colptr = impf_malloc((n + 1) * sizeof(int));
+	model->rowidx = impf_malloc((nnz + 1) * sizeof(int));
+	model->values = impf_malloc((nnz + 1) * sizeof(double));
+	model->constraints = impf_malloc(m * sizeof(struct impf_LinearConstraint));
+	model->bounds = impf_malloc(n * sizeof(struct impf_VariableBound));
+	if ((double) m * n <= __impf_LP_DENSE_MAX__)  /* small model, also keep dense coefficients */
+		model->coefficients = impf_malloc((m * n + 1) * sizeof(double));
+
+	if (!model->objective || !model->colptr || !model->rowidx || !model->values
+	    || !model->constraints || !model->bounds
+	    || ((double) m * n <= __impf_LP_DENSE_MAX__ && !model->coefficients)) {
+		impf_lp_free(model);
+		return NULL;
+	}
+	impf_memset(model->objective, 0, n * sizeof(double));
+	if (model->coefficients)
+		impf_memset(model->coefficients, 0, m * n * sizeof(double));
 
 	for (i = 0; i < m; i++) {
-		constraints[i].coef = coefficients + i * n;
-		impf_memset(constraints[i].name, '\0', 16);
+		model->constraints[i].coef = model->coefficients ? model->coefficients + i * n : NULL;
+		model->constraints[i].rhs = 0.;  /* rhs is optional in MPS file */
+		impf_memset(model->constraints[i].name, '\0', 16);
 	}
 	for (i = 0; i < n; i++) {
-		impf_memset(bounds[i].name, '\0', 16);
-		bounds[i].lb = 0;
-		bounds[i].ub = __impf_INF__;
-		bounds[i].b_type = impf_BOUND_T_LO;
-		bounds[i].v_type = impf_VAR_T_REAL;
+		impf_memset(model->bounds[i].name, '\0', 16);
+		model->bounds[i].lb = 0;
+		model->bounds[i].ub = __impf_INF__;
+		model->bounds[i].b_type = impf_BOUND_T_LO;
+		model->bounds[i].v_type = impf_VAR_T_REAL;
 	}
 	return model;
 }
@@ -71,6 +57,12 @@ void impf_lp_free(struct impf_Model_LP *model)
 		return;
 	if (model->coefficients)
 		impf_free(model->coefficients);
+	if (model->colptr)
+		impf_free(model->colptr);
+	if (model->rowidx)
+		impf_free(model->rowidx);
+	if (model->values)
+		impf_free(model->values);
 	if (model->constraints)
 		impf_free(model->constraints);
 	if (model->bounds)
@@ -109,7 +101,7 @@ static int change_sect_code(const char *line, int *sect_code)
 		return 1;
 }
 
-static int get_mps_info(const char *file, int *nrow, int *nvar)
+static int get_mps_info(const char *file, int *nrow, int *nvar, int *nnz)
 {
 	char line[128];
 	char last_var[8];
@@ -123,6 +115,7 @@ static int get_mps_info(const char *file, int *nrow, int *nvar)
 	}
 	*nrow = 0;
 	*nvar = 0;
+	*nnz = 0;
 	impf_memset(last_var, '\0', 8);
 LOOP:
 	file_readline(f, line, 128);
@@ -138,6 +131,7 @@ LOOP:
 			(*nvar)++;
 			impf_memcpy(last_var, line + 4, 8);
 		}
+		*nnz += (impf_strlen(line) < 40) ? 1 : 2;
 		break;
 	default:
 		break;
@@ -155,7 +149,7 @@ static double get_filed_1_value(const char *line)
 	char value_str[13];
 	double value;
 
-	impf_memset(value_str, '\0', 12);
+	impf_memset(value_str, '\0', 13);
 	impf_memcpy(value_str, line + 24, 12);
 	value = impf_atof(value_str);
 	return value;
@@ -166,7 +160,7 @@ static double get_field_2_value(const char *line)
 	char value_str[13];
 	double value;
 
-	impf_memset(value_str, '\0', 12);
+	impf_memset(value_str, '\0', 13);
 	impf_memcpy(value_str, line + 49, 12);
 	value = impf_atof(value_str);
 	return value;
@@ -180,7 +174,11 @@ static void fill_model_coef(struct impf_Model_LP *model, const double value, con
 		char *tmp = model->constraints[i].name;
 
 		if (impf_memcmp(field_name, tmp, impf_strlen(tmp)) == 0) {
-			model->constraints[i].coef[nvars - 1] = value;
+			model->rowidx[model->nnz] = i;
+			model->values[model->nnz] = value;
+			model->nnz++;
+			if (model->coefficients)
+				model->constraints[i].coef[nvars - 1] = value;
 			break;
 		}
 	}
@@ -263,6 +261,7 @@ LOOP:
 			impf_memset(model->bounds[nvars].name, '\0', 16);
 			impf_memcpy(model->bounds[nvars].name, line + 4, 8);
 			last_name = model->bounds[nvars].name;
+			model->colptr[nvars] = model->nnz;
 			nvars++;
 		}
 		value = get_filed_1_value(line);
@@ -287,6 +286,7 @@ LOOP:
 		goto END;
 	goto LOOP;
 END:
+	model->colptr[nvars] = model->nnz;
 	fclose(f);
 	return impf_EXIT_SUCCESS;
 }
@@ -295,13 +295,13 @@ struct impf_Model_LP *impf_lp_readmps(const char *file)
 {
 	struct impf_Model_LP *model;
 	int m, n;  /* number of constraints and variables */
-	int n_sect_row = 0, n_sect_columns = 0;
+	int n_sect_row = 0, n_sect_columns = 0, n_entries = 0;
 
-	if (get_mps_info(file, &n_sect_row, &n_sect_columns) == impf_EXIT_FAILURE)
+	if (get_mps_info(file, &n_sect_row, &n_sect_columns, &n_entries) == impf_EXIT_FAILURE)
 		return NULL;
 	m = n_sect_row - 1;  /* the objective is also counted */
 	n = n_sect_columns;
-	model = create_model(m, n);
+	model = create_model(m, n, n_entries);
 
 	if (model == NULL)
 		return NULL;
@@ -7,11 +7,12 @@
 #include <stdio.h>
 #endif
 
-static int stdlpf_alloc(const int M, const int N, double **obj2, double **x2, double **coef2,
+static int stdlpf_alloc(const int M, const int N, double **obj2, double **x2, double **ub2, double **coef2,
 			struct impf_LinearConstraint **constraints2)
 {
 	*obj2 = NULL;
 	*x2 = NULL;
+	*ub2 = NULL;
 	*coef2 = NULL;
 	*constraints2 = NULL;
 
@@ -23,28 +24,39 @@ static int stdlpf_alloc(const int M, const int N, double **obj2, double **x2, do
 		impf_free(*obj2);
 		return impf_EXIT_FAILURE;
 	}
+	*ub2 = impf_malloc(N * sizeof(double));
+	if (*ub2 == NULL) {
+		impf_free(*obj2);
+		impf_free(*x2);
+		return impf_EXIT_FAILURE;
+	}
 	*coef2 = impf_malloc(M * N * sizeof(double));
 	if (*coef2 == NULL) {
 		impf_free(*obj2);
 		impf_free(*x2);
+		impf_free(*ub2);
 		return impf_EXIT_FAILURE;
 	}
 	*constraints2 = impf_malloc(M * sizeof(struct impf_LinearConstraint));
 	if (*constraints2 == NULL) {
 		impf_free(*obj2);
 		impf_free(*x2);
+		impf_free(*ub2);
 		impf_free(*coef2);
 		return impf_EXIT_FAILURE;
 	}
 	return impf_EXIT_SUCCESS;
 }
 
-static void stdlpf_free(double *obj2, double *x2, double *coef2, struct impf_LinearConstraint *constraints2)
+static void stdlpf_free(double *obj2, double *x2, double *ub2, double *coef2,
+			struct impf_LinearConstraint *constraints2)
 {
 	if (obj2)
 		impf_free(obj2);
 	if (x2)
 		impf_free(x2);
+	if (ub2)
+		impf_free(ub2);
 	if (coef2)
 		impf_free(coef2);
 	if (constraints2)
@@ -55,7 +67,7 @@ static void stdlpf_free(double *obj2, double *x2, double *coef2, struct impf_Lin
  *
  * Rules:
  *	1. free variable x = y1 - y2
- *	2. "x <= ub" will be added to constraints
+ *	2. "x <= ub" is kept as an upper bound, handled by the simplex directly
  */
 static void stdlpf_size(const struct impf_VariableBound *bounds, const int m, const int n, int *_M, int *_N)
 {
@@ -68,8 +80,6 @@ static void stdlpf_size(const struct impf_VariableBound *bounds, const int m, co
 
 		if (impf_BOUND_T_FR == bd->b_type)
 			(*_N)++;
-		if (impf_BOUND_T_UP == bd->b_type || impf_BOUND_T_BS == bd->b_type)
-			(*_M)++;
 	}
 }
 
@@ -77,23 +87,20 @@ static void stdlpf_size(const struct impf_VariableBound *bounds, const int m, co
  */
 static void lp_transf_0(const double *objective, const struct impf_LinearConstraint *constraints,
 			const struct impf_VariableBound *bounds, const int m, const int _N, const int j,
-			int *ctr_var, int *ctr_ubcons, double *obj2,
-			double *coef2, struct impf_LinearConstraint *constraints2)
+			int *ctr_var, double *obj2, double *ub2, double *coef2)
 {
-	int i, idx;
+	int i;
 	const struct impf_VariableBound *bd;
 
 	bd = bounds + j;
 	obj2[*ctr_var] = objective[j];
 
-	if (impf_BOUND_T_UP == bd->b_type || impf_BOUND_T_BS == bd->b_type) {
-		idx = m + (*ctr_ubcons);
-		constraints2[idx].coef = coef2 + idx * _N;
-		constraints2[idx].rhs = bd->ub;
-		constraints2[idx].type = impf_CONS_T_LE;
-		constraints2[idx].coef[*ctr_var] = 1.;
-		(*ctr_ubcons)++;
-	}
+	if (impf_BOUND_T_UP == bd->b_type)
+		ub2[*ctr_var] = bd->ub;
+	else if (impf_BOUND_T_BS == bd->b_type)
+		ub2[*ctr_var] = bd->ub - bd->lb;
+	else
+		ub2[*ctr_var] = __impf_INF__;
 	for (i = 0; i < m; i++)
 		coef2[(*ctr_var) + i * _N] = (constraints + i)->coef[j];
 	(*ctr_var)++;
@@ -103,13 +110,14 @@ static void lp_transf_0(const double *objective, const struct impf_LinearConstra
  */
 static void lp_transf_1(const double *objective, const struct impf_LinearConstraint *constraints,
 			const struct impf_VariableBound *bounds, const int m, const int _N, const int j,
-			int *ctr_var, double *obj2, double *coef2)
+			int *ctr_var, double *obj2, double *ub2, double *coef2)
 {
 	int i;
 
 	if (impf_BOUND_T_FR != (bounds + j)->b_type)
 		return;
 	obj2[*ctr_var] = -objective[j];
+	ub2[*ctr_var] = __impf_INF__;
 
 	for (i = 0; i < m; i++)
 		coef2[(*ctr_var) + i * _N] = -((constraints + i)->coef[j]);
@@ -119,8 +127,8 @@ static void lp_transf_1(const double *objective, const struct impf_LinearConstra
 /* Variable transformation 2: "xj >= lb" => "y >= 0"
  */
 static void lp_transf_2(const double *objective, const struct impf_LinearConstraint *constraints,
-			const struct impf_VariableBound *bounds, const int m, const int _M, const int j,
-			double *obj2, double *obj_diff, struct impf_LinearConstraint *constraints2)
+			const struct impf_VariableBound *bounds, const int m, const int j,
+			double *obj_diff, struct impf_LinearConstraint *constraints2)
 {
 	int i;
 	const struct impf_VariableBound *bd = bounds + j;
@@ -129,29 +137,23 @@ static void lp_transf_2(const double *objective, const struct impf_LinearConstra
 		return;
 	*obj_diff += objective[j] * bd->lb;
 
-	for (i = 0; i < _M; i++) {
-		struct impf_LinearConstraint *cons = constraints2 + i;
-
-		if (i < m)
-			cons->rhs -= ((constraints + i)->coef[j]) * (bd->lb);
-		else
-			cons->rhs -= bd->lb;
-	}
+	for (i = 0; i < m; i++)
+		constraints2[i].rhs -= ((constraints + i)->coef[j]) * (bd->lb);
 }
 
 /* Transform original LP into standard form
  *
  * Note:
  *	Original LP: allow for more variable bounds
- *	Standard LP: x >= 0
+ *	Standard LP: 0 <= x <= ub
  */
 static void lp_transstd(const double *objective, const struct impf_LinearConstraint *constraints,
-			const struct impf_VariableBound *bounds, const int m, const int n, const int _M, const int _N,
-			double *obj2, double *obj_diff, double *coef2, struct impf_LinearConstraint *constraints2)
+			const struct impf_VariableBound *bounds, const int m, const int n, const int _N,
+			double *obj2, double *obj_diff, double *ub2, double *coef2,
+			struct impf_LinearConstraint *constraints2)
 {
 	int i, j;
 	int ctr_var = 0;
-	int ctr_ubcons = 0;
 
 	for (i = 0; i < m; i++) {
 		constraints2[i].coef = coef2 + i * _N;
@@ -159,9 +161,9 @@ static void lp_transstd(const double *objective, const struct impf_LinearConstra
 		constraints2[i].type = (constraints + i)->type;
 	}
 	for (j = 0; j < n; j++) {
-		lp_transf_0(objective, constraints, bounds, m, _N, j, &ctr_var, &ctr_ubcons, obj2, coef2, constraints2);
-		lp_transf_1(objective, constraints, bounds, m, _N, j, &ctr_var, obj2, coef2);
-		lp_transf_2(objective, constraints, bounds, m, _M, j, obj2, obj_diff, constraints2);
+		lp_transf_0(objective, constraints, bounds, m, _N, j, &ctr_var, obj2, ub2, coef2);
+		lp_transf_1(objective, constraints, bounds, m, _N, j, &ctr_var, obj2, ub2, coef2);
+		lp_transf_2(objective, constraints, bounds, m, j, obj_diff, constraints2);
 	}
 }
 
@@ -191,13 +193,13 @@ static void retreive_ori_lp_sol(const struct impf_VariableBound *bounds, const i
 	*value = value2 + obj_diff;
 }
 
-int impf_lp_simplex(const double *objective, const struct impf_LinearConstraint *constraints,
-		    const struct impf_VariableBound *bounds,
-		    const int m, const int n, const char *criteria, const int niter,
-		    double *x, double *value, int *code)
+int impf_lp_simplex_gen(const double *objective, const struct impf_LinearConstraint *constraints,
+			const struct impf_VariableBound *bounds,
+			const int m, const int n, const char *criteria, const int niter,
+			double *x, double *value, int *code)
 {
 	int _M, _N;
-	double *obj2, *x2, *coef2;
+	double *obj2, *x2, *ub2, *coef2;
 	struct impf_LinearConstraint *constraints2;
 	double value2 = 0, obj_diff = 0; /* value = value2 + obj_diff */
 
@@ -207,22 +209,59 @@ int impf_lp_simplex(const double *objective, const struct impf_LinearConstraint
 	assert(value != NULL);
 	assert(code != NULL);
 
+	if (7 == impf_strlen(criteria) && 0 == impf_memcmp("revised", criteria, 7))
+		return impf_lp_simplex_rev(objective, constraints, bounds, m, n, "dantzig", niter, x, value, code);
 	if (bounds == NULL)
 		return impf_lp_simplex_std(objective, constraints, m, n, criteria, niter, x, value, code);
 	stdlpf_size(bounds, m, n, &_M, &_N);
 
-	if (stdlpf_alloc(_M, _N, &obj2, &x2, &coef2, &constraints2) == impf_EXIT_FAILURE) {
+	if (stdlpf_alloc(_M, _N, &obj2, &x2, &ub2, &coef2, &constraints2) == impf_EXIT_FAILURE) {
 		*code = impf_MemoryAllocError;
 		return impf_EXIT_FAILURE;
 	}
-	impf_memset(coef2, 0., _M * _N);
-	lp_transstd(objective, constraints, bounds, m, n, _M, _N, obj2, &obj_diff, coef2, constraints2);
-	if (impf_lp_simplex_std(obj2, constraints2, _M, _N, criteria, niter, x2, &value2, code) == impf_EXIT_SUCCESS) {
+	impf_memset(coef2, 0., _M * _N * sizeof(double));
+	lp_transstd(objective, constraints, bounds, m, n, _N, obj2, &obj_diff, ub2, coef2, constraints2);
+	if (impf_lp_simplex_bnd(obj2, constraints2, ub2, _M, _N, criteria, niter, x2, &value2, code) == impf_EXIT_SUCCESS) {
 		retreive_ori_lp_sol(bounds, n, x2, value2, obj_diff, x, value);
-		stdlpf_free(obj2, x2, coef2, constraints2);
+		stdlpf_free(obj2, x2, ub2, coef2, constraints2);
 		*code = impf_Success;
 		return impf_EXIT_SUCCESS;
 	}
-	stdlpf_free(obj2, x2, coef2, constraints2);
+	stdlpf_free(obj2, x2, ub2, coef2, constraints2);
 	return impf_EXIT_FAILURE; /* error code already updated */
 }
+
+int impf_lp_simplex(const double *objective, const struct impf_LinearConstraint *constraints,
+		    const struct impf_VariableBound *bounds,
+		    const int m, const int n, const char *criteria, const int niter,
+		    double *x, double *value, int *code)
+{
+	struct impf_LP_Presolve ps;
+	double *x2, value2 = 0;
+
+	assert(objective != NULL);
+	assert(constraints != NULL);
+	assert(x != NULL);
+	assert(value != NULL);
+	assert(code != NULL);
+
+	if (impf_lp_presolve(objective, constraints, bounds, m, n, &ps, code) == impf_EXIT_FAILURE)
+		return impf_EXIT_FAILURE;
+	x2 = impf_malloc((ps.n + 1) * sizeof(double));
+	if (x2 == NULL) {
+		impf_lp_presolve_free(&ps);
+		*code = impf_MemoryAllocError;
+		return impf_EXIT_FAILURE;
+	}
+	if (ps.n > 0 && impf_lp_simplex_gen(ps.objective, ps.constraints, ps.bounds, ps.m, ps.n,
+					    criteria, niter, x2, &value2, code) == impf_EXIT_FAILURE) {
+		impf_free(x2);
+		impf_lp_presolve_free(&ps);
+		return impf_EXIT_FAILURE;  /* error code already updated */
+	}
+	impf_lp_postsolve(&ps, x2, value2, x, value);
+	impf_free(x2);
+	impf_lp_presolve_free(&ps);
+	*code = impf_Success;
+	return impf_EXIT_SUCCESS;
+}
@@ -0,0 +1,1394 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <impf/_magics.h>
+#include <impf/linalg.h>
+#include <impf/fmin_lp.h>
+
+/* Status of variables in revised simplex */
+#define RSPLX_BASIC	0
+#define RSPLX_AT_LB	1
+#define RSPLX_AT_UB	2
+#define RSPLX_AT_ZERO	3	/* nonbasic free variable */
+
+/* Column compressed matrix
+ */
+struct rsplx_csc {
+	int nrow;
+	int ncol;
+	int *colptr;	/* length = ncol + 1 */
+	int *rowidx;	/* length = nnz */
+	double *values;	/* length = nnz */
+};
+
+/* LU factors of the basis matrix followed by an eta file of updates
+ *
+ * Note:
+ *	1. L is unit lower triangular, diagonal stored first in each column
+ *	2. U is upper triangular, diagonal stored last in each column
+ *	3. row `i` of the basis is the `pinv[i]`-th pivot
+ *	4. the `k`-th pivot column is the basis position `cperm[k]`
+ *	5. eta `e` replaces basis position `etar[e]` by a column whose FTRAN
+ *		is `etapiv[e]` at position `etar[e]` and (`etai`, `etax`) elsewhere
+ */
+struct rsplx_lu {
+	int *lp;
+	int *li;
+	double *lx;
+	int lnzmax;
+	int *up;
+	int *ui;
+	double *ux;
+	int unzmax;
+	int *pinv;
+	int *cperm;
+	int neta;
+	int *etap;
+	int *etar;
+	double *etapiv;
+	int *etai;
+	double *etax;
+	int etanzmax;
+	int *xi;	/* sparse triangular solve: reach, length = m */
+	int *pstack;	/* sparse triangular solve: dfs stack, length = m */
+	int *mark;	/* sparse triangular solve: visited stamp, length = m */
+	int *colcnt;	/* column ordering by count, length = m + 1 */
+	double *work;	/* length = m */
+};
+
+/* Revised simplex problem
+ *
+ * The computational form is
+ *
+ *	min  c'x
+ *	s.t. A x - r = 0
+ *		lb <= (x, r) <= ub
+ *
+ * where `r` are the logical variables (one per row) carrying row bounds,
+ * so that the all-logical basis `-I` is always available
+ */
+struct rsplx {
+	int m;
+	int n;
+	int nvar;	/* n + m */
+	struct rsplx_csc A;	/* [A, -I], m x nvar */
+	double *cost;	/* length = nvar */
+	double *lb;	/* length = nvar */
+	double *ub;	/* length = nvar */
+	double *lb0;	/* original bounds while `lb` is perturbed, length = nvar */
+	double *ub0;	/* original bounds while `ub` is perturbed, length = nvar */
+	int perturbed;
+	double *x;	/* length = nvar */
+	int *stat;	/* length = nvar */
+	int *head;	/* basic variable at each basis position, length = m */
+	double *cB;	/* length = m */
+	double *y;	/* length = m */
+	double *alpha;	/* length = m */
+	double *rho;	/* row of the basis inverse, length = m */
+	double *arow;	/* row of the simplex table, length = nvar */
+	struct rsplx_lu lu;
+};
+
+static void rsplx_free(struct rsplx *lp)
+{
+	struct rsplx_lu *lu = &lp->lu;
+
+	impf_free(lp->A.colptr);
+	impf_free(lp->A.rowidx);
+	impf_free(lp->A.values);
+	impf_free(lp->cost);
+	impf_free(lp->lb);
+	impf_free(lp->ub);
+	impf_free(lp->lb0);
+	impf_free(lp->ub0);
+	impf_free(lp->x);
+	impf_free(lp->stat);
+	impf_free(lp->head);
+	impf_free(lp->cB);
+	impf_free(lp->y);
+	impf_free(lp->alpha);
+	impf_free(lp->rho);
+	impf_free(lp->arow);
+	impf_free(lu->lp);
+	impf_free(lu->li);
+	impf_free(lu->lx);
+	impf_free(lu->up);
+	impf_free(lu->ui);
+	impf_free(lu->ux);
+	impf_free(lu->pinv);
+	impf_free(lu->cperm);
+	impf_free(lu->etap);
+	impf_free(lu->etar);
+	impf_free(lu->etapiv);
+	impf_free(lu->etai);
+	impf_free(lu->etax);
+	impf_free(lu->xi);
+	impf_free(lu->pstack);
+	impf_free(lu->mark);
+	impf_free(lu->colcnt);
+	impf_free(lu->work);
+	impf_memset(lp, 0, sizeof(struct rsplx));
+}
+
+/* Allocate the revised simplex problem of `m` rows, `n` columns and `nnz`
+ * nonzeros in the structural part of the constraint matrix
+ */
+static int rsplx_create(struct rsplx *lp, const int m, const int n, const int nnz)
+{
+	struct rsplx_lu *lu = &lp->lu;
+	int nvar = n + m;
+
+	impf_memset(lp, 0, sizeof(struct rsplx));
+	lp->m = m;
+	lp->n = n;
+	lp->nvar = nvar;
+	lp->A.nrow = m;
+	lp->A.ncol = nvar;
+	lp->A.colptr = impf_malloc((nvar + 1) * sizeof(int));
+	lp->A.rowidx = impf_malloc((nnz + m + 1) * sizeof(int));
+	lp->A.values = impf_malloc((nnz + m + 1) * sizeof(double));
+	lp->cost = impf_malloc(nvar * sizeof(double));
+	lp->lb = impf_malloc(nvar * sizeof(double));
+	lp->ub = impf_malloc(nvar * sizeof(double));
+	lp->lb0 = impf_malloc(nvar * sizeof(double));
+	lp->ub0 = impf_malloc(nvar * sizeof(double));
+	lp->x = impf_malloc(nvar * sizeof(double));
+	lp->stat = impf_malloc(nvar * sizeof(int));
+	lp->head = impf_malloc((m + 1) * sizeof(int));
+	lp->cB = impf_malloc((m + 1) * sizeof(double));
+	lp->y = impf_malloc((m + 1) * sizeof(double));
+	lp->alpha = impf_malloc((m + 1) * sizeof(double));
+	lp->rho = impf_malloc((m + 1) * sizeof(double));
+	lp->arow = impf_malloc(nvar * sizeof(double));
+
+	lu->lnzmax = nnz + 4 * m + 1;
+	lu->unzmax = nnz + 4 * m + 1;
+	lu->etanzmax = 4 * m + 1;
+	lu->lp = impf_malloc((m + 1) * sizeof(int));
+	lu->li = impf_malloc(lu->lnzmax * sizeof(int));
+	lu->lx = impf_malloc(lu->lnzmax * sizeof(double));
+	lu->up = impf_malloc((m + 1) * sizeof(int));
+	lu->ui = impf_malloc(lu->unzmax * sizeof(int));
+	lu->ux = impf_malloc(lu->unzmax * sizeof(double));
+	lu->pinv = impf_malloc((m + 1) * sizeof(int));
+	lu->cperm = impf_malloc((m + 1) * sizeof(int));
+	lu->etap = impf_malloc((__impf_CTR_RSPLX_REFACTOR__ + 1) * sizeof(int));
+	lu->etar = impf_malloc(__impf_CTR_RSPLX_REFACTOR__ * sizeof(int));
+	lu->etapiv = impf_malloc(__impf_CTR_RSPLX_REFACTOR__ * sizeof(double));
+	lu->etai = impf_malloc(lu->etanzmax * sizeof(int));
+	lu->etax = impf_malloc(lu->etanzmax * sizeof(double));
+	lu->xi = impf_malloc((m + 1) * sizeof(int));
+	lu->pstack = impf_malloc((m + 1) * sizeof(int));
+	lu->mark = impf_malloc((m + 1) * sizeof(int));
+	lu->colcnt = impf_malloc((m + 2) * sizeof(int));
+	lu->work = impf_malloc((m + 1) * sizeof(double));
+
+	if (!lp->A.colptr || !lp->A.rowidx || !lp->A.values || !lp->cost || !lp->lb || !lp->ub
+	    || !lp->lb0 || !lp->ub0 || !lp->x || !lp->stat || !lp->head || !lp->cB || !lp->y || !lp->alpha || !lp->rho || !lp->arow
+	    || !lu->lp || !lu->li || !lu->lx || !lu->up || !lu->ui || !lu->ux || !lu->pinv || !lu->cperm
+	    || !lu->etap || !lu->etar || !lu->etapiv || !lu->etai || !lu->etax
+	    || !lu->xi || !lu->pstack || !lu->mark || !lu->colcnt || !lu->work) {
+		rsplx_free(lp);
+		return impf_EXIT_FAILURE;
+	}
+	return impf_EXIT_SUCCESS;
+}
+
+/* Make sure `arr` (of int) and `val` (of double) hold at least `need` entries
+ */
+static int rsplx_reserve(int **arr, double **val, int *cap, const int need)
+{
+	int newcap;
+	int *arr2;
+	double *val2;
+
+	if (need <= *cap)
+		return impf_EXIT_SUCCESS;
+	newcap = __impf_MAX__(2 * (*cap), need);
+	arr2 = impf_realloc(*arr, newcap * sizeof(int));
+	if (arr2 == NULL)
+		return impf_EXIT_FAILURE;
+	*arr = arr2;
+	val2 = impf_realloc(*val, newcap * sizeof(double));
+	if (val2 == NULL)
+		return impf_EXIT_FAILURE;
+	*val = val2;
+	*cap = newcap;
+	return impf_EXIT_SUCCESS;
+}
+
+/* Bounds of a structural variable (see `impf_BOUND_T_*` in <fmin.h>)
+ */
+static void rsplx_var_bounds(const struct impf_VariableBound *bd, double *lb, double *ub)
+{
+	if (bd == NULL) {
+		*lb = 0.;
+		*ub = __impf_INF__;
+		return;
+	}
+	switch (bd->b_type) {
+	case impf_BOUND_T_FR:
+		*lb = __impf_NINF__;
+		*ub = __impf_INF__;
+		break;
+	case impf_BOUND_T_UP:
+		*lb = 0.;
+		*ub = bd->ub;
+		break;
+	case impf_BOUND_T_BS:
+		*lb = bd->lb;
+		*ub = bd->ub;
+		break;
+	default:
+		*lb = bd->lb;
+		*ub = __impf_INF__;
+		break;
+	}
+}
+
+/* Bounds of the logical variable of a constraint
+ */
+static void rsplx_row_bounds(const int type, const double rhs, double *lb, double *ub)
+{
+	switch (type) {
+	case impf_CONS_T_EQ:
+		*lb = rhs;
+		*ub = rhs;
+		break;
+	case impf_CONS_T_GE:
+		*lb = rhs;
+		*ub = __impf_INF__;
+		break;
+	default:
+		*lb = __impf_NINF__;
+		*ub = rhs;
+		break;
+	}
+}
+
+/* Load a general form LP with dense constraint coefficients
+ */
+static int rsplx_load_dense(struct rsplx *lp, const double *objective,
+			    const struct impf_LinearConstraint *constraints,
+			    const struct impf_VariableBound *bounds, const int m, const int n)
+{
+	int i, j, nnz = 0;
+	double a;
+
+	for (i = 0; i < m; i++) {
+		for (j = 0; j < n; j++) {
+			if (constraints[i].coef[j] != 0.)
+				nnz++;
+		}
+	}
+	if (rsplx_create(lp, m, n, nnz) == impf_EXIT_FAILURE)
+		return impf_EXIT_FAILURE;
+	nnz = 0;
+	for (j = 0; j < n; j++) {
+		lp->A.colptr[j] = nnz;
+		for (i = 0; i < m; i++) {
+			a = constraints[i].coef[j];
+			if (a == 0.)
+				continue;
+			lp->A.rowidx[nnz] = i;
+			lp->A.values[nnz] = a;
+			nnz++;
+		}
+		lp->cost[j] = objective[j];
+		rsplx_var_bounds(bounds ? bounds + j : NULL, lp->lb + j, lp->ub + j);
+	}
+	for (i = 0; i < m; i++) {
+		lp->A.colptr[n + i] = nnz;
+		lp->A.rowidx[nnz] = i;
+		lp->A.values[nnz] = -1.;
+		nnz++;
+		lp->cost[n + i] = 0.;
+		rsplx_row_bounds(constraints[i].type, constraints[i].rhs, lp->lb + n + i, lp->ub + n + i);
+	}
+	lp->A.colptr[n + m] = nnz;
+	return impf_EXIT_SUCCESS;
+}
+
+/* Load a general form LP with column compressed constraint coefficients
+ */
+static int rsplx_load_csc(struct rsplx *lp, const double *objective,
+			  const int *colptr, const int *rowidx, const double *values,
+			  const struct impf_LinearConstraint *constraints,
+			  const struct impf_VariableBound *bounds, const int m, const int n)
+{
+	int i, j, p, nnz = 0;
+
+	if (rsplx_create(lp, m, n, colptr[n]) == impf_EXIT_FAILURE)
+		return impf_EXIT_FAILURE;
+	for (j = 0; j < n; j++) {
+		lp->A.colptr[j] = nnz;
+		for (p = colptr[j]; p < colptr[j + 1]; p++) {
+			if (values[p] == 0.)
+				continue;
+			lp->A.rowidx[nnz] = rowidx[p];
+			lp->A.values[nnz] = values[p];
+			nnz++;
+		}
+		lp->cost[j] = objective[j];
+		rsplx_var_bounds(bounds ? bounds + j : NULL, lp->lb + j, lp->ub + j);
+	}
+	for (i = 0; i < m; i++) {
+		lp->A.colptr[n + i] = nnz;
+		lp->A.rowidx[nnz] = i;
+		lp->A.values[nnz] = -1.;
+		nnz++;
+		lp->cost[n + i] = 0.;
+		rsplx_row_bounds(constraints[i].type, constraints[i].rhs, lp->lb + n + i, lp->ub + n + i);
+	}
+	lp->A.colptr[n + m] = nnz;
+	return impf_EXIT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Basis factorization
+ ******************************************************************************/
+
+/* Depth-first search in the graph of L starting from row `j`
+ */
+static int rsplx_lu_dfs(struct rsplx_lu *lu, int j, int top, const int stamp)
+{
+	int i, p, p2, jnew, done, head = 0;
+	int *xi = lu->xi, *pstack = lu->pstack;
+
+	xi[0] = j;
+	while (head >= 0) {
+		j = xi[head];
+		jnew = lu->pinv[j];
+
+		if (lu->mark[j] != stamp) {
+			lu->mark[j] = stamp;
+			pstack[head] = (jnew < 0) ? 0 : lu->lp[jnew] + 1;
+		}
+		done = 1;
+		p2 = (jnew < 0) ? 0 : lu->lp[jnew + 1];
+
+		for (p = pstack[head]; p < p2; p++) {
+			i = lu->li[p];
+			if (lu->mark[i] == stamp)
+				continue;
+			pstack[head] = p;
+			xi[++head] = i;
+			done = 0;
+			break;
+		}
+		if (done) {
+			head--;
+			xi[--top] = j;
+		}
+	}
+	return top;
+}
+
+/* Solve L x = A(:, col) with L being the partial factor, `x` is dense
+ * Return `top` such that xi[top..m-1] is the nonzero pattern of `x`
+ */
+static int rsplx_lu_spsolve(struct rsplx_lu *lu, const struct rsplx_csc *A, const int col,
+			    const int stamp, double *x)
+{
+	int p, px, j, J, m = A->nrow, top = A->nrow;
+	double xj;
+
+	for (p = A->colptr[col]; p < A->colptr[col + 1]; p++) {
+		if (lu->mark[A->rowidx[p]] != stamp)
+			top = rsplx_lu_dfs(lu, A->rowidx[p], top, stamp);
+	}
+	for (p = top; p < m; p++)
+		x[lu->xi[p]] = 0.;
+	for (p = A->colptr[col]; p < A->colptr[col + 1]; p++)
+		x[A->rowidx[p]] = A->values[p];
+	for (px = top; px < m; px++) {
+		j = lu->xi[px];
+		J = lu->pinv[j];
+		if (J < 0)
+			continue;
+		xj = x[j];
+		for (p = lu->lp[J] + 1; p < lu->lp[J + 1]; p++)
+			x[lu->li[p]] -= lu->lx[p] * xj;
+	}
+	return top;
+}
+
+/* Order the basis columns by their number of nonzeros, so that logical and
+ * other singleton columns are pivoted first and produce no fill-in
+ */
+static void rsplx_lu_order(struct rsplx *lp)
+{
+	int k, cnt, m = lp->m;
+	int *colcnt = lp->lu.colcnt;
+	const int *colptr = lp->A.colptr;
+
+	impf_memset(colcnt, 0, (m + 2) * sizeof(int));
+	for (k = 0; k < m; k++) {
+		cnt = colptr[lp->head[k] + 1] - colptr[lp->head[k]];
+		colcnt[__impf_MIN__(cnt, m) + 1]++;
+	}
+	for (k = 0; k < m; k++)
+		colcnt[k + 1] += colcnt[k];
+	for (k = 0; k < m; k++) {
+		cnt = colptr[lp->head[k] + 1] - colptr[lp->head[k]];
+		lp->lu.cperm[colcnt[__impf_MIN__(cnt, m)]++] = k;
+	}
+}
+
+/* LU factorization of the basis with partial pivoting (left-looking)
+ *
+ * Return:
+ *	m	on success
+ *	k < m	the `k`-th pivot column is (numerically) dependent
+ *	-1	memory allocation failure
+ */
+static int rsplx_lu_factor(struct rsplx *lp)
+{
+	struct rsplx_lu *lu = &lp->lu;
+	int m = lp->m, k, p, i, top, ipiv, lnz = 0, unz = 0;
+	double a, piv, *x = lu->work;
+
+	rsplx_lu_order(lp);
+	for (i = 0; i < m; i++) {
+		lu->pinv[i] = -1;
+		lu->mark[i] = -1;
+		x[i] = 0.;
+	}
+	for (k = 0; k < m; k++) {
+		if (rsplx_reserve(&lu->li, &lu->lx, &lu->lnzmax, lnz + m + 1) == impf_EXIT_FAILURE)
+			return -1;
+		if (rsplx_reserve(&lu->ui, &lu->ux, &lu->unzmax, unz + m + 1) == impf_EXIT_FAILURE)
+			return -1;
+		lu->lp[k] = lnz;
+		lu->up[k] = unz;
+		top = rsplx_lu_spsolve(lu, &lp->A, lp->head[lu->cperm[k]], k, x);
+		ipiv = -1;
+		a = -1.;
+
+		for (p = top; p < m; p++) {
+			i = lu->xi[p];
+			if (lu->pinv[i] < 0) {
+				if (__impf_ABS__(x[i]) > a) {
+					a = __impf_ABS__(x[i]);
+					ipiv = i;
+				}
+			} else if (x[i] != 0.) {
+				lu->ui[unz] = lu->pinv[i];
+				lu->ux[unz++] = x[i];
+			}
+		}
+		if (ipiv < 0 || a <= __impf_IDF_RSPLX_LU_ZERO__) {
+			for (p = top; p < m; p++)
+				x[lu->xi[p]] = 0.;
+			return k;
+		}
+		piv = x[ipiv];
+		lu->ui[unz] = k;
+		lu->ux[unz++] = piv;
+		lu->pinv[ipiv] = k;
+		lu->li[lnz] = ipiv;
+		lu->lx[lnz++] = 1.;
+
+		for (p = top; p < m; p++) {
+			i = lu->xi[p];
+			if (lu->pinv[i] < 0 && x[i] != 0.) {
+				lu->li[lnz] = i;
+				lu->lx[lnz++] = x[i] / piv;
+			}
+			x[i] = 0.;
+		}
+	}
+	lu->lp[m] = lnz;
+	lu->up[m] = unz;
+	for (p = 0; p < lnz; p++)  /* row indices of L in pivotal order */
+		lu->li[p] = lu->pinv[lu->li[p]];
+	lu->neta = 0;
+	lu->etap[0] = 0;
+	return m;
+}
+
+/* Solve B x = b
+ *
+ * Note: `b` is indexed by rows on input, and by basis positions on output
+ */
+static void rsplx_ftran(struct rsplx *lp, double *b)
+{
+	struct rsplx_lu *lu = &lp->lu;
+	int i, k, p, e, r, m = lp->m;
+	double wk, *w = lu->work;
+
+	for (i = 0; i < m; i++)
+		w[lu->pinv[i]] = b[i];
+	for (k = 0; k < m; k++) {
+		wk = w[k];
+		if (wk == 0.)
+			continue;
+		for (p = lu->lp[k] + 1; p < lu->lp[k + 1]; p++)
+			w[lu->li[p]] -= lu->lx[p] * wk;
+	}
+	for (k = m - 1; k >= 0; k--) {
+		if (w[k] == 0.)
+			continue;
+		wk = w[k] /= lu->ux[lu->up[k + 1] - 1];
+		for (p = lu->up[k]; p < lu->up[k + 1] - 1; p++)
+			w[lu->ui[p]] -= lu->ux[p] * wk;
+	}
+	for (k = 0; k < m; k++)
+		b[lu->cperm[k]] = w[k];
+	for (e = 0; e < lu->neta; e++) {
+		r = lu->etar[e];
+		if (b[r] == 0.)
+			continue;
+		wk = b[r] /= lu->etapiv[e];
+		for (p = lu->etap[e]; p < lu->etap[e + 1]; p++)
+			b[lu->etai[p]] -= lu->etax[p] * wk;
+	}
+}
+
+/* Solve B' y = c
+ *
+ * Note: `c` is indexed by basis positions on input, and by rows on output
+ */
+static void rsplx_btran(struct rsplx *lp, double *c)
+{
+	struct rsplx_lu *lu = &lp->lu;
+	int i, k, p, e, r, m = lp->m;
+	double s, *w = lu->work;
+
+	for (e = lu->neta - 1; e >= 0; e--) {
+		r = lu->etar[e];
+		s = c[r];
+		for (p = lu->etap[e]; p < lu->etap[e + 1]; p++)
+			s -= lu->etax[p] * c[lu->etai[p]];
+		c[r] = s / lu->etapiv[e];
+	}
+	for (k = 0; k < m; k++)
+		w[k] = c[lu->cperm[k]];
+	for (k = 0; k < m; k++) {
+		s = w[k];
+		for (p = lu->up[k]; p < lu->up[k + 1] - 1; p++)
+			s -= lu->ux[p] * w[lu->ui[p]];
+		w[k] = s / lu->ux[lu->up[k + 1] - 1];
+	}
+	for (k = m - 1; k >= 0; k--) {
+		s = w[k];
+		for (p = lu->lp[k] + 1; p < lu->lp[k + 1]; p++)
+			s -= lu->lx[p] * w[lu->li[p]];
+		w[k] = s;
+	}
+	for (i = 0; i < m; i++)
+		c[i] = w[lu->pinv[i]];
+}
+
+/* Append the eta of replacing basis position `r`, `alpha` is the FTRAN of the
+ * entering column
+ */
+static int rsplx_eta_append(struct rsplx *lp, const int r)
+{
+	struct rsplx_lu *lu = &lp->lu;
+	int i, e = lu->neta, nz = lu->etap[lu->neta];
+
+	if (rsplx_reserve(&lu->etai, &lu->etax, &lu->etanzmax, nz + lp->m) == impf_EXIT_FAILURE)
+		return impf_EXIT_FAILURE;
+	for (i = 0; i < lp->m; i++) {
+		if (i == r || lp->alpha[i] == 0.)
+			continue;
+		lu->etai[nz] = i;
+		lu->etax[nz++] = lp->alpha[i];
+	}
+	lu->etar[e] = r;
+	lu->etapiv[e] = lp->alpha[r];
+	lu->etap[e + 1] = nz;
+	lu->neta++;
+	return impf_EXIT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Simplex iterations
+ ******************************************************************************/
+
+/* Put a nonbasic variable on its bound nearest to the current value
+ */
+static void rsplx_set_nonbasic(struct rsplx *lp, const int j)
+{
+	double lb = lp->lb[j], ub = lp->ub[j];
+
+	if (lb > __impf_NINF__ && ub < __impf_INF__) {
+		if (lp->x[j] - lb <= ub - lp->x[j]) {
+			lp->stat[j] = RSPLX_AT_LB;
+			lp->x[j] = lb;
+		} else {
+			lp->stat[j] = RSPLX_AT_UB;
+			lp->x[j] = ub;
+		}
+	} else if (lb > __impf_NINF__) {
+		lp->stat[j] = RSPLX_AT_LB;
+		lp->x[j] = lb;
+	} else if (ub < __impf_INF__) {
+		lp->stat[j] = RSPLX_AT_UB;
+		lp->x[j] = ub;
+	} else {
+		lp->stat[j] = RSPLX_AT_ZERO;
+		lp->x[j] = 0.;
+	}
+}
+
+/* Start from the slack basis: all logical variables are basic
+ */
+static void rsplx_slack_basis(struct rsplx *lp)
+{
+	int i, j;
+
+	for (j = 0; j < lp->n; j++) {
+		lp->x[j] = 0.;
+		rsplx_set_nonbasic(lp, j);
+	}
+	for (i = 0; i < lp->m; i++) {
+		lp->head[i] = lp->n + i;
+		lp->stat[lp->n + i] = RSPLX_BASIC;
+	}
+}
+
+/* Compute basic variables from nonbasic ones: B x_B = - N x_N
+ */
+static void rsplx_compute_xb(struct rsplx *lp)
+{
+	int i, j, p;
+	double *rhs = lp->alpha;
+
+	impf_memset(rhs, 0, lp->m * sizeof(double));
+	for (j = 0; j < lp->nvar; j++) {
+		if (lp->stat[j] == RSPLX_BASIC || lp->x[j] == 0.)
+			continue;
+		for (p = lp->A.colptr[j]; p < lp->A.colptr[j + 1]; p++)
+			rhs[lp->A.rowidx[p]] -= lp->A.values[p] * lp->x[j];
+	}
+	rsplx_ftran(lp, rhs);
+	for (i = 0; i < lp->m; i++)
+		lp->x[lp->head[i]] = rhs[i];
+}
+
+/* Move nonbasic variables to their (changed) bounds
+ */
+static void rsplx_reset_nonbasic(struct rsplx *lp)
+{
+	int j;
+
+	for (j = 0; j < lp->nvar; j++) {
+		if (lp->stat[j] == RSPLX_AT_LB)
+			lp->x[j] = lp->lb[j];
+		else if (lp->stat[j] == RSPLX_AT_UB)
+			lp->x[j] = lp->ub[j];
+	}
+}
+
+/* Expand the bounds of variables by small pseudo-random amounts, so that
+ * ties in the ratio test of a degenerate vertex are broken
+ */
+static void rsplx_perturb(struct rsplx *lp)
+{
+	int j;
+	unsigned long seed = 1;
+	double eps;
+
+	impf_memcpy(lp->lb0, lp->lb, lp->nvar * sizeof(double));
+	impf_memcpy(lp->ub0, lp->ub, lp->nvar * sizeof(double));
+	for (j = 0; j < lp->nvar; j++) {
+		if (lp->lb[j] == lp->ub[j])
+			continue;
+		seed = (seed * 1103515245 + 12345) % 2147483648UL;
+		eps = __impf_CTR_RSPLX_PERTURB__ * (1. + (double) seed / 2147483648.);
+		if (lp->lb[j] > __impf_NINF__)
+			lp->lb[j] -= eps * (1. + __impf_ABS__(lp->lb[j]));
+		if (lp->ub[j] < __impf_INF__)
+			lp->ub[j] += eps * (1. + __impf_ABS__(lp->ub[j]));
+	}
+	rsplx_reset_nonbasic(lp);
+	rsplx_compute_xb(lp);
+	lp->perturbed = 1;
+}
+
+/* Refactorize the basis and recompute basic variables
+ *
+ * Dependent basic columns are replaced by logical variables of unpivoted rows
+ */
+static int rsplx_refactor(struct rsplx *lp, int *code)
+{
+	int k, i, pos, ntry;
+
+	for (ntry = 0; ntry <= lp->m; ntry++) {
+		k = rsplx_lu_factor(lp);
+		if (k < 0) {
+			*code = impf_MemoryAllocError;
+			return impf_EXIT_FAILURE;
+		}
+		if (k == lp->m) {
+			rsplx_compute_xb(lp);
+			return impf_EXIT_SUCCESS;
+		}
+		for (i = 0; i < lp->m; i++) {
+			if (lp->lu.pinv[i] < 0 && lp->stat[lp->n + i] != RSPLX_BASIC)
+				break;
+		}
+		if (i == lp->m)
+			break;
+#ifdef IMPF_MODE_DEV
+		impf_prt_dev(">>> Singular basis, replace %i by logical %i\n", lp->head[lp->lu.cperm[k]], i);
+#endif
+		pos = lp->lu.cperm[k];
+		rsplx_set_nonbasic(lp, lp->head[pos]);
+		lp->head[pos] = lp->n + i;
+		lp->stat[lp->n + i] = RSPLX_BASIC;
+	}
+	*code = impf_Singularity;
+	return impf_EXIT_FAILURE;
+}
+
+/* Restore the original bounds, the basis might become slightly infeasible
+ */
+static int rsplx_unperturb(struct rsplx *lp, int *code)
+{
+	impf_memcpy(lp->lb, lp->lb0, lp->nvar * sizeof(double));
+	impf_memcpy(lp->ub, lp->ub0, lp->nvar * sizeof(double));
+	lp->perturbed = 0;
+	rsplx_reset_nonbasic(lp);
+	return rsplx_refactor(lp, code);
+}
+
+/* Costs of basic variables, phase 1 minimizes the sum of infeasibilities
+ * Return 1 if the current basis is primal infeasible, 0 otherwise
+ */
+static int rsplx_basic_costs(struct rsplx *lp)
+{
+	int i, v, infeas = 0;
+	const double tol = __impf_CTR_RSPLX_PRIMAL_FEAS__;
+
+	for (i = 0; i < lp->m; i++) {
+		v = lp->head[i];
+		if (lp->x[v] < lp->lb[v] - tol) {
+			lp->cB[i] = -1.;
+			infeas = 1;
+		} else if (lp->x[v] > lp->ub[v] + tol) {
+			lp->cB[i] = 1.;
+			infeas = 1;
+		} else
+			lp->cB[i] = 0.;
+	}
+	if (!infeas) {
+		for (i = 0; i < lp->m; i++)
+			lp->cB[i] = lp->cost[lp->head[i]];
+	}
+	return infeas;
+}
+
+/* Reduced cost of variable `j` given simplex multipliers `y`
+ */
+static double rsplx_reduced_cost(const struct rsplx *lp, const int j, const int phase1)
+{
+	int p;
+	double dj = phase1 ? 0. : lp->cost[j];
+
+	for (p = lp->A.colptr[j]; p < lp->A.colptr[j + 1]; p++)
+		dj -= lp->A.values[p] * lp->y[lp->A.rowidx[p]];
+	return dj;
+}
+
+/* Pricing: choose the variable to enter basis
+ * Return the index of the variable, or -1 if no candidate is found
+ *
+ * Note: `bland` selects the candidate of the smallest index
+ */
+static int rsplx_price(const struct rsplx *lp, const int phase1, const int bland, double *dq)
+{
+	int j, q = -1;
+	double dj, best = 0.;
+	const double tol = __impf_CTR_RSPLX_DUAL_FEAS__;
+
+	for (j = 0; j < lp->nvar; j++) {
+		if (lp->stat[j] == RSPLX_BASIC || lp->lb[j] == lp->ub[j])
+			continue;
+		dj = rsplx_reduced_cost(lp, j, phase1);
+
+		switch (lp->stat[j]) {
+		case RSPLX_AT_LB:
+			if (dj >= -tol)
+				continue;
+			break;
+		case RSPLX_AT_UB:
+			if (dj <= tol)
+				continue;
+			break;
+		default:
+			if (__impf_ABS__(dj) <= tol)
+				continue;
+			break;
+		}
+		if (bland) {
+			*dq = dj;
+			return j;
+		}
+		if (__impf_ABS__(dj) > best) {
+			best = __impf_ABS__(dj);
+			q = j;
+			*dq = dj;
+		}
+	}
+	return q;
+}
+
+/* Step length for the basic variable at position `i` to reach its blocking
+ * bound relaxed by `relax`. In phase 1 an infeasible variable blocks at the
+ * bound it violates.
+ *
+ * Return 0 if the variable does not block the step
+ */
+static int rsplx_breakpoint(const struct rsplx *lp, const int i, const double relax, double *t, int *toub)
+{
+	int v = lp->head[i];
+	double dlt = lp->alpha[i], piv = __impf_ABS__(lp->alpha[i]);
+	double xv = lp->x[v], lb = lp->lb[v], ub = lp->ub[v];
+	const double ftol = __impf_CTR_RSPLX_PRIMAL_FEAS__;
+
+	if (dlt < 0.) {
+		if (xv > ub + ftol) {
+			*t = (xv - ub + relax) / piv;
+			*toub = 1;
+		} else if (lb > __impf_NINF__ && xv >= lb - ftol) {
+			*t = (xv - lb + relax) / piv;
+			*toub = 0;
+		} else
+			return 0;
+	} else {
+		if (xv < lb - ftol) {
+			*t = (lb - xv + relax) / piv;
+			*toub = 0;
+		} else if (ub < __impf_INF__ && xv <= ub + ftol) {
+			*t = (ub - xv + relax) / piv;
+			*toub = 1;
+		} else
+			return 0;
+	}
+	if (*t < 0.)
+		*t = 0.;
+	return 1;
+}
+
+/* Textbook ratio test: the nearest breakpoint, ties broken by the smallest
+ * variable index (Bland's rule)
+ */
+static int rsplx_ratio_test_bland(const struct rsplx *lp, const int q, double *theta, int *toub)
+{
+	int i, ub_i, r = -1;
+	double t, tmin = __impf_INF__;
+
+	if (lp->lb[q] > __impf_NINF__ && lp->ub[q] < __impf_INF__) {
+		tmin = lp->ub[q] - lp->lb[q];
+		r = lp->m;
+	}
+	for (i = 0; i < lp->m; i++) {
+		if (__impf_ABS__(lp->alpha[i]) < __impf_CTR_RSPLX_PIVOT__)
+			continue;
+		if (!rsplx_breakpoint(lp, i, 0., &t, &ub_i))
+			continue;
+		if (t < tmin - __impf_CHC_SPLX_DEGENERATED__
+		    || (t <= tmin + __impf_CHC_SPLX_DEGENERATED__ && r >= 0 && r < lp->m
+			&& lp->head[i] < lp->head[r])) {
+			tmin = t;
+			r = i;
+			*toub = ub_i;
+		}
+	}
+	*theta = tmin;
+	return r;
+}
+
+/* Bounded ratio test, `delta` (stored in `alpha`) is the change rate of basic
+ * variables as the entering variable `q` moves
+ *
+ * Harris' two-pass test: the first pass finds the step to the nearest bound
+ * relaxed by the feasibility tolerance, the second pass chooses the largest
+ * pivot among the variables blocking within that step.
+ *
+ * Return:
+ *	0..m-1	basis position of the leaving variable
+ *	m	the entering variable moves to its opposite bound
+ *	-1	the step is unbounded
+ */
+static int rsplx_ratio_test(const struct rsplx *lp, const int q, const int bland,
+			    double *theta, int *toub)
+{
+	int i, ub_i, r = -1;
+	double t, piv, tmax = __impf_INF__, pmax = 0.;
+
+	if (bland)
+		return rsplx_ratio_test_bland(lp, q, theta, toub);
+	for (i = 0; i < lp->m; i++) {
+		if (__impf_ABS__(lp->alpha[i]) < __impf_CTR_RSPLX_PIVOT__)
+			continue;
+		if (rsplx_breakpoint(lp, i, __impf_CTR_RSPLX_PRIMAL_FEAS__, &t, &ub_i) && t < tmax)
+			tmax = t;
+	}
+	if (lp->lb[q] > __impf_NINF__ && lp->ub[q] < __impf_INF__ && lp->ub[q] - lp->lb[q] <= tmax) {
+		*theta = lp->ub[q] - lp->lb[q];
+		return lp->m;
+	}
+	for (i = 0; i < lp->m; i++) {
+		piv = __impf_ABS__(lp->alpha[i]);
+		if (piv < __impf_CTR_RSPLX_PIVOT__ || piv <= pmax)
+			continue;
+		if (rsplx_breakpoint(lp, i, 0., &t, &ub_i) && t <= tmax) {
+			pmax = piv;
+			r = i;
+			*theta = t;
+			*toub = ub_i;
+		}
+	}
+	return r;
+}
+
+/* Pivot: variable `q` enters basis along direction `dir` with step `theta`,
+ * the basic variable at position `r` leaves (`r == m` for a bound flip)
+ */
+static int rsplx_pivot(struct rsplx *lp, const int q, const int dir, const int r,
+		       const double theta, const int toub, int *code)
+{
+	int i, v;
+
+	lp->x[q] += dir * theta;
+	for (i = 0; i < lp->m; i++)
+		lp->x[lp->head[i]] += theta * lp->alpha[i];
+	if (r == lp->m) {
+		lp->stat[q] = (lp->stat[q] == RSPLX_AT_LB) ? RSPLX_AT_UB : RSPLX_AT_LB;
+		lp->x[q] = (lp->stat[q] == RSPLX_AT_LB) ? lp->lb[q] : lp->ub[q];
+		return impf_EXIT_SUCCESS;
+	}
+	v = lp->head[r];
+	if (toub && lp->lb[v] != lp->ub[v]) {
+		lp->stat[v] = RSPLX_AT_UB;
+		lp->x[v] = lp->ub[v];
+	} else {
+		lp->stat[v] = RSPLX_AT_LB;
+		lp->x[v] = toub ? lp->ub[v] : lp->lb[v];
+	}
+	lp->head[r] = q;
+	lp->stat[q] = RSPLX_BASIC;
+
+	for (i = 0; i < lp->m; i++)  /* recover FTRAN column from the direction */
+		lp->alpha[i] *= -dir;
+	if (rsplx_eta_append(lp, r) == impf_EXIT_FAILURE) {
+		*code = impf_MemoryAllocError;
+		return impf_EXIT_FAILURE;
+	}
+	if (lp->lu.neta >= __impf_CTR_RSPLX_REFACTOR__)
+		return rsplx_refactor(lp, code);
+	return impf_EXIT_SUCCESS;
+}
+
+/* Check the reduced cost of the entering variable `q` against the one
+ * recomputed from its FTRAN column (stored in `alpha`)
+ *
+ * Return 0 if they disagree, or the recomputed one is not attractive, and the
+ * basis should be refactorized
+ */
+static int rsplx_check_price(const struct rsplx *lp, const int q, const int phase1, const double dq)
+{
+	int i;
+	double dq2 = phase1 ? 0. : lp->cost[q];
+
+	if (lp->lu.neta == 0)
+		return 1;
+	for (i = 0; i < lp->m; i++)
+		dq2 -= lp->cB[i] * lp->alpha[i];
+	if (dq * dq2 <= 0. || __impf_ABS__(dq2) <= __impf_CTR_RSPLX_DUAL_FEAS__)
+		return 0;
+	return __impf_ABS__(dq - dq2) <= __impf_CTR_RSPLX_PRICE__ * (1. + __impf_ABS__(dq));
+}
+
+/* Iterate the composite (phase 1 + phase 2) primal revised simplex
+ */
+static int rsplx_iterate(struct rsplx *lp, const int bland_only, const int niter, int *epoch, int *code)
+{
+	int i, p, q, r, dir, toub = 0, phase1, ndegen = 0, nperturb = 0;
+	double dq, theta;
+
+	while (*epoch < niter) {
+		phase1 = rsplx_basic_costs(lp);
+		impf_memcpy(lp->y, lp->cB, lp->m * sizeof(double));
+		rsplx_btran(lp, lp->y);
+		q = rsplx_price(lp, phase1, bland_only || ndegen > __impf_CTR_RSPLX_DEGEN__, &dq);
+
+		if (q < 0) {
+			if (lp->lu.neta > 0) {  /* confirm with a fresh factorization */
+				if (rsplx_refactor(lp, code) == impf_EXIT_FAILURE)
+					return impf_EXIT_FAILURE;
+				continue;
+			}
+			if (lp->perturbed && !phase1) {
+				if (rsplx_unperturb(lp, code) == impf_EXIT_FAILURE)
+					return impf_EXIT_FAILURE;
+				continue;
+			}
+			if (phase1) {
+				*code = impf_Infeasibility;
+				return impf_EXIT_FAILURE;
+			}
+			*code = impf_Success;
+			return impf_EXIT_SUCCESS;
+		}
+		(*epoch)++;
+		dir = dq < 0. ? 1 : -1;
+		impf_memset(lp->alpha, 0, lp->m * sizeof(double));
+		for (p = lp->A.colptr[q]; p < lp->A.colptr[q + 1]; p++)
+			lp->alpha[lp->A.rowidx[p]] = lp->A.values[p];
+		rsplx_ftran(lp, lp->alpha);
+		if (rsplx_check_price(lp, q, phase1, dq) == 0) {
+			if (rsplx_refactor(lp, code) == impf_EXIT_FAILURE)
+				return impf_EXIT_FAILURE;
+			continue;
+		}
+		for (i = 0; i < lp->m; i++)  /* direction of basic variables */
+			lp->alpha[i] *= -dir;
+		r = rsplx_ratio_test(lp, q, bland_only || ndegen > __impf_CTR_RSPLX_DEGEN__, &theta, &toub);
+
+		if (r < 0) {
+			*code = phase1 ? impf_PrecisionError : impf_Unboundedness;
+			return impf_EXIT_FAILURE;
+		}
+		ndegen = (theta <= __impf_CHC_SPLX_DEGENERATED__) ? ndegen + 1 : 0;
+		if (ndegen > __impf_CTR_RSPLX_DEGEN__ && nperturb == 0 && !bland_only) {
+			rsplx_perturb(lp);
+			nperturb++;
+			ndegen = 0;
+		}
+		if (rsplx_pivot(lp, q, dir, r, theta, toub, code) == impf_EXIT_FAILURE)
+			return impf_EXIT_FAILURE;
+	}
+	*code = impf_ExceedIterLimit;
+	return impf_EXIT_FAILURE;
+}
+
+/*******************************************************************************
+ * Dual simplex
+ ******************************************************************************/
+
+/* Load the basis, where `basis[i]` is a variable (< n) or the logical variable
+ * `n + k` of constraint `k`
+ *
+ * Return `EXIT_FAILURE` if `basis` is not a set of m distinct variables
+ */
+static int rsplx_load_basis(struct rsplx *lp, const int *basis)
+{
+	int i, j;
+
+	for (j = 0; j < lp->nvar; j++)
+		lp->stat[j] = RSPLX_AT_LB;
+	for (i = 0; i < lp->m; i++) {
+		j = basis[i];
+		if (j < 0 || j >= lp->nvar || lp->stat[j] == RSPLX_BASIC)
+			return impf_EXIT_FAILURE;
+		lp->stat[j] = RSPLX_BASIC;
+		lp->head[i] = j;
+	}
+	for (j = 0; j < lp->nvar; j++) {
+		lp->x[j] = 0.;
+		if (lp->stat[j] != RSPLX_BASIC)
+			rsplx_set_nonbasic(lp, j);
+	}
+	return impf_EXIT_SUCCESS;
+}
+
+/* Place boxed nonbasic variables at the bound where their reduced costs are
+ * dual feasible, multipliers `y` should be computed from the true costs
+ *
+ * Return 1 if the basis is dual feasible, 0 otherwise
+ */
+static int rsplx_dual_bounds(struct rsplx *lp)
+{
+	int j, feas = 1;
+	double dj, lb, ub;
+	const double tol = __impf_CTR_RSPLX_DUAL_FEAS__;
+
+	for (j = 0; j < lp->nvar; j++) {
+		lb = lp->lb[j];
+		ub = lp->ub[j];
+		if (lp->stat[j] == RSPLX_BASIC || lb == ub)
+			continue;
+		dj = rsplx_reduced_cost(lp, j, 0);
+
+		if (lb > __impf_NINF__ && ub < __impf_INF__) {
+			lp->stat[j] = (dj >= 0.) ? RSPLX_AT_LB : RSPLX_AT_UB;
+			lp->x[j] = (dj >= 0.) ? lb : ub;
+		} else if (lb > __impf_NINF__) {
+			if (dj < -tol)
+				feas = 0;
+		} else if (ub < __impf_INF__) {
+			if (dj > tol)
+				feas = 0;
+		} else if (__impf_ABS__(dj) > tol)
+			feas = 0;
+	}
+	return feas;
+}
+
+/* Dual pricing: choose the basic variable of the largest infeasibility to
+ * leave basis
+ * Return the basis position, or -1 if the basis is primal feasible
+ */
+static int rsplx_dual_price(const struct rsplx *lp)
+{
+	int i, v, r = -1;
+	double infeas, best = __impf_CTR_RSPLX_PRIMAL_FEAS__;
+
+	for (i = 0; i < lp->m; i++) {
+		v = lp->head[i];
+		if (lp->x[v] < lp->lb[v])
+			infeas = lp->lb[v] - lp->x[v];
+		else if (lp->x[v] > lp->ub[v])
+			infeas = lp->x[v] - lp->ub[v];
+		else
+			continue;
+		if (infeas > best) {
+			best = infeas;
+			r = i;
+		}
+	}
+	return r;
+}
+
+/* Dual ratio test (Harris' two-pass), the leaving variable moves up to its
+ * lower bound if `s = 1`, or down to its upper bound if `s = -1`
+ *
+ * Row `rho` of the basis inverse should be computed, the row of the simplex
+ * table is stored in `arow`. The entering variable moves along `dir`.
+ *
+ * Return the entering variable, or -1 if the LP is primal infeasible
+ */
+static int rsplx_dual_ratio_test(struct rsplx *lp, const int s, int *dir)
+{
+	int j, p, q = -1;
+	double arj, dj, tmax = __impf_INF__, amax = 0.;
+	const double tol = __impf_CTR_RSPLX_DUAL_FEAS__;
+	double *arow = lp->arow;
+
+	for (j = 0; j < lp->nvar; j++) {
+		arow[j] = 0.;
+		if (lp->stat[j] == RSPLX_BASIC || lp->lb[j] == lp->ub[j])
+			continue;
+		for (p = lp->A.colptr[j]; p < lp->A.colptr[j + 1]; p++)
+			arow[j] += lp->A.values[p] * lp->rho[lp->A.rowidx[p]];
+		arj = arow[j];
+		if (__impf_ABS__(arj) < __impf_CTR_RSPLX_PIVOT__
+		    || (lp->stat[j] == RSPLX_AT_LB && s * arj >= 0.)
+		    || (lp->stat[j] == RSPLX_AT_UB && s * arj <= 0.)) {
+			arow[j] = 0.;
+			continue;
+		}
+		dj = __impf_ABS__(rsplx_reduced_cost(lp, j, 0));
+		if ((dj + tol) / __impf_ABS__(arj) < tmax)
+			tmax = (dj + tol) / __impf_ABS__(arj);
+	}
+	for (j = 0; j < lp->nvar; j++) {
+		arj = __impf_ABS__(arow[j]);
+		if (arj <= amax)
+			continue;
+		dj = __impf_ABS__(rsplx_reduced_cost(lp, j, 0));
+		if (dj / arj <= tmax) {
+			amax = arj;
+			q = j;
+		}
+	}
+	if (q >= 0)
+		*dir = (s * arow[q] < 0.) ? 1 : -1;
+	return q;
+}
+
+/* Iterate the dual revised simplex until the basis is primal feasible
+ */
+static int rsplx_dual_iterate(struct rsplx *lp, const int niter, int *epoch, int *code)
+{
+	int i, p, q, r, s, v, dir;
+	double theta;
+
+	while (*epoch < niter) {
+		r = rsplx_dual_price(lp);
+		if (r < 0) {
+			if (lp->lu.neta > 0) {  /* confirm with a fresh factorization */
+				if (rsplx_refactor(lp, code) == impf_EXIT_FAILURE)
+					return impf_EXIT_FAILURE;
+				if (rsplx_dual_price(lp) >= 0)
+					continue;
+			}
+			return impf_EXIT_SUCCESS;
+		}
+		(*epoch)++;
+		v = lp->head[r];
+		s = (lp->x[v] < lp->lb[v]) ? 1 : -1;
+		for (i = 0; i < lp->m; i++)
+			lp->cB[i] = lp->cost[lp->head[i]];
+		impf_memcpy(lp->y, lp->cB, lp->m * sizeof(double));
+		rsplx_btran(lp, lp->y);
+		impf_memset(lp->rho, 0, lp->m * sizeof(double));
+		lp->rho[r] = 1.;
+		rsplx_btran(lp, lp->rho);
+		q = rsplx_dual_ratio_test(lp, s, &dir);
+
+		if (q < 0) {
+			if (lp->lu.neta > 0) {
+				if (rsplx_refactor(lp, code) == impf_EXIT_FAILURE)
+					return impf_EXIT_FAILURE;
+				continue;
+			}
+			*code = impf_Infeasibility;
+			return impf_EXIT_FAILURE;
+		}
+		impf_memset(lp->alpha, 0, lp->m * sizeof(double));
+		for (p = lp->A.colptr[q]; p < lp->A.colptr[q + 1]; p++)
+			lp->alpha[lp->A.rowidx[p]] = lp->A.values[p];
+		rsplx_ftran(lp, lp->alpha);
+		if (lp->lu.neta > 0 && __impf_ABS__(lp->alpha[r] - lp->arow[q])
+		    > __impf_CTR_RSPLX_PRICE__ * (1. + __impf_ABS__(lp->arow[q]))) {
+			if (rsplx_refactor(lp, code) == impf_EXIT_FAILURE)
+				return impf_EXIT_FAILURE;
+			continue;
+		}
+		theta = (s > 0) ? lp->lb[v] - lp->x[v] : lp->x[v] - lp->ub[v];
+		theta /= __impf_ABS__(lp->alpha[r]);
+		for (i = 0; i < lp->m; i++)  /* direction of basic variables */
+			lp->alpha[i] *= -dir;
+		if (rsplx_pivot(lp, q, dir, r, theta, s < 0, code) == impf_EXIT_FAILURE)
+			return impf_EXIT_FAILURE;
+	}
+	*code = impf_ExceedIterLimit;
+	return impf_EXIT_FAILURE;
+}
+
+/* Copy out the solution of structural variables
+ */
+static void rsplx_solution(const struct rsplx *lp, double *x, double *value)
+{
+	int j;
+
+	*value = 0.;
+	for (j = 0; j < lp->n; j++) {
+		x[j] = lp->x[j];
+		*value += lp->cost[j] * x[j];
+	}
+}
+
+static int rsplx_solve(struct rsplx *lp, const char *criteria, const int niter, double *x, double *value, int *code)
+{
+	int epoch = 0, bland = 0;
+
+	if (5 == impf_strlen(criteria) && 0 == impf_memcmp("bland", criteria, 5))
+		bland = 1;
+	rsplx_slack_basis(lp);
+	if (rsplx_refactor(lp, code) == impf_EXIT_FAILURE)
+		return impf_EXIT_FAILURE;
+	if (rsplx_iterate(lp, bland, niter, &epoch, code) == impf_EXIT_FAILURE)
+		return impf_EXIT_FAILURE;
+#ifdef IMPF_MODE_DEV
+	impf_prt_dev(">>> Revised simplex done, niter = %i\n", epoch);
+#endif
+	rsplx_solution(lp, x, value);
+	return impf_EXIT_SUCCESS;
+}
+
+int impf_lp_simplex_rev(const double *objective, const struct impf_LinearConstraint *constraints,
+			const struct impf_VariableBound *bounds,
+			const int m, const int n, const char *criteria, const int niter,
+			double *x, double *value, int *code)
+{
+	struct rsplx lp;
+	int state;
+
+	assert(objective != NULL);
+	assert(constraints != NULL);
+	assert(x != NULL);
+	assert(value != NULL);
+	assert(code != NULL);
+
+	if (rsplx_load_dense(&lp, objective, constraints, bounds, m, n) == impf_EXIT_FAILURE) {
+		*code = impf_MemoryAllocError;
+		return impf_EXIT_FAILURE;
+	}
+	state = rsplx_solve(&lp, criteria, niter, x, value, code);
+	rsplx_free(&lp);
+	return state;
+}
+
+int impf_lp_simplex_csc(const double *objective, const int *colptr, const int *rowidx, const double *values,
+			const struct impf_LinearConstraint *constraints,
+			const struct impf_VariableBound *bounds,
+			const int m, const int n, const char *criteria, const int niter,
+			double *x, double *value, int *code)
+{
+	struct rsplx lp;
+	int state;
+
+	assert(objective != NULL);
+	assert(colptr != NULL);
+	assert(rowidx != NULL);
+	assert(values != NULL);
+	assert(constraints != NULL);
+	assert(x != NULL);
+	assert(value != NULL);
+	assert(code != NULL);
+
+	if (rsplx_load_csc(&lp, objective, colptr, rowidx, values, constraints, bounds, m, n) == impf_EXIT_FAILURE) {
+		*code = impf_MemoryAllocError;
+		return impf_EXIT_FAILURE;
+	}
+	state = rsplx_solve(&lp, criteria, niter, x, value, code);
+	rsplx_free(&lp);
+	return state;
+}
+
+int impf_lp_simplex_dual(const double *objective, const struct impf_LinearConstraint *constraints,
+			 const struct impf_VariableBound *bounds, const int m, const int n, const int niter,
+			 int *basis, double *x, double *value, int *code)
+{
+	struct rsplx lp;
+	int i, dfeas, epoch = 0, state = impf_EXIT_FAILURE;
+
+	assert(objective != NULL);
+	assert(constraints != NULL);
+	assert(basis != NULL);
+	assert(x != NULL);
+	assert(value != NULL);
+	assert(code != NULL);
+
+	if (rsplx_load_dense(&lp, objective, constraints, bounds, m, n) == impf_EXIT_FAILURE) {
+		*code = impf_MemoryAllocError;
+		return impf_EXIT_FAILURE;
+	}
+	if (rsplx_load_basis(&lp, basis) == impf_EXIT_FAILURE) {
+		rsplx_free(&lp);
+		*code = impf_CondUnsatisfied;
+		return impf_EXIT_FAILURE;
+	}
+	if (rsplx_refactor(&lp, code) == impf_EXIT_FAILURE)
+		goto END;
+	for (i = 0; i < m; i++)
+		lp.cB[i] = lp.cost[lp.head[i]];
+	impf_memcpy(lp.y, lp.cB, m * sizeof(double));
+	rsplx_btran(&lp, lp.y);
+	dfeas = rsplx_dual_bounds(&lp);
+	rsplx_compute_xb(&lp);
+	if (dfeas) {
+		if (rsplx_dual_iterate(&lp, niter, &epoch, code) == impf_EXIT_FAILURE)
+			goto END;
+#ifdef IMPF_MODE_DEV
+		impf_prt_dev(">>> Dual simplex done, niter = %i\n", epoch);
+#endif
+	}
+	/* the primal simplex removes remaining dual infeasibilities */
+	if (rsplx_iterate(&lp, 0, niter, &epoch, code) == impf_EXIT_FAILURE)
+		goto END;
+	rsplx_solution(&lp, x, value);
+	state = impf_EXIT_SUCCESS;
+END:
+	impf_memcpy(basis, lp.head, m * sizeof(int));
+	rsplx_free(&lp);
+	return state;
+}
@@ -5,16 +5,90 @@
 #include <impf/_magics.h>
 #include <impf/linalg.h>
 #include <impf/fmin_lp.h>
-#ifdef IMPF_MODE_DEV
-#include <stdio.h>
+#include <math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Pricing and anti-degeneracy state of simplex table, kept across pivots
+ *
+ *	weights		pricing weights of columns ("devex", "steepest")
+ *	dots		buffer of `y_q' y_j` of columns ("steepest")
+ *	norms		squared norms of the original columns ("pan97")
+ *	isbasic		whether a column is basic
+ *	cands		candidate list of multiple pricing ("partial")
+ *	degen		rows of degenerate basic variables ("pan97")
+ *	shift		perturbation of the rhs column (rows 0, ..., m) in the
+ *			current basis
+ *	col		column of the entering variable followed by the rhs
+ *			column (rows 0, ..., m each), gathered once per pivot
+ *			from a row-major table
+ *	colq, rhs	column of the entering variable and the rhs column
+ *			(rows 0, ..., m), contiguous, read by the ratio test
+ *	nzval, nzidx	nonzeros of the pivot row and their column indices, or
+ *			of column q and their row indices (see
+ *			`simplex_update_weights`)
+ *	cols		column-major table of the pivot loop (rows 0, ..., m),
+ *			or `NULL` if the loop runs on the row-major table
+ *	row0		row 0 of the table being pivoted, read by pricing
+ *	rs, cs		strides of rows and columns of the table being pivoted,
+ *			i.e. entry (i, j) is `table[i * rs + j * cs]`
+ *	bycol		whether the table being pivoted is `cols`
+ *	perturbed	whether `shift` is active
+ *	nthreads	number of threads sharing the loops over rows or columns
+ *			of simplex table (see `impf_LP_Workspace`)
+ *	bland		whether pricing fell back to Bland's rule
+ *	ncand		length of the candidate list
+ *	start		first column of the next window of partial pricing
+ *	rule		pricing rule resolved from `criteria`
+ *	state		state passed to the callbacks of `rule`
+ */
+struct simplex_price {
+	double *weights;
+	double *dots;
+	double *norms;
+	int *isbasic;
+	int *cands;
+	int *degen;
+	double *shift;
+	double *col;
+	double *colq;
+	double *rhs;
+	double *nzval;
+	int *nzidx;
+	double *cols;
+	double *row0;
+	int rs;
+	int cs;
+	int bycol;
+	int perturbed;
+	int nthreads;
+	int bland;
+	int ncand;
+	int start;
+	const struct impf_PricingRule *rule;
+	void *state;
+};
+
+/* Number of threads (at most `nthreads`) sharing a loop touching `nwork`
+ * entries of simplex table, so that each thread takes at least
+ * `__impf_CTR_SPLX_PARALLEL__` entries. The loop is shared if it is above 1
+ *
+ * Note: each thread takes a contiguous block of the loop and the results of
+ *	threads are combined in a fixed order, so that the pivots do not depend
+ *	on the number of threads
+ */
+#ifdef _OPENMP
+#define simplex_nshare(nthreads, nwork) \
+	__impf_MAX__(1, __impf_MIN__((nthreads), (nwork) / __impf_CTR_SPLX_PARALLEL__))
 #endif
 
-static int is_simplex_optimal(const double *table, const int n)
+static int is_simplex_optimal(const double *table, const int *isbasic, const int n)
 {
 	int j;
 
 	for (j = 0; j < n; j++) {
-		if (table[j] > __impf_CTR_SPLX_OPTIMAL__)
+		if (table[j] > __impf_CTR_SPLX_OPTIMAL__ && !isbasic[j])
 			return 0;
 	}
 	return 1;
@@ -24,7 +98,7 @@ static int is_simplex_optimal(const double *table, const int n)
  */
 static int is_basis_valid(const int *basis, const int m, const int n)
 {
-	return maxabs_arri(basis, m, 1) <= n;
+	return maxabs_arri(basis, m, 1) < n;
 }
 
 /* In simplex iteration, check whether value is improved.
@@ -34,127 +108,1019 @@ static int is_basis_valid(const int *basis, const int m, const int n)
  *     1    circled but optimal already
  *     2    circled
  */
-static int check_simplex_degenerated(const double *table, const int n, const double old_value)
+static int check_simplex_degenerated(const double *table, const int *isbasic, const int n,
+				     const double old_value)
+{
+	if (old_value <= table[n] + __impf_CHC_SPLX_DEGENERATED__) {
+		if (is_simplex_optimal(table, isbasic, n))
+			return 1;
+		return 2;
+	} else
+		return 0;
+}
+
+/* Ratio of basic variable of row `i` when variable `q` enters basis, i.e. the
+ * step before it blocks at 0 (`*toub = 0`) or at its upper bound (`*toub = 1`),
+ * where the bound is relaxed by `tol`
+ * Return `__impf_INF__` if it never blocks
+ */
+static double simplex_ratio(const double *colq, const double *rhs, const int *basis, const double *ub,
+			    const int i, const double tol, int *toub)
+{
+	double y_i_0 = rhs[i + 1];
+	double y_i_q = colq[i + 1];
+
+	*toub = 0;
+	if (y_i_q > __impf_CTR_SPLX_PIV_LEV__)
+		return (__impf_MAX__(y_i_0, 0.) + tol) / y_i_q;
+	if (y_i_q < -__impf_CTR_SPLX_PIV_LEV__ && ub[basis[i]] < __impf_INF__) {
+		*toub = 1;
+		return (__impf_MAX__(ub[basis[i]] - y_i_0, 0.) + tol) / (-y_i_q);
+	}
+	return __impf_INF__;
+}
+
+/* Choose the variable to leave basis by Harris' two-pass ratio test
+ * Return the index of the variable and check weather LP is "bounded"
+ *
+ * Pass 1 finds the largest step `theta` keeping all basic variables within
+ * their bounds relaxed by `__impf_CTR_SPLX_HARRIS__`, pass 2 chooses, among
+ * the rows blocking no later than `theta`, the one of the largest pivot
+ *
+ * Both passes read column `q` and the rhs from `colq` and `rhs` (see
+ * `simplex_gather`)
+ *
+ * Note:
+ *	1. a basic variable blocks either at 0 or at its upper bound `ub`, the
+ *		latter is reported by `toub`
+ *	2. return `m` if the entering variable reaches its own upper bound
+ *		within `theta` (bound flip), which needs no pivot at all
+ */
+static int simplex_pivot_leave_rule(const double *colq, const double *rhs, const int *basis,
+				    const double *ub, const int m, const int n, const int q,
+				    const int nthreads, int *bounded, int *toub)
+{
+	int p = n;
+	double theta = __impf_INF__, max_y_iq = 0.;
+
+	*bounded = ub[q] < __impf_INF__;
+	*toub = 0;
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(simplex_nshare(nthreads, m)) if (simplex_nshare(nthreads, m) > 1)
+#endif
+	{
+		int i, ub_i;
+		double x_iq, theta_t = __impf_INF__;
+
+#ifdef _OPENMP
+#pragma omp for
+#endif
+		for (i = 0; i < m; i++) {
+			x_iq = simplex_ratio(colq, rhs, basis, ub, i, __impf_CTR_SPLX_HARRIS__, &ub_i);
+			if (x_iq < theta_t)
+				theta_t = x_iq;
+		}
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+		if (theta_t < theta)
+			theta = theta_t;
+	}
+	if (theta < __impf_INF__)
+		*bounded = 1;
+	if (ub[q] <= theta)
+		return m;
+#ifdef _OPENMP
+#pragma omp parallel num_threads(simplex_nshare(nthreads, m)) if (simplex_nshare(nthreads, m) > 1)
+#endif
+	{
+		int i, ub_i, p_t = n, toub_t = 0;
+		double x_iq, y_i_q, max_t = 0.;
+
+#ifdef _OPENMP
+#pragma omp for
+#endif
+		for (i = 0; i < m; i++) {
+			x_iq = simplex_ratio(colq, rhs, basis, ub, i, 0., &ub_i);
+			y_i_q = __impf_ABS__(colq[i + 1]);
+
+			if (x_iq <= theta && y_i_q > max_t) {
+				max_t = y_i_q;
+				p_t = i;
+				toub_t = ub_i;
+			}
+		}
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+		if (max_t > max_y_iq || (max_t == max_y_iq && p_t < p)) {
+			max_y_iq = max_t;
+			p = p_t;
+			*toub = toub_t;
+		}
+	}
+	return p;
+}
+
+/* Fast pivot rule: choosing the variable to enter basis
+ * Return the index of the variable (< n)
+ *
+ * Note:
+ * 	On failure, the algorithm returns `n`. Logically, this NEVER happens,
+ *	but numerically, there are many criteriors reporting optimality,
+ *	leading to unpredicted results
+ */
+static int simplex_pivot_enter_rule_datzig(const double *table, const int *isbasic, const int n,
+					   const int nthreads)
+{
+	int q = n;
+	double beta_q = 0.;
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(simplex_nshare(nthreads, n)) if (simplex_nshare(nthreads, n) > 1)
+#endif
+	{
+		int j, q_t = n;
+		double beta_j, beta_t = 0.;
+
+#ifdef _OPENMP
+#pragma omp for
+#endif
+		for (j = 0; j < n; j++) {
+			if (isbasic[j])
+				continue;
+			beta_j = table[j];
+
+			if (beta_j > beta_t) {
+				q_t = j;
+				beta_t = beta_j;
+			}
+		}
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+		if (beta_t > beta_q || (beta_t == beta_q && q_t < q)) {
+			q = q_t;
+			beta_q = beta_t;
+		}
+	}
+	return q; /* return n if no p is found (optimal already) */
+}
+
+/* Bland's rule: choosing the variable to enter basis
+ * Return the index of the variable (< n)
+ *
+ * Note: on failure, the algorithm returns n
+ */
+static int simplex_pivot_enter_rule_bland(const double *table, const int *isbasic, const int n)
+{
+	int j;
+	double epsilon = __impf_CTR_SPLX_BLAND_EPS__;
+BLAND_BEGIN:
+	for (j = 0; j < n; j++) {
+		if (!isbasic[j]) {
+			if (table[j] > epsilon)
+				return j;
+		}
+	}
+	if (epsilon >= __impf_CTR_SPLX_BLAND_EPS_MIN__) {
+		epsilon /= 10.;
+		goto BLAND_BEGIN;
+	} else
+		return n;
+}
+
+/* Normalized pivot rules: choosing the variable to enter basis by the largest
+ * `beta_j^2 / w_j`, where `w_j` is the (approximate) squared norm of the edge
+ * direction of variable j
+ * Return the index of the variable (< n)
+ *
+ * Note: on failure, the algorithm returns n
+ */
+static int simplex_pivot_enter_rule_weighted(const double *table, const int *isbasic, const double *weights,
+					     const int n, const int nthreads)
+{
+	int q = n;
+	double best = 0.;
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(simplex_nshare(nthreads, n)) if (simplex_nshare(nthreads, n) > 1)
+#endif
+	{
+		int j, q_t = n;
+		double beta_j, score, best_t = 0.;
+
+#ifdef _OPENMP
+#pragma omp for
+#endif
+		for (j = 0; j < n; j++) {
+			beta_j = table[j];
+			if (beta_j <= 0. || isbasic[j])
+				continue;
+			score = beta_j * beta_j / weights[j];
+
+			if (score > best_t) {
+				q_t = j;
+				best_t = score;
+			}
+		}
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+		if (best_t > best || (best_t == best && q_t < q)) {
+			q = q_t;
+			best = best_t;
+		}
+	}
+	return q;
+}
+
+/* Find degenerate basic variables, i.e. those at 0 (recorded as `i`) or at
+ * their upper bounds (recorded as `-i - 1`), where `i` is the row index
+ * Return the number of degenerate basic variables
+ */
+static int find_bv_degenerated(const double *table, const int rs, const int cs, const int *basis,
+			       const double *ub, const int m, const int n, int *degen)
+{
+	int i, ndegen = 0;
+	double y_i_0;
+
+	for (i = 0; i < m; i++) {
+		y_i_0 = table[n * cs + (i + 1) * rs];
+
+		if (y_i_0 <= __impf_CTR_SPLX_PAN_DEGEN__)
+			degen[ndegen++] = i;
+		else if (ub[basis[i]] < __impf_INF__ && ub[basis[i]] - y_i_0 <= __impf_CTR_SPLX_PAN_DEGEN__)
+			degen[ndegen++] = -i - 1;
+	}
+	return ndegen;
+}
+
+/* Whether variable j could enter basis with a positive step, i.e. no
+ * degenerate basic variable blocks it in the ratio test
+ */
+static int is_step_positive(const double *table, const int rs, const int cs, const int *degen,
+			    const int ndegen, const int j)
+{
+	int k, i;
+
+	for (k = 0; k < ndegen; k++) {
+		if (degen[k] >= 0) {
+			i = degen[k];
+			if (table[j * cs + (i + 1) * rs] > __impf_CTR_SPLX_PIV_LEV__)
+				return 0;
+		} else {
+			i = -degen[k] - 1;
+			if (table[j * cs + (i + 1) * rs] < -__impf_CTR_SPLX_PIV_LEV__)
+				return 0;
+		}
+	}
+	return 1;
+}
+
+/* Pan's rule: choosing the variable to enter basis
+ * Return the index of the variable (< n)
+ *
+ * Note:
+ *	1. candidates are ranked by the largest-distance criterion
+ *		`beta_j / ||a_j||`, where `a_j` is the original column of
+ *		variable j, which is scale invariant and costs no more than
+ *		Dantzig's rule
+ *	2. following the basis-deficiency idea of Pan (1998), degenerate basic
+ *		variables are treated as not in basis, a candidate is preferred
+ *		if its column lies in the range of the nondegenerate part, so
+ *		that the pivot moves with a positive step; only if there is no
+ *		such candidate a degenerate pivot is taken
+ *	3. on failure, the algorithm returns n
+ */
+static int simplex_pivot_enter_rule_pan(const double *table, const int *basis,
+					const double *ub, struct simplex_price *price,
+					const int m, const int n)
+{
+	int j, q = n, q_pos = n;
+	int ndegen = find_bv_degenerated(table, price->rs, price->cs, basis, ub, m, n, price->degen);
+	double beta_j, score, best = 0., best_pos = 0.;
+
+	for (j = 0; j < n; j++) {
+		beta_j = price->row0[j];
+		if (beta_j <= __impf_CTR_SPLX_OPTIMAL__ || price->isbasic[j])
+			continue;
+		score = beta_j * beta_j / price->norms[j];
+
+		if (score > best) {
+			q = j;
+			best = score;
+		}
+		if (score > best_pos && is_step_positive(table, price->rs, price->cs, price->degen, ndegen, j)) {
+			q_pos = j;
+			best_pos = score;
+		}
+	}
+	return q_pos < n ? q_pos : q;
+}
+
+/* Squared norms of the original columns of simplex table, used by Pan's rule
+ */
+static void simplex_init_norms(const double *table, const int ldtable, const int m, const int n,
+			       double *norms)
+{
+	int i, j;
+
+	for (j = 0; j < n; j++)
+		norms[j] = 0.;
+	for (i = 0; i < m; i++) {
+		const double *rowi = table + (i + 1) * ldtable;
+
+		for (j = 0; j < n; j++)
+			norms[j] += rowi[j] * rowi[j];
+	}
+	for (j = 0; j < n; j++) {
+		if (norms[j] < __impf_IDF_SPLX_ZEROS_BETA__)
+			norms[j] = 1.;
+	}
+}
+
+/* Put column j into the candidate list of multiple pricing, replacing the
+ * least attractive candidate if the list is full
+ */
+static void simplex_push_cand(const double *table, struct simplex_price *price, const int j)
+{
+	int k, kmin = 0;
+
+	if (price->ncand < __impf_CTR_SPLX_PRICE_CANDS__) {
+		price->cands[price->ncand++] = j;
+		return;
+	}
+	for (k = 1; k < price->ncand; k++) {
+		if (table[price->cands[k]] < table[price->cands[kmin]])
+			kmin = k;
+	}
+	if (table[j] > table[price->cands[kmin]])
+		price->cands[kmin] = j;
+}
+
+/* Partial and multiple pricing: choosing the variable to enter basis
+ * Return the index of the variable (< n)
+ *
+ * Note:
+ *	1. minor iteration: the most attractive variable of the candidate list
+ *		is chosen, unattractive ones are dropped from the list
+ *	2. major iteration: when the list is empty, it is refilled by scanning
+ *		windows of columns, starting from where the last scan stopped,
+ *		until attractive variables are found
+ *	3. on failure (all columns are scanned), the algorithm returns n
+ */
+static int simplex_pivot_enter_rule_partial(const double *table, struct simplex_price *price, const int n)
+{
+	int j, k, nscan, q = n;
+	int nwin = (n + __impf_CTR_SPLX_PRICE_SEGS__ - 1) / __impf_CTR_SPLX_PRICE_SEGS__;
+	double beta_q = __impf_CTR_SPLX_OPTIMAL__;
+
+	for (k = 0, j = 0; k < price->ncand; k++) {
+		int c = price->cands[k];
+
+		if (price->isbasic[c] || table[c] <= __impf_CTR_SPLX_OPTIMAL__)
+			continue;
+		price->cands[j++] = c;
+		if (table[c] > beta_q) {
+			q = c;
+			beta_q = table[c];
+		}
+	}
+	price->ncand = j;
+	if (q < n)
+		return q;
+
+	j = price->start < n ? price->start : 0;
+	for (nscan = 0; nscan < n; nscan++) {
+		if (nscan % nwin == 0 && price->ncand > 0)
+			break;
+		if (!price->isbasic[j] && table[j] > __impf_CTR_SPLX_OPTIMAL__) {
+			simplex_push_cand(table, price, j);
+			if (table[j] > beta_q) {
+				q = j;
+				beta_q = table[j];
+			}
+		}
+		j = (j + 1 < n) ? j + 1 : 0;
+	}
+	price->start = j;
+	return q;
+}
+
+/* Initialize weights of normalized pivot rules
+ *
+ *	"devex"		reference weights, all equal to 1
+ *	"steepest"	exact squared norms of edge directions, 1 + ||y_j||^2
+ *
+ * Note: the table is read row by row if it is row-major, or column by column
+ *	otherwise, the sums run over the rows in the same order
+ */
+static void simplex_init_weights(const double *table, struct simplex_price *price,
+				 const int m, const int n, const int steepest)
+{
+	int i, j;
+	double *weights = price->weights;
+
+	for (j = 0; j < n; j++)
+		weights[j] = 1.;
+	if (!steepest)
+		return;
+	if (price->bycol) {
+		for (j = 0; j < n; j++) {
+			const double *colj = table + j * price->cs;
+
+			for (i = 0; i < m; i++)
+				weights[j] += colj[i + 1] * colj[i + 1];
+		}
+		return;
+	}
+	for (i = 0; i < m; i++) {
+		const double *rowi = table + (i + 1) * price->rs;
+
+		for (j = 0; j < n; j++)
+			weights[j] += rowi[j] * rowi[j];
+	}
+}
+
+/* Update weights of normalized pivot rules before pivoting on (p, q)
+ *
+ * Note:
+ *	1. steepest edge follows Goldfarb & Reid (1977), `dots` (length = n) is
+ *		the buffer of `y_q' y_j`, each thread takes a block of columns.
+ *		On the column-major table, the nonzeros of `y_q` are gathered in
+ *		`nzval` and `nzidx` and 4 columns are summed at a time
+ *	2. devex follows Forrest & Goldfarb (1992)
+ */
+static void simplex_update_weights(const double *table, const int *basis, struct simplex_price *price,
+				   const int m, const int n, const int p, const int q, const int steepest)
+{
+	int j, rs = price->rs, cs = price->cs;
+	double *weights = price->weights, *dots = price->dots;
+	double y_p_q = table[q * cs + (p + 1) * rs], w_q = weights[q], y_p_j, a_j, w_j;
+
+	if (steepest && price->bycol) {
+		const double *colq = table + q * cs;
+		double *nzval = price->nzval;
+		int i, nz = 0, *nzidx = price->nzidx;
+
+		for (i = 1; i < m + 1; i++) {  /* nonzeros of column q */
+			if (colq[i] != 0.) {
+				nzval[nz] = colq[i];
+				nzidx[nz++] = i;
+			}
+		}
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(simplex_nshare(price->nthreads, nz * n)) \
+	if (simplex_nshare(price->nthreads, nz * n) > 1)
+#endif
+		for (j = 0; j < n - n % 4; j += 4) {  /* 4 columns at a time */
+			int k;
+			const double *col0 = table + j * cs, *col1 = col0 + cs, *col2 = col1 + cs, *col3 = col2 + cs;
+			double dot0 = 0., dot1 = 0., dot2 = 0., dot3 = 0.;
+
+			for (k = 0; k < nz; k++) {
+				dot0 += nzval[k] * col0[nzidx[k]];
+				dot1 += nzval[k] * col1[nzidx[k]];
+				dot2 += nzval[k] * col2[nzidx[k]];
+				dot3 += nzval[k] * col3[nzidx[k]];
+			}
+			dots[j] = dot0;
+			dots[j + 1] = dot1;
+			dots[j + 2] = dot2;
+			dots[j + 3] = dot3;
+		}
+		for (j = n - n % 4; j < n; j++) {
+			dots[j] = 0.;
+			for (i = 0; i < nz; i++)
+				dots[j] += nzval[i] * table[nzidx[i] + j * cs];
+		}
+	} else if (steepest) {
+		impf_memset(dots, 0, n * sizeof(double));
+#ifdef _OPENMP
+#pragma omp parallel num_threads(simplex_nshare(price->nthreads, m * n)) \
+	if (simplex_nshare(price->nthreads, m * n) > 1)
+#endif
+		{
+			int i, nt = 1, t = 0, start, len;
+
+#ifdef _OPENMP
+			nt = omp_get_num_threads();
+			t = omp_get_thread_num();
+#endif
+			start = n / nt * t + __impf_MIN__(t, n % nt);
+			len = n / nt + (t < n % nt);
+			for (i = 0; i < m && len > 0; i++) {
+				double y_i_q = table[q + (i + 1) * rs];
+
+				if (y_i_q != 0.)
+					impf_linalg_daxpy(len, y_i_q, table + start + (i + 1) * rs, 1,
+							  dots + start, 1);
+			}
+		}
+	}
+	for (j = 0; j < n; j++) {
+		y_p_j = table[j * cs + (p + 1) * rs];
+		if (j == q || y_p_j == 0.)
+			continue;
+		a_j = y_p_j / y_p_q;
+		if (steepest) {
+			w_j = weights[j] - 2. * a_j * dots[j] + a_j * a_j * w_q;
+			weights[j] = __impf_MAX__(w_j, 1. + a_j * a_j);
+		} else
+			weights[j] = __impf_MAX__(weights[j], a_j * a_j * w_q);
+	}
+	weights[basis[p]] = __impf_MAX__(w_q / (y_p_q * y_p_q), 1.);
+}
+
+/* Built-in pricing rules, whose state is the pricing state of simplex table
+ *
+ * Note: they read row 0 from `row0` and the table by the strides of the state,
+ *	so that they run on the column-major table as well (`ldtable` unused)
+ */
+static int simplex_price_dantzig(void *state, const double *table, const int ldtable, const int *basis,
+				 const int *isbasic, const double *ub, const int m, const int n)
+{
+	struct simplex_price *price = state;
+
+	return simplex_pivot_enter_rule_datzig(price->row0, isbasic, n, price->nthreads);
+}
+
+static int simplex_price_bland(void *state, const double *table, const int ldtable, const int *basis,
+			       const int *isbasic, const double *ub, const int m, const int n)
+{
+	return simplex_pivot_enter_rule_bland(((struct simplex_price *)state)->row0, isbasic, n);
+}
+
+static int simplex_price_pan(void *state, const double *table, const int ldtable, const int *basis,
+			     const int *isbasic, const double *ub, const int m, const int n)
+{
+	return simplex_pivot_enter_rule_pan(table, basis, ub, state, m, n);
+}
+
+static void simplex_init_partial(void *state, const double *table, const int ldtable, const int *basis,
+				 const int m, const int n)
+{
+	struct simplex_price *price = state;
+
+	price->ncand = 0;
+	price->start = 0;
+}
+
+static int simplex_price_partial(void *state, const double *table, const int ldtable, const int *basis,
+				 const int *isbasic, const double *ub, const int m, const int n)
+{
+	struct simplex_price *price = state;
+
+	return simplex_pivot_enter_rule_partial(price->row0, price, n);
+}
+
+static int simplex_price_weighted(void *state, const double *table, const int ldtable, const int *basis,
+				  const int *isbasic, const double *ub, const int m, const int n)
+{
+	struct simplex_price *price = state;
+
+	return simplex_pivot_enter_rule_weighted(price->row0, isbasic, price->weights, n, price->nthreads);
+}
+
+static void simplex_init_devex(void *state, const double *table, const int ldtable, const int *basis,
+			       const int m, const int n)
+{
+	simplex_init_weights(table, state, m, n, 0);
+}
+
+static void simplex_update_devex(void *state, const double *table, const int ldtable, const int *basis,
+				 const int m, const int n, const int p, const int q)
+{
+	simplex_update_weights(table, basis, state, m, n, p, q, 0);
+}
+
+static void simplex_init_steepest(void *state, const double *table, const int ldtable, const int *basis,
+				  const int m, const int n)
+{
+	simplex_init_weights(table, state, m, n, 1);
+}
+
+static void simplex_update_steepest(void *state, const double *table, const int ldtable, const int *basis,
+				    const int m, const int n, const int p, const int q)
+{
+	simplex_update_weights(table, basis, state, m, n, p, q, 1);
+}
+
+/* Built-in pricing rules, the last one is the default */
+static const struct impf_PricingRule simplex_builtin_rules[] = {
+	{ "dantzig", NULL, simplex_price_dantzig, NULL, NULL },
+	{ "bland", NULL, simplex_price_bland, NULL, NULL },
+	{ "devex", simplex_init_devex, simplex_price_weighted, simplex_update_devex, NULL },
+	{ "steepest", simplex_init_steepest, simplex_price_weighted, simplex_update_steepest, NULL },
+	{ "partial", simplex_init_partial, simplex_price_partial, NULL, NULL },
+	{ "pan97", NULL, simplex_price_pan, NULL, NULL }
+};
+#define simplex_nbuiltin_rules ((int)(sizeof(simplex_builtin_rules) / sizeof(simplex_builtin_rules[0])))
+
+/* Registered pricing rules */
+static const struct impf_PricingRule *simplex_registered_rules[__impf_LP_PRICING_MAX__];
+static int simplex_nregistered_rules = 0;
+
+static int is_rule_named(const struct impf_PricingRule *rule, const char *criteria)
+{
+	size_t len = impf_strlen(criteria);
+
+	return rule->name != NULL && len == impf_strlen(rule->name) && 0 == impf_memcmp(rule->name, criteria, len);
+}
+
+/* Find the pricing rule of `criteria`, registered rules are searched before
+ * built-in ones, and `builtin` tells which kind is found
+ */
+static const struct impf_PricingRule *simplex_find_rule(const char *criteria, int *builtin)
+{
+	int k;
+
+	*builtin = 0;
+	for (k = simplex_nregistered_rules - 1; criteria != NULL && k >= 0; k--) {
+		if (is_rule_named(simplex_registered_rules[k], criteria))
+			return simplex_registered_rules[k];
+	}
+	*builtin = 1;
+	for (k = 0; criteria != NULL && k < simplex_nbuiltin_rules; k++) {
+		if (is_rule_named(simplex_builtin_rules + k, criteria))
+			return simplex_builtin_rules + k;
+	}
+	return simplex_builtin_rules + simplex_nbuiltin_rules - 1;
+}
+
+int impf_lp_pricing_register(const struct impf_PricingRule *rule)
+{
+	assert(rule != NULL);
+	assert(rule->enter != NULL);
+
+	if (simplex_nregistered_rules >= __impf_LP_PRICING_MAX__)
+		return impf_EXIT_FAILURE;
+	simplex_registered_rules[simplex_nregistered_rules++] = rule;
+	return impf_EXIT_SUCCESS;
+}
+
+const struct impf_PricingRule *impf_lp_pricing_find(const char *criteria)
+{
+	int builtin;
+
+	return simplex_find_rule(criteria, &builtin);
+}
+
+/* Initialize pricing state from the basis
+ */
+static void simplex_init_price(const double *table, const int *basis,
+			       const int m, const int n, struct simplex_price *price)
+{
+	int i;
+
+	impf_memset(price->isbasic, 0, n * sizeof(int));
+	for (i = 0; i < m; i++) {
+		if (basis[i] < n)
+			price->isbasic[basis[i]] = 1;
+	}
+	if (price->rule->init != NULL)
+		price->rule->init(price->state, table, price->rs, basis, m, n);
+}
+
+/* Key subroutine of pivoting
+ *
+ * Parameter:
+ *	p		idx of variable to leave basis
+ *	q		idx of variable to enter basis
+ *	nthreads	number of threads sharing rows of rule 2
+ *	nzval, nzidx	workspace of length n + 1 each, or NULL
+ *
+ * Work:
+ *	rule 1. row_p normalized by dividing y_p_q
+ *	rule 2. row_i -= row_p * y_i_q
+ *	rule 3. row_0 -= row_p * beta_q
+ *
+ * Note: rows of zero y_i_q are skipped. If the workspace is given and row p
+ *	is sparse enough (see `__impf_CTR_SPLX_SPARSE__`), its nonzeros are
+ *	gathered once and only these columns of other rows are updated
+ */
+static void simplex_pivot_core(double *table, const int ldtable,
+			       const int m, const int n, const int p, const int q,
+			       const int rule1, const int rule2, const int rule3,
+			       const int nthreads, double *nzval, int *nzidx)
+{
+	int i, j, nz = 0, ncol = n + 1, rowp = (p + 1) * ldtable;
+	double y_p_q = table[q + rowp];
+
+	if (rule1)
+		impf_linalg_dscal(ncol, 1 / y_p_q, table + rowp, 1);
+	if (nzval != NULL && nzidx != NULL) {
+		for (j = 0; j < ncol && nz <= __impf_CTR_SPLX_SPARSE__ * ncol; j++) {
+			if (table[j + rowp] != 0.) {
+				nzval[nz] = table[j + rowp];
+				nzidx[nz++] = j;
+			}
+		}
+		if (j < ncol)  /* too dense */
+			nzval = NULL;
+	} else
+		nzval = NULL;
+	if (rule2) {
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(simplex_nshare(nthreads, m * (nzval ? nz : ncol))) \
+	if (simplex_nshare(nthreads, m * (nzval ? nz : ncol)) > 1)
+#endif
+		for (i = 0; i < m; i++) {
+			int rowi = (i + 1) * ldtable;
+			double rto =  -table[q + rowi];
+
+			if (i == p || rto == 0.)
+				continue;
+			if (nzval != NULL)
+				impf_linalg_daxpyi(nz, rto, nzval, nzidx, table + rowi);
+			else
+				impf_linalg_daxpy(ncol, rto, table + rowp, 1, table + rowi, 1);
+		}
+	}
+	if (rule3 && table[q] != 0.) {
+		if (nzval != NULL)
+			impf_linalg_daxpyi(nz, -table[q], nzval, nzidx, table);
+		else
+			impf_linalg_daxpy(ncol, -table[q], table + rowp, 1, table, 1);
+	}
+}
+
+/* Key subroutine of pivoting on column-major table of leading dimension
+ * `ldcol`, whose row 0 is mirrored in `row0`
+ *
+ * Work: rules 1, 2 and 3 of `simplex_pivot_core` column by column, i.e.
+ *	col_j -= col_q * y_p_j (rows 0, ..., m) with y_p_j normalized, and
+ *	column q is updated last
+ *
+ * Note: columns of zero y_p_j are skipped, each thread takes a block of
+ *	columns. The entries are the same as those of `simplex_pivot_core`
+ */
+static void simplex_pivot_col(double *table, const int ldcol, double *row0,
+			      const int m, const int n, const int p, const int q, const int nthreads)
+{
+	int j;
+	double *colq = table + q * ldcol;
+	double r_p_q = 1 / colq[p + 1], y_p_q = colq[p + 1] * r_p_q;
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(simplex_nshare(nthreads, (m + 1) * (n + 1))) \
+	if (simplex_nshare(nthreads, (m + 1) * (n + 1)) > 1)
+#endif
+	for (j = 0; j < n + 1; j++) {
+		double *colj = table + j * ldcol, y_p_j;
+
+		if (j == q)
+			continue;
+		y_p_j = colj[p + 1] * r_p_q;
+		if (y_p_j != 0.)
+			impf_linalg_daxpy(m + 1, -y_p_j, colq, 1, colj, 1);
+		colj[p + 1] = y_p_j;
+		row0[j] = colj[0];
+	}
+	impf_linalg_daxpy(m + 1, -y_p_q, colq, 1, colq, 1);  /* in place */
+	colq[p + 1] = y_p_q;
+	row0[q] = colq[0];
+}
+
+/* Substitute nonbasic `x_q` by `ub - x_q` (rows 0, ..., m), where `row0` is
+ * row 0 of the table or its mirror
+ */
+static void simplex_flip_col(double *table, const int rs, const int cs, double *row0,
+			     const int m, const int n, const int q, const double ub)
+{
+	int i;
+
+	for (i = 0; i < m + 1; i++) {
+		table[n * cs + i * rs] -= table[q * cs + i * rs] * ub;
+		table[q * cs + i * rs] = -table[q * cs + i * rs];
+	}
+	row0[n] = table[n * cs];
+	row0[q] = table[q * cs];
+}
+
+/* Substitute basic `x_b` of row `p` by `ub - x_b`, the row is negated so that
+ * `x_b` keeps coefficient 1
+ */
+static void simplex_flip_row(double *table, const int rs, const int cs, const int n,
+			     const int p, const int b, const double ub)
+{
+	int rowp = (p + 1) * rs;
+
+	impf_linalg_dscal((n + 1) * cs, -1., table + rowp, cs);  /* the length spans the strides */
+	table[b * cs + rowp] = 1.;
+	table[n * cs + rowp] += ub;
+}
+
+/* Point `price->colq` and `price->rhs` to column `q` and the rhs column
+ * (rows 0, ..., m), which are gathered into `price->col` if the table is
+ * row-major
+ */
+static void simplex_gather(double *table, struct simplex_price *price,
+			   const int m, const int n, const int q)
+{
+	int i;
+
+	if (price->bycol) {  /* contiguous already */
+		price->colq = table + q * price->cs;
+		price->rhs = table + n * price->cs;
+		return;
+	}
+	price->colq = price->col;
+	price->rhs = price->col + m + 1;
+	for (i = 0; i < m + 1; i++) {
+		price->colq[i] = table[q + i * price->rs];
+		price->rhs[i] = table[n + i * price->rs];
+	}
+}
+
+/* Replace the basic variable of row `p` by `x_q`, together with the pricing
+ * state and the rhs perturbation
+ *
+ * Note: column `q` should be gathered in `price->colq` (see `simplex_gather`)
+ */
+static void simplex_pivot_basis(double *table, int *basis,
+				struct simplex_price *price, const int m, const int n,
+				const int p, const int q)
 {
-	if (old_value <= table[n] + __impf_CHC_SPLX_DEGENERATED__) {
-		if (is_simplex_optimal(table, n))
-			return 1;
-		return 2;
-	} else
-		return 0;
+	int i;
+	double *shift = price->shift;
+
+	if (price->perturbed) {  /* the perturbation is transformed as rhs */
+		shift[p + 1] /= price->colq[p + 1];
+		for (i = 0; i < m + 1; i++) {
+			if (i != p + 1)
+				shift[i] -= price->colq[i] * shift[p + 1];
+		}
+	}
+	if (price->rule->update != NULL)
+		price->rule->update(price->state, table, price->rs, basis, m, n, p, q);
+	if (basis[p] < n)
+		price->isbasic[basis[p]] = 0;
+	price->isbasic[q] = 1;
+	basis[p] = q;
+	if (price->bycol)
+		simplex_pivot_col(table, price->cs, price->row0, m, n, p, q, price->nthreads);
+	else
+		simplex_pivot_core(table, price->rs, m, n, p, q, 1, 1, 1, price->nthreads,
+				   price->nzval, price->nzidx);
 }
 
-/* Choose the variable to leave basis
- * Return the index of the variable and check weather LP is "bounded"
+/* Perturb the rhs of basic variables by small pseudo-random amounts towards
+ * the interior of their bounds, so that ties in the ratio test of a degenerate
+ * vertex are broken
  */
-static int simplex_pivot_leave_rule(const double *table, const int ldtable,
-				    const int m, const int n, const int q, int *bounded)
+static void simplex_perturb(double *table, const int *basis,
+			    const double *ub, struct simplex_price *price, const int m, const int n)
 {
-	int i, p = n;
-	double y_i_0, y_i_q, x_iq, min_x_iq = __impf_INF__;
-	*bounded = 0;
+	int i;
+	unsigned long seed = 1;
+	double eps, *x_i;
 
 	for (i = 0; i < m; i++) {
-		y_i_0 = table[n + (i + 1) * ldtable];
-		y_i_q = table[q + (i + 1) * ldtable];
+		x_i = table + n * price->cs + (i + 1) * price->rs;
+		seed = (seed * 1103515245 + 12345) % 2147483648UL;
+		eps = __impf_CTR_SPLX_PERTURB__ * (1. + (double) seed / 2147483648.) * (1. + __impf_ABS__(*x_i));
+		if (ub[basis[i]] < __impf_INF__) {
+			eps = __impf_MIN__(eps, .5 * ub[basis[i]]);
+			if (2. * (*x_i) > ub[basis[i]])  /* closer to the upper bound */
+				eps = -eps;
+		}
+		*x_i += eps;
+		price->shift[i + 1] += eps;
+	}
+	price->perturbed = 1;
+}
 
-		if (y_i_q <= __impf_CTR_SPLX_PIV_LEV__)
-			continue;
-		else {
-			x_iq = y_i_0 / y_i_q;
+/* Remove the perturbation from the rhs, the basis might become slightly
+ * infeasible
+ */
+static void simplex_unperturb(double *table, struct simplex_price *price,
+			      const int m, const int n)
+{
+	int i;
 
-			if (x_iq < min_x_iq) {
-				min_x_iq = x_iq;
-				p = i;
-			}
-			*bounded = 1;
-		}
+	for (i = 0; i < m + 1; i++) {
+		table[n * price->cs + i * price->rs] -= price->shift[i];
+		price->shift[i] = 0.;
 	}
-	return p;
+	price->row0[n] = table[n * price->cs];
+	price->perturbed = 0;
 }
 
-/* Fast pivot rule: choosing the variable to enter basis
- * Return the index of the variable (< n)
+/* Dual ratio test: the nonbasic variable to enter basis on row `p`, whose
+ * entry of the row is negative, keeping row 0 nonpositive
  *
- * Note:
- * 	On failure, the algorithm returns `n`. Logically, this NEVER happens,
- *	but numerically, there are many criteriors reporting optimality,
- *	leading to unpredicted results
+ * Return `n` if there is none
  */
-static int simplex_pivot_enter_rule_datzig(const double *table, const int *basis, const int m, const int n)
+static int simplex_dual_enter(const double *table, const struct simplex_price *price,
+			      const int n, const int p)
 {
 	int j, q = n;
-	double beta_j = 0.;
-	double beta_q = 0.;
+	double ratio, y_p_j, best = __impf_INF__, max_y_pj = 0.;
 
 	for (j = 0; j < n; j++) {
-		if (is_in_arri(j, basis, m))
+		y_p_j = table[j * price->cs + (p + 1) * price->rs];
+		if (price->isbasic[j] || y_p_j >= -__impf_CTR_SPLX_PIV_LEV__)
 			continue;
-		beta_j = table[j];
-
-		if (beta_j > beta_q) {
+		ratio = __impf_MAX__(-price->row0[j], 0.) / (-y_p_j);
+		if (ratio < best - __impf_CTR_SPLX_HARRIS__ ||
+		    (ratio <= best + __impf_CTR_SPLX_HARRIS__ && -y_p_j > max_y_pj)) {
+			best = __impf_MIN__(ratio, best);
+			max_y_pj = -y_p_j;
 			q = j;
-			beta_q = beta_j;
 		}
 	}
-	return q; /* return n if no p is found (optimal already) */
+	return q;
 }
 
-/* Bland's rule: choosing the variable to enter basis
- * Return the index of the variable (< n)
+/* Restore primal feasibility of an optimal basis by dual simplex pivots,
+ * following the removal of perturbation
  *
- * Note: on failure, the algorithm returns n
+ * Note: a basic variable beyond its upper bound is flipped to be negative
+ *
+ * Return:
+ *	0: the basis is primal feasible (or the iteration limit is reached)
+ *	9: numerical precision error
  */
-static int simplex_pivot_enter_rule_bland(const double *table, const int *basis, const int m, const int n)
+static int simplex_pivot_dual(int *epoch, double *table, int *basis,
+			      const double *ub, int *flip, struct simplex_price *price,
+			      const int m, const int n, const int niter)
 {
-	int j;
-	double epsilon = __impf_CTR_SPLX_BLAND_EPS__;
-BLAND_BEGIN:
-	for (j = 0; j < n; j++) {
-		if (!is_in_arri(j, basis, m)) {
-			if (table[j] > epsilon)
-				return j;
+	int i, p, q, rs = price->rs, cs = price->cs;
+	double x_i, infeas;
+
+	while (*epoch < niter) {
+		p = m;
+		infeas = __impf_CTR_SPLX_HARRIS__;
+		for (i = 0; i < m; i++) {
+			x_i = table[n * cs + (i + 1) * rs];
+			if (-x_i > infeas) {
+				infeas = -x_i;
+				p = i;
+			} else if (x_i - ub[basis[i]] > infeas) {
+				infeas = x_i - ub[basis[i]];
+				p = i;
+			}
+		}
+		if (p == m)
+			return 0;
+		if (table[n * cs + (p + 1) * rs] > 0.) {
+			simplex_flip_row(table, rs, cs, n, p, basis[p], ub[basis[p]]);
+			flip[basis[p]] = !flip[basis[p]];
+		}
+		q = simplex_dual_enter(table, price, n, p);
+		if (q == n) {  /* negligible infeasibility is accepted */
+			if (infeas > __impf_CHC_SPLX_FEASIBLE__)
+				return 9;
+			table[n * cs + (p + 1) * rs] = 0.;
+			continue;
 		}
+		(*epoch)++;
+		simplex_gather(table, price, m, n, q);
+		simplex_pivot_basis(table, basis, price, m, n, p, q);
 	}
-	if (epsilon >= __impf_CTR_SPLX_BLAND_EPS_MIN__) {
-		epsilon /= 10.;
-		goto BLAND_BEGIN;
-	} else
-		return n;
+	return 0;
 }
 
-/* Key subroutine of pivoting
- *
- * Parameter:
- *	p	idx of variable to leave basis
- *	q	idx of variable to enter basis
+/* Pivot `x_q` into basis on the row of the ratio test, or flip it to its
+ * other bound if the bound is reached first
  *
- * Work:
- *	rule 1. row_p normalized by dividing y_p_q
- *	rule 2. row_i -= row_p * y_i_q
- *	rule 3. row_0 -= row_p * beta_q
+ * Return:
+ *	0: the pivot or bound flip is done
+ *	2: LP is unbounded along `x_q`
  */
-static void simplex_pivot_core(double *table, const int ldtable,
-			       const int m, const int n, const int p, const int q,
-			       const int rule1, const int rule2, const int rule3)
+static int simplex_pivot_enter(double *table, int *basis,
+			       const double *ub, int *flip, struct simplex_price *price,
+			       const int m, const int n, const int q)
 {
-	int i, ncol = n + 1, rowp = (p + 1) * ldtable;
-	double y_p_q = table[q + rowp];
+	int bounded, toub;
+	int p, rs = price->rs, cs = price->cs;
 
-	if (rule1)
-		impf_linalg_dscal(ncol, 1 / y_p_q, table + rowp, 1);
-	if (rule2) {
-		for (i = 0; i < m; i++) {
-			int rowi = (i + 1) * ldtable;
-			double rto =  -table[q + rowi];
+	simplex_gather(table, price, m, n, q);
+	p = simplex_pivot_leave_rule(price->colq, price->rhs, basis, ub, m, n, q, price->nthreads,
+				     &bounded, &toub);
 
-			if (i == p)
-				continue;
-			impf_linalg_daxpy(ncol, rto, table + rowp, 1, table + rowi, 1);
-		}
+	if (bounded == 0)
+		return 2;
+	if (p == m) {  /* bound flip, the basis is unchanged */
+		simplex_flip_col(table, rs, cs, price->row0, m, n, q, ub[q]);
+		flip[q] = !flip[q];
+		return 0;
+	}
+	if (toub) {
+		simplex_flip_row(table, rs, cs, n, p, basis[p], ub[basis[p]]);
+		flip[basis[p]] = !flip[basis[p]];
+		price->shift[p + 1] = -price->shift[p + 1];
+	}
+	if (table[n * cs + (p + 1) * rs] < 0.) {  /* infeasibility allowed by Harris' test */
+		price->shift[p + 1] -= table[n * cs + (p + 1) * rs];
+		table[n * cs + (p + 1) * rs] = 0.;
 	}
-	if (rule3)
-		impf_linalg_daxpy(ncol, -table[q], table + rowp, 1, table, 1);
+	price->colq[p + 1] = table[q * cs + (p + 1) * rs];
+	simplex_pivot_basis(table, basis, price, m, n, p, q);
+	return 0;
 }
 
 /* Pivot starting from a basic representation for one round
@@ -165,139 +1131,295 @@ static void simplex_pivot_core(double *table, const int ldtable,
  *	2: LP is unbounded
  *	9: numerical precision error
  */
-static int simplex_pivot_on(double *table, const int ldtable, int *basis,
-			    const int m, const int n, const char *criteria)
+static int simplex_pivot_on(double *table, int *basis,
+			    const double *ub, int *flip, struct simplex_price *price,
+			    const int m, const int n)
 {
-	int bounded;
-	int q, p;
+	int q;
+	const double *row0 = price->row0;
 
-	if (is_simplex_optimal(table, n))
+	if (price->bland)
+		q = simplex_pivot_enter_rule_bland(row0, price->isbasic, n);
+	else
+		q = price->rule->enter(price->state, table, price->rs, basis, price->isbasic, ub, m, n);
+	if (q < 0 || n < q)
+		q = n;
+	/* optimality is checked over all columns only when pricing finds none */
+	if ((n <= q || row0[q] <= __impf_CTR_SPLX_OPTIMAL__) && is_simplex_optimal(row0, price->isbasic, n))
 		return 1;
-	if (7 == impf_strlen(criteria) && 0 == impf_memcmp("dantzig", criteria, 7)) {
-		q = simplex_pivot_enter_rule_datzig(table, basis, m, n);
-		p = simplex_pivot_leave_rule(table, ldtable, m, n, q, &bounded);
-	}
-	else if (5 == impf_strlen(criteria) && 0 == impf_memcmp("bland", criteria, 5)) {
-		q = simplex_pivot_enter_rule_bland(table, basis, m, n);
-		p = simplex_pivot_leave_rule(table, ldtable, m, n, q, &bounded);
-	}
-	else {  /* default method: "pan97" */
-		q = simplex_pivot_enter_rule_datzig(table, basis, m, n);
-		p = simplex_pivot_leave_rule(table, ldtable, m, n, q, &bounded);
-
-		/* int idx_degen = find_bv_degenerated(table, ldtable, m, n); */
-#ifdef IMPF_MODE_DEBUG
-		impf_prt_matd(table, n + 1, m + 1, n + 1);
-		printf("\n");
-		printf("p = %i, q = %i\nbasis = ", p, q);
-		impf_prt_arri(basis, m, 1);
-		printf("\n");
-#endif
-	}
 	if (n <= q) {
 #ifdef IMPF_MODE_DEBUG
-		printf("Pivot failure due to '9: numerical precision error'\n");
+		impf_prt_dev("Pivot failure due to '9: numerical precision error'\n");
 #endif
 		return 9;
 	}
-
-	if (bounded == 0)
-		return 2;
-	basis[p] = q;
-	simplex_pivot_core(table, ldtable, m, n, p, q, 1, 1, 1);
-	return 0;
+	return simplex_pivot_enter(table, basis, ub, flip, price, m, n, q);
 }
 
-/* Linear Programming: simplex algorithm for solving LP of basic representation
+/* Pivot the table (see `price->rs` and `price->cs`) until it stops
  *
- * Return
- *	0: current BFS is NOT optimal (stop before converged)
- *	1: current BSF is optimal
- *	2: LP is unbounded
- *	3: LP is circled more than accepted times (indicating for degeneracy)
- *	9: numerical precision error
+ * Against degeneracy, the rhs is perturbed after `__impf_CTR_SPLX_DEGEN__`
+ * pivots without improvement, and pricing falls back to Bland's rule if the
+ * perturbed LP stalls again. The perturbation is removed once optimal, and
+ * primal feasibility is restored by dual simplex pivots
+ *
+ * Return: see `simplex_pivot_bsc`
  */
-static int simplex_pivot_bsc(int *epoch, double *table, const int ldtable, int *basis,
-			     const int m, const int n, const int nreal,
-			     const char *criteria, const int niter)
+static int simplex_pivot_loop(int *epoch, double *table, int *basis,
+			      const double *ub, int *flip, struct simplex_price *price,
+			      const int m, const int n, const int niter)
 {
 	double old_value = __impf_INF__;
-	int degen_iter = 0;
+	int degen_iter = 0, nperturb = 0;
 
-	assert(table != NULL);
-	assert(basis != NULL);
-	assert(epoch != NULL);
+	simplex_init_price(table, basis, m, n, price);
+	impf_memset(price->shift, 0, (m + 1) * sizeof(double));
+	price->perturbed = 0;
+	price->bland = 0;
 
 	while (*epoch < niter) {
 		(*epoch)++;
-		switch (simplex_pivot_on(table, ldtable, basis, m, n, criteria)) {
+		switch (simplex_pivot_on(table, basis, ub, flip, price, m, n)) {
 		case 0:
 			break;
 		case 1:
+			if (price->perturbed) {
+				simplex_unperturb(table, price, m, n);
+				if (simplex_pivot_dual(epoch, table, basis, ub, flip, price, m, n, niter) == 9)
+					return 9;
+				old_value = __impf_INF__;
+				continue;
+			}
 #ifdef IMPF_MODE_DEBUG
-		printf(">>> Algorithm stop due to '1: current BSF is optimal'.\n");
+		impf_prt_dev(">>> Algorithm stop due to '1: current BSF is optimal'.\n");
 #endif
 			return 1;
 		case 2:
 #ifdef IMPF_MODE_DEBUG
-		printf(">>> Algorithm stop due to '2: LP is unbounded'.\n");
+		impf_prt_dev(">>> Algorithm stop due to '2: LP is unbounded'.\n");
 #endif
 			return 2;
 		case 9:
 #ifdef IMPF_MODE_DEBUG
-		printf(">>> Algorithm stop due to '9: numerical precision error'.\n");
+		impf_prt_dev(">>> Algorithm stop due to '9: numerical precision error'.\n");
 #endif
 			return 9;
 		}
-		if (check_simplex_degenerated(table, n, old_value) == 2) {
+		if (check_simplex_degenerated(price->row0, price->isbasic, n, old_value) == 2) {
 #ifdef IMPF_MODE_DEBUG
-			printf(">>> Degenerated, value = %f [%i]\n", table[n], degen_iter);
+			impf_prt_dev(">>> Degenerated, value = %f [%i]\n", price->row0[n], degen_iter);
 #endif
 			degen_iter++;
-			if (degen_iter > 5)
-				return 3;
+			if (degen_iter > __impf_CTR_SPLX_DEGEN__) {
+				if (nperturb++ == 0)
+					simplex_perturb(table, basis, ub, price, m, n);
+				else
+					price->bland = 1;
+				degen_iter = 0;
+			}
 		} else
 			degen_iter = 0;
-		old_value = table[n];
+		old_value = price->row0[n];
 	}
 	return 0;
 }
 
-/* To create in heap (need to be released) simplex table, index set of basis
- * and constraint type recorder
+/* Copy the row-major matrix `a` (nrow, ncol) of leading dimension `lda` into
+ * `b` as column-major of leading dimension `ldb`, tile by tile
  */
-static int simplex_create_buffer(double **table, int **basis, int **constypes,
-				 const int m, const int nrow, const int ncol)
+static void simplex_transpose(const double *a, const int lda, double *b, const int ldb,
+			      const int nrow, const int ncol)
 {
-	*table = NULL;
-	*basis = NULL;
-	*constypes = NULL;
+	int i, j, i0, j0, i1, j1;
 
-	*table = impf_malloc(nrow * ncol * sizeof(double));
-	if (*table == NULL)
-		return impf_EXIT_FAILURE;
-	*basis = impf_malloc(m * sizeof(int));
-	if (*basis == NULL) {
-		impf_free(*table);
-		return impf_EXIT_FAILURE;
+	for (i0 = 0; i0 < nrow; i0 += __impf_CTR_SPLX_TILE__) {
+		i1 = __impf_MIN__(i0 + __impf_CTR_SPLX_TILE__, nrow);
+		for (j0 = 0; j0 < ncol; j0 += __impf_CTR_SPLX_TILE__) {
+			j1 = __impf_MIN__(j0 + __impf_CTR_SPLX_TILE__, ncol);
+			for (i = i0; i < i1; i++) {
+				for (j = j0; j < j1; j++)
+					b[i + j * ldb] = a[j + i * lda];
+			}
+		}
+	}
+}
+
+/* Linear Programming: simplex algorithm for solving LP of basic representation
+ *
+ * If `price->cols` is given, the pivots run on the column-major copy of the
+ * table (rows 0, ..., m and columns 0, ..., n) with row 0 mirrored after it,
+ * so that the ratio test reads columns and pricing reads row 0 contiguously.
+ * The table is copied back on return
+ *
+ * Return
+ *	0: current BFS is NOT optimal (stop before converged)
+ *	1: current BSF is optimal
+ *	2: LP is unbounded
+ *	9: numerical precision error
+ */
+static int simplex_pivot_bsc(int *epoch, double *table, const int ldtable, int *basis,
+			     const double *ub, int *flip, struct simplex_price *price,
+			     const int m, const int n, const int nreal, const int niter)
+{
+	int state;
+
+	assert(table != NULL);
+	assert(basis != NULL);
+	assert(epoch != NULL);
+
+	price->bycol = price->cols != NULL;
+	if (price->bycol) {
+		price->rs = 1;
+		price->cs = m + 1;
+		price->row0 = price->cols + (m + 1) * (n + 1);
+		simplex_transpose(table, ldtable, price->cols, m + 1, m + 1, n + 1);
+		impf_memcpy(price->row0, table, (n + 1) * sizeof(double));
+		state = simplex_pivot_loop(epoch, price->cols, basis, ub, flip, price, m, n, niter);
+		simplex_transpose(price->cols, m + 1, table, ldtable, n + 1, m + 1);
+	} else {
+		price->rs = ldtable;
+		price->cs = 1;
+		price->row0 = table;
+		state = simplex_pivot_loop(epoch, table, basis, ub, flip, price, m, n, niter);
 	}
-	*constypes = impf_malloc(m * sizeof(int));
-	if (*constypes == NULL) {
-		impf_free(*table);
-		impf_free(*basis);
+	price->bycol = 0;  /* row-major for the pivots after the solve */
+	price->rs = ldtable;
+	price->cs = 1;
+	price->row0 = table;
+	return state;
+}
+
+/* Whether the pivots of LPs of standard form with `m` constraints and `n`
+ * variables run on a column-major copy of the table (see `simplex_pivot_bsc`)
+ *
+ * Note: by default, tall tables of at least `__impf_CTR_SPLX_COLMAJOR__` rows
+ *	and no more than `__impf_CTR_SPLX_COLMAJOR_RATIO__` times as many
+ *	variables as rows are copied, where the strided reads of the pivot row
+ *	are fewer than those of the pivot and rhs columns in the row-major
+ *	table, and the copies are paid back by the pivots
+ */
+static int simplex_by_col(const int layout, const int m, const int n)
+{
+	if (m < 1 || layout == impf_TABLE_T_ROW)
+		return 0;
+	if (layout == impf_TABLE_T_COL)
+		return 1;
+	return m >= __impf_CTR_SPLX_COLMAJOR__ && n <= __impf_CTR_SPLX_COLMAJOR_RATIO__ * m;
+}
+
+/* Lengths of the double and int buffers of a workspace fitting all LPs of
+ * standard form with `m` constraints and `n` variables, whose simplex table
+ * has at most `n + 2 * m + 1` columns (slack and artificial of all rows)
+ *
+ * Buffers are laid out as
+ *	double:	scale (m + n), table (m + 1) * ncol, ub (ncol),
+ *		pricing weights (4 * ncol + 3 * (m + 1)),
+ *		column-major table (m + 1) * ncol and row 0 (ncol) if `bycol`
+ *	int:	crash counts (2 * n), basis (m), constypes (m), flip (ncol),
+ *		pricing flags (2 * ncol + __impf_CTR_SPLX_PRICE_CANDS__ + m)
+ */
+static void simplex_ws_size(const int m, const int n, const int bycol, int *ndbl, int *nint)
+{
+	int ncol = n + 2 * m + 1;
+
+	*ndbl = (m + n) + (m + 1) * ncol + ncol + 4 * ncol + 3 * (m + 1);
+	*nint = 2 * n + 2 * m + ncol + 2 * ncol + __impf_CTR_SPLX_PRICE_CANDS__ + m;
+	if (bycol)
+		*ndbl += (m + 1) * ncol + ncol;
+}
+
+/* Allocate the buffers of workspace fitting LPs of size (m, n)
+ */
+static int simplex_ws_alloc(struct impf_LP_Workspace *ws, const int m, const int n, const int bycol, int *code)
+{
+	ws->m = m;
+	ws->n = n;
+	simplex_ws_size(m, n, bycol, &ws->ndbl, &ws->nint);
+	ws->dbl = impf_malloc(ws->ndbl * sizeof(double));
+	ws->ints = impf_malloc(ws->nint * sizeof(int));
+	if (ws->dbl == NULL || ws->ints == NULL) {
+		impf_lp_workspace_free(ws);
+		*code = impf_MemoryAllocError;
 		return impf_EXIT_FAILURE;
 	}
+	*code = impf_Success;
 	return impf_EXIT_SUCCESS;
 }
 
-static void simplex_free_buffer(double *table, int *basis, int *constypes)
+int impf_lp_workspace_init(struct impf_LP_Workspace *ws, const int m, const int n, int *code)
+{
+	assert(ws != NULL);
+	assert(code != NULL);
+
+	ws->nthreads = 1;
+	ws->layout = impf_TABLE_T_AUTO;
+	return simplex_ws_alloc(ws, m, n, simplex_by_col(ws->layout, m, n), code);
+}
+
+void impf_lp_workspace_free(struct impf_LP_Workspace *ws)
 {
-	if (table)
-		impf_free(table);
-	if (basis)
-		impf_free(basis);
-	if (constypes)
-		impf_free(constypes);
+	if (ws->dbl)
+		impf_free(ws->dbl);
+	if (ws->ints)
+		impf_free(ws->ints);
+	ws->dbl = NULL;
+	ws->ints = NULL;
+	ws->ndbl = 0;
+	ws->nint = 0;
+}
+
+/* Enlarge the workspace if it does not fit LPs of size (m, n), together with
+ * the column-major table if it is used (see `simplex_by_col`)
+ */
+static int simplex_ws_reserve(struct impf_LP_Workspace *ws, const int m, const int n, int *code)
+{
+	int ndbl, nint, m1, n1, bycol = simplex_by_col(ws->layout, m, n);
+
+	simplex_ws_size(m, n, bycol, &ndbl, &nint);
+	if (ndbl <= ws->ndbl && nint <= ws->nint)
+		return impf_EXIT_SUCCESS;
+	m1 = __impf_MAX__(m, ws->m);
+	n1 = __impf_MAX__(n, ws->n);
+	impf_lp_workspace_free(ws);
+	return simplex_ws_alloc(ws, m1, n1, bycol || simplex_by_col(ws->layout, m1, n1), code);
+}
+
+/* To place in workspace simplex table, index set of basis, constraint type
+ * recorder, upper bounds and flip flags of all columns, and pricing state of
+ * all columns (see `simplex_ws_size` for the layout)
+ */
+static void simplex_create_buffer(struct impf_LP_Workspace *ws, double **table, int **basis, int **constypes,
+				  double **ub, int **flip, struct simplex_price *price,
+				  const int m, const int n, const int nrow, const int ncol)
+{
+	*table = ws->dbl + m + n;
+	*ub = *table + nrow * ncol;
+	price->weights = *ub + ncol;
+	price->dots = price->weights + ncol;
+	price->norms = price->weights + 2 * ncol;
+	price->shift = price->weights + 3 * ncol;
+	price->col = price->shift + m + 1;
+	price->nzval = price->col + 2 * (m + 1);
+
+	*basis = ws->ints + 2 * n;
+	*constypes = *basis + m;
+	*flip = *constypes + m;
+	price->isbasic = *flip + ncol;
+	price->cands = price->isbasic + ncol;
+	price->degen = price->cands + __impf_CTR_SPLX_PRICE_CANDS__;
+	price->nzidx = price->degen + m;
+}
+
+/* Fill in upper bounds of columns, only real variables could be bounded
+ */
+static void simplex_fill_ub(double *ub, int *flip, const double *ub0, const int n, const int ncol)
+{
+	int j;
+
+	for (j = 0; j < ncol; j++) {
+		ub[j] = (ub0 != NULL && j < n) ? ub0[j] : __impf_INF__;
+		flip[j] = 0;
+	}
 }
 
 /* Fill in constraint type array from "constraints"
@@ -356,6 +1478,135 @@ static void simplex_fill_conscoefs(double *table, const int ldtable, const struc
 	}
 }
 
+/* Binary exponent `e` of nonzero finite `v` such that 2^e <= |v| < 2^(e+1)
+ */
+static int simplex_log2(double v)
+{
+	int e;
+
+	frexp(v, &e);  /* |v| = f * 2^e with 0.5 <= f < 1 */
+	return e - 1;
+}
+
+/* Whether entry `v` takes part in scaling, zero and non-finite entries do not
+ */
+static int is_scaled(double v)
+{
+	return v != 0. && __impf_ABS__(v) < __impf_INF__;
+}
+
+/* Scale row i (rhs included) of the constraints by 2^e
+ */
+static void simplex_scale_row(double *table, const int ldtable, double *rscale,
+			      const int i, const int n, const int e)
+{
+	int j, row = (i + 1) * ldtable;
+
+	if (e == 0)
+		return;
+	for (j = 0; j < n; j++)
+		table[j + row] = ldexp(table[j + row], e);
+	table[ldtable - 1 + row] = ldexp(table[ldtable - 1 + row], e);
+	rscale[i] = ldexp(rscale[i], e);
+}
+
+/* Scale column j of the constraints by 2^e
+ */
+static void simplex_scale_col(double *table, const int ldtable, double *cscale,
+			      const int m, const int j, const int e)
+{
+	int i;
+
+	if (e == 0)
+		return;
+	for (i = 0; i < m; i++)
+		table[j + (i + 1) * ldtable] = ldexp(table[j + (i + 1) * ldtable], e);
+	cscale[j] = ldexp(cscale[j], e);
+}
+
+/* Scale the constraints `A x = b` to `R A S y = R b` with `x = S y`
+ *
+ * Geometric mean scaling of rows and columns is repeated until the spread of
+ * magnitudes stops shrinking, then rows and columns are equilibrated so that
+ * their largest entries lie in [1, 2). Factors are powers of 2, hence
+ * scaling is exact
+ *
+ *	scale		R (length = m) followed by S (length = n)
+ *	ub		upper bounds of the real variables, scaled to those of y
+ */
+static void simplex_scale(double *table, const int ldtable, double *ub, double *scale,
+			  const int m, const int n)
+{
+	double *rscale = scale, *cscale = scale + m;
+	int i, j, k, e, emin, emax;
+	int spread, last = -1;
+
+	for (i = 0; i < m + n; i++)
+		scale[i] = 1.;
+	for (k = 0; k < __impf_CTR_SPLX_SCALE_PASSES__; k++) {
+		emin = 1 << 14;
+		emax = -(1 << 14);
+		for (i = 0; i < m; i++) {
+			for (j = 0; j < n; j++) {
+				if (!is_scaled(table[j + (i + 1) * ldtable]))
+					continue;
+				e = simplex_log2(table[j + (i + 1) * ldtable]);
+				emin = __impf_MIN__(emin, e);
+				emax = __impf_MAX__(emax, e);
+			}
+		}
+		spread = emax - emin;
+		if (spread <= 1 || (last >= 0 && spread >= last))
+			break;
+		last = spread;
+		for (i = 0; i < m; i++) {  /* rows by 1 / sqrt(min * max) */
+			emin = 1 << 14;
+			emax = -(1 << 14);
+			for (j = 0; j < n; j++) {
+				if (!is_scaled(table[j + (i + 1) * ldtable]))
+					continue;
+				e = simplex_log2(table[j + (i + 1) * ldtable]);
+				emin = __impf_MIN__(emin, e);
+				emax = __impf_MAX__(emax, e);
+			}
+			if (emin <= emax)
+				simplex_scale_row(table, ldtable, rscale, i, n, -(emin + emax) / 2);
+		}
+		for (j = 0; j < n; j++) {  /* columns by 1 / sqrt(min * max) */
+			emin = 1 << 14;
+			emax = -(1 << 14);
+			for (i = 0; i < m; i++) {
+				if (!is_scaled(table[j + (i + 1) * ldtable]))
+					continue;
+				e = simplex_log2(table[j + (i + 1) * ldtable]);
+				emin = __impf_MIN__(emin, e);
+				emax = __impf_MAX__(emax, e);
+			}
+			if (emin <= emax)
+				simplex_scale_col(table, ldtable, cscale, m, j, -(emin + emax) / 2);
+		}
+	}
+	for (i = 0; i < m; i++) {  /* equilibration of rows */
+		emax = -(1 << 14);
+		for (j = 0; j < n; j++) {
+			if (is_scaled(table[j + (i + 1) * ldtable]))
+				emax = __impf_MAX__(emax, simplex_log2(table[j + (i + 1) * ldtable]));
+		}
+		if (emax > -(1 << 14))
+			simplex_scale_row(table, ldtable, rscale, i, n, -emax);
+	}
+	for (j = 0; j < n; j++) {  /* equilibration of columns */
+		emax = -(1 << 14);
+		for (i = 0; i < m; i++) {
+			if (is_scaled(table[j + (i + 1) * ldtable]))
+				emax = __impf_MAX__(emax, simplex_log2(table[j + (i + 1) * ldtable]));
+		}
+		if (emax > -(1 << 14))
+			simplex_scale_col(table, ldtable, cscale, m, j, -emax);
+		ub[j] /= cscale[j];
+	}
+}
+
 /* Determine the size of (basic) simplex table
  *
  * "GE" constraint has a slack var and an artificial var, hence will generate
@@ -395,19 +1646,104 @@ static int simplex_add_slack(double *table, const int ldtable, const int *consty
 			nslack++;
 		}
 	}
-	return nslack;
+	return nslack;
+}
+
+/* Whether the crash pivot on row i and column j keeps the basic solution
+ * feasible, where `x_j = b_i / a_ij` and rows not crashed yet keep their
+ * slack or artificial variables basic
+ */
+static int is_crash_feasible(const double *table, const int ldtable, const int *basis,
+			     const double *ub, const int m, const int i, const int j)
+{
+	int k, rhs = ldtable - 1;
+	double t = table[rhs + (i + 1) * ldtable] / table[j + (i + 1) * ldtable];
+
+	if (t < 0. || t > ub[j])
+		return 0;
+	for (k = 0; k < m; k++) {
+		int rowk = (k + 1) * ldtable;
+
+		if (k == i || basis[k] >= 0)
+			continue;
+		if (table[rhs + rowk] - table[j + rowk] * t < 0.)
+			return 0;
+	}
+	return 1;
+}
+
+/* Crash basis (Bixby, 1992): make structural variables basic in EQ and GE
+ * rows, so that these rows need no artificial variables
+ *
+ * The crashed columns form a triangular basis: a column is a candidate of a
+ * row only if it is zero in all rows crashed before. Among the candidates
+ * keeping the basic solution feasible and with a pivot not smaller than
+ * `__impf_CTR_SPLX_CRASH_PIV__` times the largest entry of the column, the
+ * one without upper bound and then with the fewest nonzeros is chosen.
+ *
+ * `basis[i]` is set to the crashed column of row i, or -1, and `cnt` is a
+ * buffer (length = 2 * n)
+ * Return the number of crashed rows
+ */
+static int simplex_crash(double *table, const int ldtable, int *basis, const double *ub,
+			 const int *constypes, int *cnt, const int m, const int n, const int nthreads)
+{
+	int i, j, k, q, ncrash = 0;
+
+	for (i = 0; i < m; i++)
+		basis[i] = -1;
+	for (j = 0; j < n; j++) {
+		cnt[j] = 0;
+		cnt[n + j] = 0;
+		for (i = 0; i < m; i++) {
+			if (table[j + (i + 1) * ldtable] != 0.)
+				cnt[n + j]++;
+		}
+	}
+	for (i = 0; i < m; i++) {
+		int rowi = (i + 1) * ldtable;
+
+		if (impf_CONS_T_LE == constypes[i])
+			continue;
+		q = n;
+		for (j = 0; j < n; j++) {
+			double maxv = 0.;
+
+			if (cnt[j] > 0 || table[j + rowi] == 0.)
+				continue;
+			for (k = 0; k < m; k++)
+				maxv = __impf_MAX__(maxv, __impf_ABS__(table[j + (k + 1) * ldtable]));
+			if (__impf_ABS__(table[j + rowi]) < __impf_CTR_SPLX_CRASH_PIV__ * maxv)
+				continue;
+			if (!is_crash_feasible(table, ldtable, basis, ub, m, i, j))
+				continue;
+			if (q == n || (ub[j] == __impf_INF__ && ub[q] < __impf_INF__)
+			    || (ub[j] == ub[q] && cnt[n + j] < cnt[n + q]))
+				q = j;
+		}
+		if (q == n)
+			continue;
+		simplex_pivot_core(table, ldtable, m, ldtable - 1, i, q, 1, 1, 0, nthreads, NULL, NULL);
+		basis[i] = q;
+		ncrash++;
+		for (j = 0; j < n; j++) {
+			if (table[j + rowi] != 0.)
+				cnt[j]++;
+		}
+	}
+	return ncrash;
 }
 
-/* Add artificial variables (GE, EQ) to simplex table
+/* Add artificial variables (GE, EQ rows not crashed) to simplex table
  * Return the number of artificial variables
  */
-static int simplex_add_artif(double *table, const int ldtable, const int *constypes,
+static int simplex_add_artif(double *table, const int ldtable, const int *constypes, const int *basis,
 			     const int m, const int n, const int nslack)
 {
 	int i, nartif = 0;
 
 	for (i = 0; i < m; i++) {
-		if (impf_CONS_T_LE != constypes[i]) {
+		if (impf_CONS_T_LE != constypes[i] && basis[i] < 0) {
 			table[n + nslack + nartif + (i + 1) * ldtable] =  1.;
 			table[n + nslack + nartif] = -1.;
 			nartif++;
@@ -416,7 +1752,7 @@ static int simplex_add_artif(double *table, const int ldtable, const int *consty
 	return nartif;
 }
 
-/* Fill in the basis index set of artificial LP
+/* Fill in the basis index set of artificial LP, keeping crashed rows
  */
 static void simplex_fill_artiflp_basis(int *basis, const int *constypes,
 				       const int m, const int n, const int nslack)
@@ -426,13 +1762,17 @@ static void simplex_fill_artiflp_basis(int *basis, const int *constypes,
 	for (i = 0; i < m; i++) {
 		switch (constypes[i]) {
 		case impf_CONS_T_EQ:
+			if (basis[tmp_nbasis] >= 0)
+				break;
 			*(basis + tmp_nbasis) = n + nslack + tmp_nartif;
 			tmp_nartif++;
 			break;
 		case impf_CONS_T_GE:
+			tmp_nslack++;
+			if (basis[tmp_nbasis] >= 0)
+				break;
 			*(basis + tmp_nbasis) = n + nslack + tmp_nartif;
 			tmp_nartif++;
-			tmp_nslack++;
 			break;
 		case impf_CONS_T_LE:
 			*(basis + tmp_nbasis) = n + tmp_nslack;
@@ -443,29 +1783,32 @@ static void simplex_fill_artiflp_basis(int *basis, const int *constypes,
 	}
 }
 
-static void simplex_fill_artiflp_nrcost(double *table, const int ldtable, const int *constypes,
-					const int m, const int ncol)
+static void simplex_fill_artiflp_nrcost(double *table, const int ldtable, const int *basis,
+					const int m, const int nreal, const int ncol)
 {
 	int i, rowi;
 
 	for (i = 0; i < m; i++) {
-		if (impf_CONS_T_LE == constypes[i])
+		if (basis[i] < nreal)  /* slack or crashed basic variable */
 			continue;
 		rowi = (i + 1) * ldtable;
 		impf_linalg_daxpy(ncol, 1, table + rowi, 1, table, 1);
 	}
 }
 
-static void transf_artif_basis(double *table, int ldtable, int *basis, const int m, const int nreal, int nvar)
+static void transf_artif_basis(double *table, int ldtable, int *basis, const int m, const int nreal, int nvar,
+			       const int nthreads)
 {
-	int i, j, q = nvar;
-	double ele, maxv = __impf_NINF__;
+	int i, j, q;
+	double ele, maxv;
 
 	if (is_basis_valid(basis, m, nreal))
 		return;
 	for (i = 0; i < m; i++) {
 		if (basis[i] <nreal)
 			continue;
+		q = nvar;
+		maxv = __impf_NINF__;
 		for (j = 0; j < nreal; j++) {
 			ele = __impf_ABS__(table[j + (i + 1) * ldtable]);
 			if (ele > maxv) {
@@ -478,13 +1821,12 @@ static void transf_artif_basis(double *table, int ldtable, int *basis, const int
 			impf_memset(table + (i + 1) * ldtable, 0, nreal * sizeof(double));
 			continue;
 		}
-		simplex_pivot_core(table, ldtable, m, nvar, i, q, 1, 1, 0);
+		simplex_pivot_core(table, ldtable, m, nvar, i, q, 1, 1, 0, nthreads, NULL, NULL);
 		basis[i] = q;
 #ifdef IMPF_MODE_DEV
-		printf("in 'transf_artif_basis'\n");
-		printf("switch %i <----> %i\n", i, q);
+		impf_prt_dev("in 'transf_artif_basis'\n");
+		impf_prt_dev("switch %i <----> %i\n", i, q);
 #endif
-		q = nvar;
 	}
 }
 
@@ -503,157 +1845,897 @@ static void delete_artif_cols(double *table, const int ldtable, const int m, con
 /* Phase 1: get a BFS for the original problem using the usual way - artificial LP
  *
  * Work:
- * 	1. allocate memory for table, basis, constypes
+ * 	1. place table, basis, constypes in workspace
  * 	2. form a basic feasible solution (BSF)
  * 	3. assign ldtable and nvar, the number of vars in BSF
  */
-static int simplex_phase_1_usul(double **table, int *ldtable, int **basis, int **constypes,
+static int simplex_phase_1_usul(struct impf_LP_Workspace *ws, double **table, int *ldtable, int **basis,
+				int **constypes, double **ub, int **flip, double *scale, struct simplex_price *price,
 				int *nvar, int *epoch, int *code,
-				const struct impf_LinearConstraint *constraints,
-				const int m, const int n, const char *criteria, const int niter)
+				const struct impf_LinearConstraint *constraints, const double *ub0,
+				const int m, const int n, const int niter)
 {
-	int nrow, ncol;
-	int nslack, nartif;
+	int i, nrow, ncol;
+	int nslack, nartif, ncrash;
 
 #ifdef IMPF_MODE_DEV
-	printf(">>> Reformulate, code = %i\n", *code);
+	impf_prt_dev(">>> Reformulate, code = %i\n", *code);
 #endif
 	simplex_table_size_usul(constraints, m, n, &nrow, &ncol);
 	*ldtable = ncol;  /* leading dimension of table in memory */
-	if (simplex_create_buffer(table, basis, constypes, m, nrow, *ldtable) == impf_EXIT_FAILURE) {
-		*code = impf_MemoryAllocError;
-		return impf_EXIT_FAILURE;
-	}
+	simplex_create_buffer(ws, table, basis, constypes, ub, flip, price, m, n, nrow, *ldtable);
+	simplex_fill_ub(*ub, *flip, ub0, n, ncol);
 
 	simplex_fill_constypes(constraints, *constypes, m);
 	simplex_fill_conscoefs(*table, *ldtable, constraints, nrow, ncol, m, n);
+	simplex_scale(*table, *ldtable, *ub, scale, m, n);
 	nslack = simplex_add_slack(*table, *ldtable, *constypes, m, n);
-	nartif = simplex_add_artif(*table, *ldtable, *constypes, m, n, nslack);
+	ncrash = simplex_crash(*table, *ldtable, *basis, *ub, *constypes, ws->ints, m, n, price->nthreads);
+	nartif = simplex_add_artif(*table, *ldtable, *constypes, *basis, m, n, nslack);
 	*nvar = n + nslack + nartif;  /* will be recovered to `n + nslack` upon success */
 	if (m > (*nvar)) {
 		*code = impf_OverDetermination;
-		goto END;
+		return impf_EXIT_FAILURE;
 	}
+	for (i = 0; i < m + 1 && *nvar < ncol - 1; i++)  /* rhs moves before unused artificials */
+		(*table)[*nvar + i * (*ldtable)] = (*table)[ncol - 1 + i * (*ldtable)];
 	simplex_fill_artiflp_basis(*basis, *constypes, m, n, nslack);
-	simplex_fill_artiflp_nrcost(*table, *ldtable, *constypes, m, ncol);
+	simplex_init_norms(*table, *ldtable, m, *nvar, price->norms);
+	simplex_fill_artiflp_nrcost(*table, *ldtable, *basis, m, n + nslack, *nvar + 1);
 
 #ifdef IMPF_MODE_DEV
-	printf(">>> n = %i, nslack = %i, nartif = %i\n", n, nslack, nartif);
-	printf(">>> table size = (%i, %i)\n", nrow, ncol);
-	printf(">>> Pivoting, code = %i\n", *code);
+	impf_prt_dev(">>> n = %i, nslack = %i, nartif = %i, ncrash = %i\n", n, nslack, nartif, ncrash);
+	impf_prt_dev(">>> table size = (%i, %i)\n", nrow, ncol);
+	impf_prt_dev(">>> Pivoting, code = %i\n", *code);
 #endif
-	switch (simplex_pivot_bsc(epoch, *table, *ldtable, *basis, m, *nvar, n + nslack, criteria, niter)) {
+	switch (simplex_pivot_bsc(epoch, *table, *ldtable, *basis, *ub, *flip, price,
+				  m, *nvar, n + nslack, niter)) {
 	case 0:
 		*code = impf_ExceedIterLimit;
-		goto END;
+		break;
 	case 1:
-		if ((*table)[ncol - 1] > __impf_CHC_SPLX_FEASIBLE__) {
+		if ((*table)[*nvar] > __impf_CHC_SPLX_FEASIBLE__) {
 			*code = impf_Infeasibility;
-			goto END;
+			break;
 		}
-		transf_artif_basis(*table, *ldtable, *basis, m, n + nslack, *nvar);
+		transf_artif_basis(*table, *ldtable, *basis, m, n + nslack, *nvar, price->nthreads);
 		delete_artif_cols(*table, *ldtable, m, n + nslack, nartif);
 		*nvar = n + nslack;
 		return impf_EXIT_SUCCESS;
 	case 2:
 		*code = impf_Unboundedness;
-		goto END;
-	case 3:
-		*code = impf_Degeneracy;
-		goto END;
+		break;
 	case 9:
 		*code = impf_PrecisionError;
-		goto END;
+		break;
 	}
-END:
-	simplex_free_buffer(*table, *basis, *constypes);
 	return impf_EXIT_FAILURE;
 }
 
 /* Phase 2: Solve the original problem
  */
-static int simplex_phase_2_usul(double *table, int ldtable, int *basis, int *constypes,
-				int *epoch, int *code, const int m, const int n,
-				const int nvar, const char *criteria, const int niter)
+static int simplex_phase_2_usul(double *table, int ldtable, int *basis, double *ub, int *flip,
+				struct simplex_price *price, int *epoch, int *code, const int m, const int nvar,
+				const int niter)
 {
 #ifdef IMPF_MODE_DEV
-	printf(">>> m = %i, n = %i, nvar = %i\n", m, n, nvar);
-	printf(">>> Pivoting, code = %i\n", *code);
+	impf_prt_dev(">>> m = %i, nvar = %i\n", m, nvar);
+	impf_prt_dev(">>> Pivoting, code = %i\n", *code);
 #endif
-	switch (simplex_pivot_bsc(epoch, table, ldtable, basis, m, nvar, nvar, criteria, niter)) {
+	switch (simplex_pivot_bsc(epoch, table, ldtable, basis, ub, flip, price, m, nvar, nvar, niter)) {
 	case 0:
 		*code = impf_ExceedIterLimit;
-		goto END;
+		break;
 	case 1:
 		*code = impf_Success;
 		return impf_EXIT_SUCCESS;
 	case 2:
 		*code = impf_Unboundedness;
-		goto END;
-	case 3:
-		*code = impf_Degeneracy;
-		goto END;
+		break;
 	case 9:
 		*code = impf_PrecisionError;
-		goto END;
+		break;
 	}
-END:
-	simplex_free_buffer(table, basis, constypes);
 	return impf_EXIT_FAILURE;  /* error code already updated */
 }
 
-int impf_lp_simplex_std(const double *objective, const struct impf_LinearConstraint *constraints,
-			const int m, const int n, const char *criteria, const int niter,
-			double *x, double *value, int *code)
+/* Warm start: form the basis of `status0` in place of Phase 1
+ *
+ * Work:
+ * 	1. fill in the table in workspace as Phase 1 without artificials
+ * 	2. substitute variables at their upper bounds by `ub - x`
+ * 	3. pivot the basic variables in, each on the row with the largest entry
+ *
+ * Return `EXIT_FAILURE` if `status0` is not a basis or its basic solution is
+ * not feasible
+ */
+static int simplex_warm_usul(struct impf_LP_Workspace *ws, double **table, int *ldtable, int **basis,
+			     int **constypes, double **ub, int **flip, double *scale, struct simplex_price *price,
+			     int *nvar, const struct impf_LinearConstraint *constraints,
+			     const double *ub0, const int *status0, const int m, const int n)
+{
+	int i, j, k, p, q, nrow, ncol, nbasic = 0;
+	double maxv, *x_i;
+
+	simplex_table_size_usul(constraints, m, n, &nrow, &ncol);
+	*ldtable = ncol;
+	simplex_create_buffer(ws, table, basis, constypes, ub, flip, price, m, n, nrow, *ldtable);
+	simplex_fill_ub(*ub, *flip, ub0, n, ncol);
+	simplex_fill_constypes(constraints, *constypes, m);
+	simplex_fill_conscoefs(*table, *ldtable, constraints, nrow, ncol, m, n);
+	simplex_scale(*table, *ldtable, *ub, scale, m, n);
+	*nvar = n + simplex_add_slack(*table, *ldtable, *constypes, m, n);
+	for (i = 0; i < m + 1 && *nvar < ncol - 1; i++)
+		(*table)[*nvar + i * (*ldtable)] = (*table)[ncol - 1 + i * (*ldtable)];
+	simplex_init_norms(*table, *ldtable, m, *nvar, price->norms);
+
+	for (i = 0; i < m; i++)
+		(*basis)[i] = -1;
+	for (j = 0, k = n; j < n + m; j++) {  /* k: column of the next slack */
+		if (j >= n && impf_CONS_T_EQ == (*constypes)[j - n]) {  /* no slack */
+			if (status0[j] != impf_BASIS_T_LOWER)
+				return impf_EXIT_FAILURE;
+			continue;
+		}
+		q = j < n ? j : k++;
+		switch (status0[j]) {
+		case impf_BASIS_T_LOWER:
+			break;
+		case impf_BASIS_T_UPPER:
+			if (j >= n || (*ub)[j] == __impf_INF__)
+				return impf_EXIT_FAILURE;
+			simplex_flip_col(*table, *ldtable, 1, *table, m, *nvar, j, (*ub)[j]);
+			(*flip)[j] = 1;
+			break;
+		case impf_BASIS_T_BASIC:
+			p = m;
+			maxv = __impf_CTR_SPLX_PIV_LEV__;
+			for (i = 0; i < m; i++) {
+				if ((*basis)[i] < 0 && __impf_ABS__((*table)[q + (i + 1) * (*ldtable)]) > maxv) {
+					maxv = __impf_ABS__((*table)[q + (i + 1) * (*ldtable)]);
+					p = i;
+				}
+			}
+			if (p == m)  /* singular basis */
+				return impf_EXIT_FAILURE;
+			simplex_pivot_core(*table, *ldtable, m, *nvar, p, q, 1, 1, 0, price->nthreads, NULL, NULL);
+			(*basis)[p] = q;
+			nbasic++;
+			break;
+		default:
+			return impf_EXIT_FAILURE;
+		}
+	}
+	if (nbasic != m)
+		return impf_EXIT_FAILURE;
+	for (i = 0; i < m; i++) {  /* basic solution within bounds */
+		x_i = *table + *nvar + (i + 1) * (*ldtable);
+		if (*x_i < -__impf_CTR_SPLX_HARRIS__ || *x_i > (*ub)[(*basis)[i]] + __impf_CTR_SPLX_HARRIS__)
+			return impf_EXIT_FAILURE;
+		*x_i = __impf_MIN__(__impf_MAX__(*x_i, 0.), (*ub)[(*basis)[i]]);
+	}
+	return impf_EXIT_SUCCESS;
+}
+
+/* Fill in `row0` (length = nvar + 1) with row 0 of the table of `objective`
+ * in the current basis, it could be row 0 of the table itself
+ */
+static void simplex_fill_cost(double *row0, const double *table, const int ldtable, const int *basis,
+			      const double *ub, const int *flip, const double *scale,
+			      const double *objective, const int m, const int n, const int nvar)
+{
+	int i, j;
+
+	impf_memset(row0, 0., (nvar + 1) * sizeof(double));
+	for (j = 0; j < n; j++) {  /* Fill in original objective coefficients, scaled */
+		double c = objective[j] * scale[m + j];
+
+		if (flip[j]) {  /* x_j = ub_j - x'_j */
+			row0[j] = c;
+			row0[nvar] += c * ub[j];
+		} else
+			row0[j] = -c;
+	}
+	for (i = 0; i < m; i++) {  /* row_0 = row_0 - ratio * row_{i+1} */
+		int rowi = (i + 1) * ldtable;
+
+		if (basis[i] < nvar)  /* not an artificial left in a redundant row */
+			impf_linalg_daxpy(nvar + 1, -row0[basis[i]], table + rowi, 1, row0, 1);
+	}
+}
+
+/* Solution of the original variables (length = n) of the current basis
+ */
+static void simplex_get_x(const double *table, const int ldtable, const int *basis, const double *ub,
+			  const int *flip, const double *scale, const int m, const int n, const int nvar,
+			  double *x)
+{
+	int i, j;
+
+	for (j = 0; j < n; j++)
+		x[j] = flip[j] ? ub[j] : 0.;
+	for (i = 0; i < m; i++) {
+		if (basis[i] < n) {
+			j = basis[i];
+			x[j] = table[nvar + (i + 1) * ldtable];
+			if (flip[j])
+				x[j] = ub[j] - x[j];
+		}
+	}
+	for (j = 0; j < n; j++)  /* Unscale x = S y */
+		x[j] *= scale[m + j];
+}
+
+/* Export the status of variables and slacks (length = n + m) of the basis
+ */
+static void simplex_get_status(const int *constypes, const int *flip, const struct simplex_price *price,
+			       const int m, const int n, int *status)
 {
 	int i, j;
+
+	for (j = 0; j < n; j++) {
+		if (price->isbasic[j])
+			status[j] = impf_BASIS_T_BASIC;
+		else
+			status[j] = flip[j] ? impf_BASIS_T_UPPER : impf_BASIS_T_LOWER;
+	}
+	for (i = 0, j = n; i < m; i++) {  /* j: column of the next slack */
+		status[n + i] = impf_BASIS_T_LOWER;
+		if (impf_CONS_T_EQ == constypes[i])
+			continue;
+		if (price->isbasic[j])
+			status[n + i] = impf_BASIS_T_BASIC;
+		j++;
+	}
+}
+
+/* Column `z = B^-1 e_i` of the scaled table, with `B` the basis of its
+ * starting columns: the slack column of row i (negated for GE rows), or
+ * column `e` of the solution `Z` of `B Z = E` of EQ rows, where `E` holds the
+ * unit vectors of EQ rows
+ */
+static double simplex_sens_z(const double *table, const int ldtable, const double *zeq, const int neq,
+			     const int col, const double sign, const int p)
+{
+	if (zeq != NULL)
+		return zeq[col + p * neq];
+	return sign * table[col + (p + 1) * ldtable];
+}
+
+/* Solve the columns of `B^-1` of EQ rows (see `simplex_sens_z`), `zeq` is
+ * allocated (length = m * neq) and should be released
+ */
+static int simplex_sens_eq(const int *basis, const int *constypes, const int *flip, const double *scale,
+			   const struct impf_LinearConstraint *constraints, const int m, const int n,
+			   const int nvar, const int neq, double **zeq, int *code)
+{
+	int i, j, p, e, state;
+	double *bmat, *emat, *buffer;
+	int *ipvt, *slackrow;
+
+	*zeq = impf_malloc((2 * m * neq + m * m + m * (m + neq)) * sizeof(double));
+	ipvt = impf_malloc((m + nvar - n + 1) * sizeof(int));
+	if (*zeq == NULL || ipvt == NULL) {
+		if (*zeq)
+			impf_free(*zeq);
+		if (ipvt)
+			impf_free(ipvt);
+		*code = impf_MemoryAllocError;
+		return impf_EXIT_FAILURE;
+	}
+	emat = *zeq + m * neq;
+	bmat = emat + m * neq;
+	buffer = bmat + m * m;
+	slackrow = ipvt + m;
+	impf_memset(emat, 0, (m * neq + m * m) * sizeof(double));
+	for (i = 0, j = 0, e = 0; i < m; i++) {
+		if (impf_CONS_T_EQ == constypes[i])
+			emat[e++ + i * neq] = 1.;
+		else
+			slackrow[j++] = i;
+	}
+	for (p = 0; p < m; p++) {  /* column p of B is the starting column of basis[p] */
+		j = basis[p];
+		if (j < n) {
+			for (i = 0; i < m; i++)
+				bmat[p + i * m] = (constraints[i].rhs < 0 ? -1. : 1.) * (flip[j] ? -1. : 1.)
+						  * scale[i] * constraints[i].coef[j] * scale[m + j];
+		} else if (j < nvar) {
+			i = slackrow[j - n];
+			bmat[p + i * m] = impf_CONS_T_LE == constypes[i] ? 1. : -1.;
+		} else  /* artificial left in a redundant row */
+			bmat[p + p * m] = 1.;
+	}
+	state = impf_linalg_dgels_n(m, neq, bmat, m, emat, neq, ipvt, *zeq, buffer, code);
+	impf_free(ipvt);
+	if (state == impf_EXIT_FAILURE) {
+		impf_free(*zeq);
+		*zeq = NULL;
+	}
+	return state;
+}
+
+/* Sensitivity analysis of the optimal table (see `impf_LP_Sensitivity`)
+ *
+ * With `z = B^-1 e_i` of row i (see `simplex_sens_z`)
+ *	1. the dual of row i is `c_B' z`
+ *	2. the rhs of row i ranges while `x_B + t z` is within bounds
+ *	3. the cost of nonbasic `x_j` ranges while its reduced cost keeps sign,
+ *		the cost of basic `x_j` ranges while row 0 stays nonpositive
+ * and results are transformed back by the signs and scales of rows, scales of
+ * columns and flipped columns
+ */
+static int simplex_sensitivity(const double *table, const int ldtable, const int *basis, const int *isbasic,
+			       const int *constypes, const double *ub, const int *flip, const double *scale,
+			       const double *objective, const struct impf_LinearConstraint *constraints,
+			       const int m, const int n, const int nvar, struct impf_LP_Sensitivity *sens,
+			       int *code)
+{
+	int i, j, k, p, e, col, neq = 0, m_rows = m;
+	double *zeq = NULL, sign, rs, y, z, x_p, u_p, t_lo, t_up, f;
+	const double eps = __impf_CTR_SPLX_PIV_LEV__;
+
+	for (i = 0; i < m; i++)
+		neq += impf_CONS_T_EQ == constypes[i];
+	if (sens->dual == NULL && sens->rhslo == NULL && sens->rhsup == NULL)
+		m_rows = 0;  /* rows are not asked for */
+	else if (neq > 0 && simplex_sens_eq(basis, constypes, flip, scale, constraints, m, n, nvar, neq,
+					    &zeq, code) == impf_EXIT_FAILURE)
+		return impf_EXIT_FAILURE;
+
+	for (i = 0, k = n, e = 0; i < m_rows; i++) {  /* k: column of the next slack */
+		const double *zcol = NULL;
+
+		if (impf_CONS_T_EQ == constypes[i]) {
+			zcol = zeq;
+			col = e++;
+			sign = 1.;
+		} else {
+			col = k++;
+			sign = impf_CONS_T_LE == constypes[i] ? 1. : -1.;
+		}
+		rs = (constraints[i].rhs < 0 ? -1. : 1.) * scale[i];
+		y = 0.;
+		t_lo = __impf_NINF__;
+		t_up = __impf_INF__;
+		for (p = 0; p < m; p++) {
+			j = basis[p];
+			z = simplex_sens_z(table, ldtable, zcol, neq, col, sign, p);
+			if (j < n)
+				y += (flip[j] ? -1. : 1.) * objective[j] * scale[m + j] * z;
+			x_p = table[nvar + (p + 1) * ldtable];
+			u_p = j < nvar ? ub[j] : 0.;
+			if (z > eps) {
+				t_lo = __impf_MAX__(t_lo, -x_p / z);
+				t_up = __impf_MIN__(t_up, (u_p - x_p) / z);
+			} else if (z < -eps) {
+				t_up = __impf_MIN__(t_up, -x_p / z);
+				t_lo = __impf_MAX__(t_lo, (u_p - x_p) / z);
+			}
+		}
+		if (sens->dual != NULL)
+			sens->dual[i] = y * rs;
+		if (sens->rhslo != NULL)
+			sens->rhslo[i] = constraints[i].rhs + (rs > 0 ? t_lo : t_up) / rs;
+		if (sens->rhsup != NULL)
+			sens->rhsup[i] = constraints[i].rhs + (rs > 0 ? t_up : t_lo) / rs;
+	}
+	if (zeq != NULL)
+		impf_free(zeq);
+
+	for (j = 0; j < n; j++) {  /* nonbasic variables */
+		double d = isbasic[j] ? 0. : (flip[j] ? table[j] : -table[j]) / scale[m + j];
+
+		if (sens->redcost != NULL)
+			sens->redcost[j] = d;
+		if (isbasic[j])
+			continue;
+		if (sens->objlo != NULL)
+			sens->objlo[j] = flip[j] ? __impf_NINF__ : objective[j] - d;
+		if (sens->objup != NULL)
+			sens->objup[j] = flip[j] ? objective[j] - d : __impf_INF__;
+	}
+	for (p = 0; p < m; p++) {  /* basic variables */
+		const double *rowp = table + (p + 1) * ldtable;
+
+		j = basis[p];
+		if (j >= n)
+			continue;
+		t_lo = __impf_NINF__;
+		t_up = __impf_INF__;
+		for (k = 0; k < nvar; k++) {
+			if (isbasic[k])
+				continue;
+			if (rowp[k] > eps)
+				t_up = __impf_MIN__(t_up, -table[k] / rowp[k]);
+			else if (rowp[k] < -eps)
+				t_lo = __impf_MAX__(t_lo, -table[k] / rowp[k]);
+		}
+		f = (flip[j] ? -1. : 1.) * scale[m + j];
+		if (sens->objlo != NULL)
+			sens->objlo[j] = objective[j] + (f > 0 ? t_lo : t_up) / f;
+		if (sens->objup != NULL)
+			sens->objup[j] = objective[j] + (f > 0 ? t_up : t_lo) / f;
+	}
+	return impf_EXIT_SUCCESS;
+}
+
+/* Direction of parametric LP and its trace (see `impf_lp_simplex_param`),
+ * `cap` is the number of segments allocated in `trace`
+ */
+struct simplex_param {
+	const double *drhs;
+	const double *dobj;
+	double tmax;
+	struct impf_LP_Parametric *trace;
+	int cap;
+};
+
+/* Make room for one more segment in the trace
+ */
+static int simplex_param_reserve(struct simplex_param *par, const int m, const int n, int *code)
+{
+	struct impf_LP_Parametric *trace = par->trace;
+	int cap;
+	double *dbl;
+	int *ints;
+
+	if (trace->nseg < par->cap)
+		return impf_EXIT_SUCCESS;
+	cap = par->cap ? 2 * par->cap : 16;
+	if ((dbl = impf_realloc(trace->t, (cap + 1) * sizeof(double))) != NULL)
+		trace->t = dbl;
+	if (dbl != NULL && (dbl = impf_realloc(trace->value, (cap + 1) * sizeof(double))) != NULL)
+		trace->value = dbl;
+	if (dbl != NULL && (dbl = impf_realloc(trace->x, (cap + 1) * n * sizeof(double))) != NULL)
+		trace->x = dbl;
+	ints = dbl == NULL ? NULL : impf_realloc(trace->status, cap * (n + m) * sizeof(int));
+	if (ints == NULL) {
+		*code = impf_MemoryAllocError;
+		return impf_EXIT_FAILURE;
+	}
+	trace->status = ints;
+	par->cap = cap;
+	return impf_EXIT_SUCCESS;
+}
+
+/* Direction `d = B^-1 drhs` of the rhs column (length = m), with `drhs` of
+ * the rows of the scaled table (see `simplex_sens_z`)
+ */
+static int simplex_param_rhs(const double *table, const int ldtable, const int *basis, const int *constypes,
+			     const int *flip, const double *scale, const struct impf_LinearConstraint *constraints,
+			     const double *drhs, const int m, const int n, const int nvar, double *d, int *code)
+{
+	int i, k, e, p, col, neq = 0;
+	double *zeq = NULL, sign, rs;
+
+	for (i = 0; i < m; i++)
+		neq += impf_CONS_T_EQ == constypes[i];
+	if (neq > 0 && simplex_sens_eq(basis, constypes, flip, scale, constraints, m, n, nvar, neq,
+				       &zeq, code) == impf_EXIT_FAILURE)
+		return impf_EXIT_FAILURE;
+	impf_memset(d, 0, m * sizeof(double));
+	for (i = 0, k = n, e = 0; i < m; i++) {  /* k: column of the next slack */
+		const double *zcol = NULL;
+
+		if (impf_CONS_T_EQ == constypes[i]) {
+			zcol = zeq;
+			col = e++;
+			sign = 1.;
+		} else {
+			col = k++;
+			sign = impf_CONS_T_LE == constypes[i] ? 1. : -1.;
+		}
+		rs = (constraints[i].rhs < 0 ? -1. : 1.) * scale[i] * drhs[i];
+		for (p = 0; p < m && rs != 0.; p++)
+			d[p] += rs * simplex_sens_z(table, ldtable, zcol, neq, col, sign, p);
+	}
+	if (zeq != NULL)
+		impf_free(zeq);
+	return impf_EXIT_SUCCESS;
+}
+
+/* Solution and optimal value at `t` of the current basis, as breakpoint k of
+ * the trace
+ */
+static void simplex_param_point(const double *table, const int ldtable, const int *basis, const double *ub,
+				const int *flip, const double *scale, const double *objective,
+				const struct simplex_param *par, const int m, const int n, const int nvar,
+				const double t, const int k)
+{
+	int j;
+	double *x = par->trace->x + k * n, v = 0.;
+
+	simplex_get_x(table, ldtable, basis, ub, flip, scale, m, n, nvar, x);
+	for (j = 0; j < n; j++)
+		v += (par->dobj != NULL ? objective[j] + t * par->dobj[j] : objective[j]) * x[j];
+	par->trace->t[k] = t;
+	par->trace->value[k] = v;
+}
+
+/* Parametric LP from the optimal table at t = 0, tracing the optimal basis
+ * while t increases to `tmax` (see `impf_lp_simplex_param`)
+ *
+ * Along the rhs direction, the rhs column moves by `d = B^-1 drhs` and the
+ * segment ends when a basic variable reaches its bound, it then leaves the
+ * basis by a dual simplex pivot (LP is infeasible beyond if none enters).
+ * Along the cost direction, row 0 moves by row `r` of `dobj` and the segment
+ * ends when a nonbasic `beta_j` reaches 0, `x_j` then enters the basis by a
+ * primal simplex pivot (LP is unbounded beyond if none leaves)
+ *
+ * Note: segments not longer than `__impf_CTR_SPLX_PARAM_SEG__` are not
+ *	recorded, their pivots are taken all the same
+ */
+static int simplex_parametric(double *table, const int ldtable, int *basis, const int *constypes,
+			      const double *ub, int *flip, const double *scale, struct simplex_price *price,
+			      const double *objective, const struct impf_LinearConstraint *constraints,
+			      const int m, const int n, const int nvar, int *epoch, const int niter,
+			      struct simplex_param *par, int *code)
+{
+	struct impf_LP_Parametric *trace = par->trace;
+	int i, j, p, q, record, state = impf_EXIT_SUCCESS;
+	double t = 0., dt, tnext, x_p, u_p, *dir;
+	const double eps = __impf_CTR_SPLX_PIV_LEV__;
+
+	dir = impf_malloc((nvar + 1) * sizeof(double));
+	if (dir == NULL) {
+		*code = impf_MemoryAllocError;
+		return impf_EXIT_FAILURE;
+	}
+	if (par->drhs != NULL && simplex_param_rhs(table, ldtable, basis, constypes, flip, scale, constraints,
+						   par->drhs, m, n, nvar, dir, code) == impf_EXIT_FAILURE) {
+		impf_free(dir);
+		return impf_EXIT_FAILURE;
+	}
+	trace->nseg = 0;
+	simplex_param_point(table, ldtable, basis, ub, flip, scale, objective, par, m, n, nvar, t, 0);
+
+	while (1) {
+		dt = __impf_INF__;
+		p = m;
+		q = nvar;
+		if (par->drhs != NULL) {  /* the first basic variable to reach its bound */
+			for (i = 0; i < m; i++) {
+				x_p = table[nvar + (i + 1) * ldtable];
+				u_p = basis[i] < nvar ? ub[basis[i]] : 0.;
+				if (dir[i] < -eps && x_p / (-dir[i]) < dt) {
+					dt = x_p / (-dir[i]);
+					p = i;
+				} else if (dir[i] > eps && (u_p - x_p) / dir[i] < dt) {
+					dt = (u_p - x_p) / dir[i];
+					p = i;
+				}
+			}
+		} else {  /* the first nonbasic beta_j to reach 0 */
+			simplex_fill_cost(dir, table, ldtable, basis, ub, flip, scale, par->dobj, m, n, nvar);
+			for (j = 0; j < nvar; j++) {
+				if (!price->isbasic[j] && dir[j] > eps && -table[j] / dir[j] < dt) {
+					dt = -table[j] / dir[j];
+					q = j;
+				}
+			}
+		}
+		dt = __impf_MAX__(dt, 0.);
+		tnext = dt < par->tmax - t ? t + dt : par->tmax;
+		record = tnext - t > __impf_CTR_SPLX_PARAM_SEG__ * (1. + t);
+		if (record) {
+			if (simplex_param_reserve(par, m, n, code) == impf_EXIT_FAILURE) {
+				state = impf_EXIT_FAILURE;
+				break;
+			}
+			simplex_get_status(constypes, flip, price, m, n, trace->status + trace->nseg * (n + m));
+			simplex_param_point(table, ldtable, basis, ub, flip, scale, objective, par,
+					    m, n, nvar, t, trace->nseg);
+		}
+		for (i = 0; par->drhs != NULL && i < m; i++)
+			table[nvar + (i + 1) * ldtable] += (tnext - t) * dir[i];
+		for (j = 0; par->dobj != NULL && j < nvar + 1; j++)
+			table[j] += (tnext - t) * dir[j];
+		if (record)
+			simplex_param_point(table, ldtable, basis, ub, flip, scale, objective, par,
+					    m, n, nvar, tnext, ++trace->nseg);
+		t = tnext;
+		if (t >= par->tmax) {
+			trace->stop = impf_Success;
+			break;
+		}
+		if (*epoch >= niter) {
+			*code = impf_ExceedIterLimit;
+			state = impf_EXIT_FAILURE;
+			break;
+		}
+		(*epoch)++;
+		if (par->dobj != NULL) {
+			table[q] = 0.;
+			if (simplex_pivot_enter(table, basis, ub, flip, price, m, nvar, q) == 2) {
+				trace->stop = impf_Unboundedness;
+				break;
+			}
+			continue;
+		}
+		if (basis[p] >= nvar) {  /* artificial of a redundant row */
+			trace->stop = impf_Infeasibility;
+			break;
+		}
+		if (dir[p] > 0.) {  /* at the upper bound */
+			simplex_flip_row(table, ldtable, 1, nvar, p, basis[p], ub[basis[p]]);
+			flip[basis[p]] = !flip[basis[p]];
+			dir[p] = -dir[p];
+		}
+		table[nvar + (p + 1) * ldtable] = 0.;
+		q = simplex_dual_enter(table, price, nvar, p);
+		if (q == nvar) {
+			trace->stop = impf_Infeasibility;
+			break;
+		}
+		simplex_gather(table, price, m, nvar, q);
+		dir[p] /= price->colq[p + 1];
+		for (i = 0; i < m; i++) {
+			if (i != p)
+				dir[i] -= price->colq[i + 1] * dir[p];
+		}
+		simplex_pivot_basis(table, basis, price, m, nvar, p, q);
+	}
+	impf_free(dir);
+	return state;
+}
+
+/* Simplex algorithm of standard form with upper bounds, started from the
+ * basis of `status0` if not `NULL`, exporting the optimal basis to `status`
+ * and the sensitivity analysis to `sens` if not `NULL`, and tracing the
+ * parametric LP of `par` if not `NULL`
+ *
+ * All buffers are placed in workspace `ws` (enlarged if necessary)
+ */
+static int simplex_bnd(const double *objective, const struct impf_LinearConstraint *constraints,
+		       const double *ub, const int m, const int n, const char *criteria, const int niter,
+		       const int *status0, int *status, struct impf_LP_Sensitivity *sens,
+		       struct simplex_param *par, double *x, double *value, struct impf_LP_Workspace *ws,
+		       int *code)
+{
+	int j;
 	int ldtable;
 	int nvar;
 	int epoch = 0;
 	int *basis = NULL;
 	double *table = NULL;
 	int *constypes = NULL;
+	double *ubs = NULL;
+	int *flip = NULL;
+	double *scale = NULL;
+	struct simplex_price price;
+	int builtin, ndbl, nint;
 
 	assert(objective != NULL);
 	assert(constraints != NULL);
 	assert(x != NULL);
 	assert(value != NULL);
+	assert(ws != NULL);
 	assert(code != NULL);
 
+	price.rule = simplex_find_rule(criteria, &builtin);
+	price.state = builtin ? &price : price.rule->state;
+	price.nthreads = ws->nthreads;
+	if (price.nthreads < 1) {
+		*code = impf_CondUnsatisfied;
+		return impf_EXIT_FAILURE;
+	}
+
+	for (j = 0; ub != NULL && j < n; j++) {
+		if (ub[j] < 0.) {
+			*code = impf_Infeasibility;
+			return impf_EXIT_FAILURE;
+		}
+	}
+	if (simplex_ws_reserve(ws, m, n, code) == impf_EXIT_FAILURE)
+		return impf_EXIT_FAILURE;
+	scale = ws->dbl;
+	price.cols = NULL;  /* registered rules read the row-major table */
+	if (builtin && simplex_by_col(ws->layout, m, n)) {
+		simplex_ws_size(m, n, 0, &ndbl, &nint);
+		price.cols = ws->dbl + ndbl;
+	}
+	*code = impf_Success;
+	if (status0 != NULL
+	    && simplex_warm_usul(ws, &table, &ldtable, &basis, &constypes, &ubs, &flip, scale, &price, &nvar,
+				 constraints, ub, status0, m, n) == impf_EXIT_SUCCESS) {
 #ifdef IMPF_MODE_DEV
-	printf("Phase 1 Begin: code = %i\n", *code);
+		impf_prt_dev("Warm start: Phase 1 skipped\n");
 #endif
-	if (simplex_phase_1_usul(&table, &ldtable, &basis, &constypes, &nvar, &epoch, code,
-				 constraints, m, n, criteria, niter) == impf_EXIT_FAILURE)
-		return impf_EXIT_FAILURE;
+	} else {
 #ifdef IMPF_MODE_DEV
-	printf("Phase 1 Done.\n");
+		impf_prt_dev("Phase 1 Begin: code = %i\n", *code);
 #endif
-
+		if (simplex_phase_1_usul(ws, &table, &ldtable, &basis, &constypes, &ubs, &flip, scale, &price,
+					 &nvar, &epoch, code, constraints, ub, m, n, niter) == impf_EXIT_FAILURE)
+			return impf_EXIT_FAILURE;
 #ifdef IMPF_MODE_DEV
-	printf("Phase 2 Begin:\n");
+		impf_prt_dev("Phase 1 Done.\n");
 #endif
-	for (j = 0; j < n; j++)  /* Fill in original objective coefficients */
-		table[j] = -objective[j];
-	for (i = 0; i < m; i++) {  /* row_0 = row_0 - ratio * row_{i+1} */
-		int rowi = (i + 1) * ldtable;
-		double ratio = -table[basis[i]];
-
-		impf_linalg_daxpy(nvar + 1, ratio, table + rowi, 1, table, 1);
 	}
-	if (simplex_phase_2_usul(table, ldtable, basis, constypes, &epoch, code,
-				 m, n, nvar, criteria, niter) == impf_EXIT_FAILURE)
+
+#ifdef IMPF_MODE_DEV
+	impf_prt_dev("Phase 2 Begin:\n");
+#endif
+	simplex_fill_cost(table, table, ldtable, basis, ubs, flip, scale, objective, m, n, nvar);
+	if (simplex_phase_2_usul(table, ldtable, basis, ubs, flip, &price, &epoch, code,
+				 m, nvar, niter) == impf_EXIT_FAILURE)
 		return impf_EXIT_FAILURE;
 #ifdef IMPF_MODE_DEV
-	printf("Phase 2 Done.\n");
+	impf_prt_dev("Phase 2 Done.\n");
 #endif
 
 	*value = table[nvar];
-	impf_memset(x, 0., n * sizeof(double));
-	for (i = 0; i < m; i++) {
-		if (basis[i] < n)
-			x[basis[i]] = table[nvar + (i + 1) * ldtable];
-	}
-	simplex_free_buffer(table, basis, constypes);
+	simplex_get_x(table, ldtable, basis, ubs, flip, scale, m, n, nvar, x);
+	if (status != NULL)
+		simplex_get_status(constypes, flip, &price, m, n, status);
+	if (sens != NULL && simplex_sensitivity(table, ldtable, basis, price.isbasic, constypes, ubs, flip, scale,
+						objective, constraints, m, n, nvar, sens, code) == impf_EXIT_FAILURE)
+		return impf_EXIT_FAILURE;
+	if (par != NULL)
+		return simplex_parametric(table, ldtable, basis, constypes, ubs, flip, scale, &price,
+					  objective, constraints, m, n, nvar, &epoch, niter, par, code);
 	return impf_EXIT_SUCCESS;
 }
+
+/* Simplex algorithm of standard form with upper bounds in a workspace used by
+ * this solve only
+ */
+static int simplex_bnd_once(const double *objective, const struct impf_LinearConstraint *constraints,
+			    const double *ub, const int m, const int n, const char *criteria, const int niter,
+			    const int *status0, int *status, struct impf_LP_Sensitivity *sens,
+			    struct simplex_param *par, double *x, double *value, int *code)
+{
+	struct impf_LP_Workspace ws;
+	int state;
+
+	if (impf_lp_workspace_init(&ws, m, n, code) == impf_EXIT_FAILURE)
+		return impf_EXIT_FAILURE;
+	state = simplex_bnd(objective, constraints, ub, m, n, criteria, niter, status0, status, sens, par,
+			    x, value, &ws, code);
+	impf_lp_workspace_free(&ws);
+	return state;
+}
+
+int impf_lp_simplex_bnd(const double *objective, const struct impf_LinearConstraint *constraints,
+			const double *ub, const int m, const int n, const char *criteria, const int niter,
+			double *x, double *value, int *code)
+{
+	return simplex_bnd_once(objective, constraints, ub, m, n, criteria, niter, NULL, NULL, NULL, NULL,
+				x, value, code);
+}
+
+int impf_lp_simplex_warm(const double *objective, const struct impf_LinearConstraint *constraints,
+			 const double *ub, const int m, const int n, const char *criteria, const int niter,
+			 const int *status0, int *status, double *x, double *value, int *code)
+{
+	return simplex_bnd_once(objective, constraints, ub, m, n, criteria, niter, status0, status, NULL, NULL,
+				x, value, code);
+}
+
+int impf_lp_simplex_sens(const double *objective, const struct impf_LinearConstraint *constraints,
+			 const double *ub, const int m, const int n, const char *criteria, const int niter,
+			 double *x, double *value, struct impf_LP_Sensitivity *sens, int *code)
+{
+	return simplex_bnd_once(objective, constraints, ub, m, n, criteria, niter, NULL, NULL, sens, NULL,
+				x, value, code);
+}
+
+int impf_lp_simplex_param(const double *objective, const struct impf_LinearConstraint *constraints,
+			  const double *ub, const int m, const int n, const char *criteria, const int niter,
+			  const double *drhs, const double *dobj, const double tmax,
+			  struct impf_LP_Parametric *trace, int *code)
+{
+	struct simplex_param par;
+	int state;
+
+	assert(trace != NULL);
+	assert(code != NULL);
+
+	trace->nseg = 0;
+	trace->t = NULL;
+	trace->value = NULL;
+	trace->x = NULL;
+	trace->status = NULL;
+	if ((drhs == NULL) == (dobj == NULL) || !(0. <= tmax && tmax < __impf_INF__)) {
+		*code = impf_CondUnsatisfied;
+		return impf_EXIT_FAILURE;
+	}
+	par.drhs = drhs;
+	par.dobj = dobj;
+	par.tmax = tmax;
+	par.trace = trace;
+	par.cap = 0;
+	trace->stop = impf_Success;
+	state = simplex_param_reserve(&par, m, n, code);
+	if (state == impf_EXIT_SUCCESS)
+		state = simplex_bnd_once(objective, constraints, ub, m, n, criteria, niter, NULL, NULL, NULL, &par,
+					 trace->x, trace->value, code);
+	if (state == impf_EXIT_FAILURE)
+		impf_lp_parametric_free(trace);
+	return state;
+}
+
+void impf_lp_parametric_free(struct impf_LP_Parametric *trace)
+{
+	if (trace->t)
+		impf_free(trace->t);
+	if (trace->value)
+		impf_free(trace->value);
+	if (trace->x)
+		impf_free(trace->x);
+	if (trace->status)
+		impf_free(trace->status);
+	trace->t = NULL;
+	trace->value = NULL;
+	trace->x = NULL;
+	trace->status = NULL;
+}
+
+int impf_lp_simplex_ws(const double *objective, const struct impf_LinearConstraint *constraints,
+		       const double *ub, const int m, const int n, const char *criteria, const int niter,
+		       const int *status0, int *status, double *x, double *value,
+		       struct impf_LP_Workspace *ws, int *code)
+{
+	return simplex_bnd(objective, constraints, ub, m, n, criteria, niter, status0, status, NULL, NULL,
+			   x, value, ws, code);
+}
+
+int impf_lp_simplex_bnd_batch(const double *objectives, const struct impf_LinearConstraint *constraints,
+			      const double *rhs, const double *ub, const int m, const int n, const int nbatch,
+			      const char *criteria, const int niter, const int nthreads,
+			      double *x, double *value, int *code)
+{
+	int nfail = 0;
+
+	assert(objectives != NULL);
+	assert(constraints != NULL);
+	assert(x != NULL);
+	assert(value != NULL);
+	assert(code != NULL);
+
+	impf_linalg_simd();  /* detected before threads start */
+#ifdef _OPENMP
+#pragma omp parallel num_threads(nthreads) if (nthreads > 1) reduction(+:nfail)
+#endif
+	{  /* each thread solves in its own workspace and copy of constraints */
+		struct impf_LP_Workspace ws;
+		struct impf_LinearConstraint *cons = impf_malloc((m + 1) * sizeof(struct impf_LinearConstraint));
+		int i, k, ok = 0, code_ws;
+
+		if (cons != NULL && impf_lp_workspace_init(&ws, m, n, &code_ws) == impf_EXIT_SUCCESS) {
+			impf_memcpy(cons, constraints, m * sizeof(struct impf_LinearConstraint));
+			ok = 1;
+		}
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+		for (k = 0; k < nbatch; k++) {
+			if (!ok) {
+				code[k] = impf_MemoryAllocError;
+				nfail++;
+				continue;
+			}
+			for (i = 0; rhs != NULL && i < m; i++)
+				cons[i].rhs = rhs[i + k * m];
+			if (simplex_bnd(objectives + k * n, cons, ub, m, n, criteria, niter, NULL, NULL, NULL, NULL,
+					x + k * n, value + k, &ws, code + k) == impf_EXIT_FAILURE)
+				nfail++;
+		}
+		if (ok)
+			impf_lp_workspace_free(&ws);
+		if (cons != NULL)
+			impf_free(cons);
+	}
+#ifdef IMPF_MODE_DEV
+	impf_prt_dev(">>> Batch simplex done, nbatch = %i, nfail = %i\n", nbatch, nfail);
+#endif
+	return nfail == 0 ? impf_EXIT_SUCCESS : impf_EXIT_FAILURE;
+}
+
+int impf_lp_simplex_std(const double *objective, const struct impf_LinearConstraint *constraints,
+			const int m, const int n, const char *criteria, const int niter,
+			double *x, double *value, int *code)
+{
+	return impf_lp_simplex_bnd(objective, constraints, NULL, m, n, criteria, niter, x, value, code);
+}
@@ -2,6 +2,7 @@
  * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
  * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
  */
+#include <impf/linalg.h>
 #include <impf/fmin_lp.h>
 
 int impf_lp_simplex_wrp(const struct impf_Model_LP *model, const char *criteria, const int niter,
@@ -13,5 +14,32 @@ int impf_lp_simplex_wrp(const struct impf_Model_LP *model, const char *criteria,
 	struct impf_LinearConstraint *cons = model->constraints;
 	struct impf_VariableBound *bounds = model->bounds;
 
+	if (model->coefficients == NULL)
+		return impf_lp_simplex_csc(obj, model->colptr, model->rowidx, model->values, cons, bounds,
+					   m, n, criteria, niter, x, value, code);
 	return impf_lp_simplex(obj, cons, bounds, m, n, criteria, niter, x, value, code);
 }
+
+int impf_lp_simplex_batch(const struct impf_Model_LP *models, const int nmodel, const char *criteria,
+			  const int niter, const int nthreads, double **x, double *value, int *code)
+{
+	int k, nfail = 0;
+
+	assert(models != NULL);
+	assert(x != NULL);
+	assert(value != NULL);
+	assert(code != NULL);
+
+	impf_linalg_simd();  /* detected before threads start */
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1) schedule(dynamic) reduction(+:nfail)
+#endif
+	for (k = 0; k < nmodel; k++) {
+		if (impf_lp_simplex_wrp(models + k, criteria, niter, x[k], value + k, code + k) == impf_EXIT_FAILURE)
+			nfail++;
+	}
+#ifdef IMPF_MODE_DEV
+	impf_prt_dev(">>> Batch simplex done, nmodel = %i, nfail = %i\n", nmodel, nfail);
+#endif
+	return nfail == 0 ? impf_EXIT_SUCCESS : impf_EXIT_FAILURE;
+}
@@ -24,6 +24,7 @@ static PyObject* wrapper_impf_lp_simplex(PyObject* self, PyObject* args) {
 	double *obj_val = impf_malloc(sizeof(double) * n);
 	struct impf_VariableBound *bounds_val = NULL;
 	struct impf_LinearConstraint *constraints = impf_malloc(sizeof(struct impf_LinearConstraint) * m);
+	double *coef_val = impf_malloc(sizeof(double) * m * n);  /* rows of all constraints */
 	double *x = impf_malloc(sizeof(double) * n);
 	double value;
 	int error_code = 0;
@@ -65,7 +66,7 @@ static PyObject* wrapper_impf_lp_simplex(PyObject* self, PyObject* args) {
 		PyObject *const_i_coef = PyList_GetItem(consts_coef, i);
 		PyObject *const_i_rhs = PyList_GetItem(consts_rhs, i);
 		PyObject *const_i_type = PyList_GetItem(consts_type, i);
-		double *const_i_coef_value = impf_malloc(sizeof(double) * n);
+		double *const_i_coef_value = coef_val + i * n;
 
 		for(j = 0; j < n; j++) {
 			PyObject *item = PyList_GetItem(const_i_coef, j);
@@ -89,13 +90,10 @@ static PyObject* wrapper_impf_lp_simplex(PyObject* self, PyObject* args) {
 	}
 	if (x)
 		impf_free(x);
-	if (constraints) {
-		for (i = 0; i<m; i++) {
-			if (constraints[i].coef)
-				impf_free(constraints[i].coef);
-		}
+	if (constraints)
 		impf_free(constraints);
-	}
+	if (coef_val)
+		impf_free(coef_val);
 	if (obj_val)
 		impf_free(obj_val);
 	if (bounds_val)
@@ -3,6 +3,11 @@
  * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
  */
 #include <impf/utils.h>
+#include <impf/linalg.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -34,49 +39,23 @@ int maxabs_arri(const int *arr, const int len, const int inc)
 
 int argmaxabs_arrd(const double *arr, const int len, const int inc)
 {
-	int i, idx = 0;
-	double ele, maxv = __impf_NINF__;
-
 	assert(inc >= 1);
 
-	for (i = 0; i < len; i += inc) {
-		ele = __impf_ABS__(arr[i]);
-		if (ele > maxv) {
-			maxv = ele;
-			idx = i;
-		}
-	}
-	return idx;
+	return impf_linalg_idamax(len, arr, inc);
 }
 
 double maxabs_arrd(const double *arr, const int len, const int inc)
 {
-	int i;
-	double ele, maxv = __impf_NINF__;
-
 	assert(inc >= 1);
 
-	for (i = 0; i < len; i += inc) {
-		ele = __impf_ABS__(arr[i]);
-		if (ele > maxv)
-			maxv = ele;
-	}
-	return maxv;
+	return impf_linalg_damax(len, arr, inc);
 }
 
 double maxabs_arrd_gap(const double *arr1, const double *arr2, const int len, const int inc)
 {
-	int i;
-	double ele, maxv = __impf_NINF__;
-
 	assert(inc >= 1);
 
-	for (i = 0; i < len; i += inc) {
-		ele = __impf_ABS__(arr1[i] - arr2[i]);
-		if (ele > maxv)
-			maxv = ele;
-	}
-	return maxv;
+	return impf_linalg_damax_gap(len, arr1, arr2, inc);
 }
 
 void impf_prt_arri(const int *arr, const int len, const int inc)
@@ -160,11 +139,29 @@ void impf_prt_matd(const double *mat, const int ld, const int nrow, const int nc
 	}
 }
 
+void impf_prt_dev(const char *format, ...)
+{
+	va_list args;
+
+#ifdef _OPENMP
+	if (omp_in_parallel())
+		return;
+#endif
+	va_start(args, format);
+	vprintf(format, args);
+	va_end(args);
+}
+
 void *impf_malloc(size_t size)
 {
 	return malloc(size);
 }
 
+void *impf_realloc(void *ptr, size_t size)
+{
+	return realloc(ptr, size);
+}
+
 void impf_free(void *ptr)
 {
 	free(ptr);
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <impf/linalg.h>
+#include <math.h>
+#include <stdio.h>
+
+/* BLAS-1 kernels on all instruction sets supported, compared with the scalar
+ * loops on arrays of all lengths up to `L` (tails of the vector loops)
+ */
+#define L 40
+
+double x[L], y[L], ya[L], yb[L], xi[L];
+int indx[L];
+
+static double lcg(unsigned long *seed)
+{
+	*seed = (*seed * 1103515245UL + 12345UL) % 2147483648UL;
+	return (double)(*seed) / 1073741824. - 1.;
+}
+
+int main(void)
+{
+	int level, top, n, i;
+	unsigned long seed = 1;
+	double dot0, nrm0, amax0, gap0;
+	int idx0;
+
+	for (i = 0; i < L; i++) {
+		x[i] = lcg(&seed);
+		y[i] = lcg(&seed);
+	}
+	x[17] = -4.;  /* the largest absolute value, reached twice */
+	x[29] = 4.;
+	top = impf_linalg_simd();
+	printf("SIMD level = %i\n", top);
+
+	for (n = 0; n <= L; n++) {
+		impf_linalg_simd_limit(impf_SIMD_NONE);
+		assert(impf_linalg_simd() == impf_SIMD_NONE);
+		for (i = 0; i < n; i++)
+			ya[i] = y[i];
+		impf_linalg_daxpy(n, .3, x, 1, ya, 1);
+		impf_linalg_dscal(n, -1.7, ya, 1);
+		dot0 = impf_linalg_ddot(n, x, 1, y, 1);
+		nrm0 = impf_linalg_dnrm2(n, x, 1);
+		amax0 = impf_linalg_damax(n, x, 1);
+		gap0 = impf_linalg_damax_gap(n, x, y, 1);
+		idx0 = impf_linalg_idamax(n, x, 1);
+		assert(__impf_ABS__(nrm0 * nrm0 - impf_linalg_ddot(n, x, 1, x, 1)) < 1e-12);
+		assert(n <= 17 || idx0 == 17);
+
+		for (level = impf_SIMD_SSE2; level <= top; level++) {
+			assert(impf_linalg_simd_limit(level) == level);
+			for (i = 0; i < n; i++)
+				yb[i] = y[i];
+			impf_linalg_daxpy(n, .3, x, 1, yb, 1);
+			impf_linalg_dscal(n, -1.7, yb, 1);
+			for (i = 0; i < n; i++)
+				assert(ya[i] == yb[i]);  /* exactly the same */
+			assert(__impf_ABS__(impf_linalg_ddot(n, x, 1, y, 1) - dot0) < 1e-12);
+			assert(__impf_ABS__(impf_linalg_dnrm2(n, x, 1) - nrm0) < 1e-12);
+			assert(impf_linalg_damax(n, x, 1) == amax0);
+			assert(impf_linalg_damax_gap(n, x, y, 1) == gap0);
+			assert(impf_linalg_idamax(n, x, 1) == idx0);
+		}
+	}
+	impf_linalg_simd_limit(impf_SIMD_AVX512);
+
+	/* strided arrays */
+	idx0 = 0;
+	for (i = 0; i < L; i += 3) {
+		if (__impf_ABS__(x[i]) > __impf_ABS__(x[idx0]))
+			idx0 = i;
+	}
+	assert(impf_linalg_idamax(L, x, 3) == idx0);
+	assert(impf_linalg_idamax(L, x, 1) == 17);
+	assert(impf_linalg_damax(0, x, 1) == __impf_NINF__);
+	assert(impf_linalg_dnrm2(0, x, 1) == 0.);
+	assert(__impf_ABS__(impf_linalg_dnrm2(4, ya, 2) * impf_linalg_dnrm2(4, ya, 2)
+			    - ya[0] * ya[0] - ya[2] * ya[2]) < 1e-12);
+
+	/* subnormal entries, of which the reciprocal of the largest overflows */
+	for (i = 0, nrm0 = 0.; i < L; i++) {
+		xi[i] = 1e-310 * (i % 3 + 1);
+		nrm0 += (i % 3 + 1) * (i % 3 + 1);
+	}
+	nrm0 = 1e-310 * sqrt(nrm0);
+	for (level = impf_SIMD_NONE; level <= top; level++) {
+		impf_linalg_simd_limit(level);
+		assert(__impf_ABS__(impf_linalg_dnrm2(L, xi, 1) - nrm0) < 1e-10 * nrm0);
+	}
+	impf_linalg_simd_limit(impf_SIMD_AVX512);
+
+	/* sparse daxpy on the nonzeros of `x` gives the same results as daxpy */
+	for (i = 0; i < L; i += 2)
+		x[i] = 0.;
+	for (i = 0, n = 0; i < L; i++) {
+		ya[i] = y[i];
+		yb[i] = y[i];
+		if (x[i] != 0.) {
+			xi[n] = x[i];
+			indx[n++] = i;
+		}
+	}
+	impf_linalg_daxpy(L, -.7, x, 1, ya, 1);
+	impf_linalg_daxpyi(n, -.7, xi, indx, yb);
+	for (i = 0; i < L; i++)
+		assert(ya[i] == yb[i]);
+	return 0;
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <impf/fmin_lp.h>
+#include <stdio.h>
+
+/* LP Example (interior point method)
+ *
+ *         max    x1 + 2 * x2 + 3 * x3
+ *         s.t.   x1 +     x2 +     x3 <=  7
+ *                         x2 +     x3 ==  4
+ *                x1 -     x2          >= -1
+ *                0 <= x1, x2, x3 <= 4
+ *
+ * The solution is (3, 0, 4) and the optimal value is 15
+ *
+ * With a free, an upper bounded, a fixed and a shifted variable
+ *
+ *         min    -x1 - 2 * x2 + x3 + x4
+ *         s.t.   x1 +     x2 +     x3        <=  6
+ *                x1          -     x3 +   x4 ==  1
+ *                         x2          +   x4 >=  1
+ *                x1 free, x2 <= 3, x3 == 1, -2 <= x4
+ *
+ * the optimal value is -7, attained on the segment between (3, 2, 1, -1)
+ * and (2, 3, 1, 0)
+ */
+#define M 3        /* number of constraints */
+#define N 3        /* number of variables   */
+
+double obj[] = {-1., -2., -3.};        /* transform "max" into "min" */
+double constraint_1_coef[] = {1.,  1., 1.};
+double constraint_2_coef[] = {0.,  1., 1.};
+double constraint_3_coef[] = {1., -1., 0.};
+
+struct impf_LinearConstraint constraints[] = {
+	{ "", constraint_1_coef,  7., impf_CONS_T_LE },
+	{ "", constraint_2_coef,  4., impf_CONS_T_EQ },
+	{ "", constraint_3_coef, -1., impf_CONS_T_GE }
+};
+struct impf_VariableBound bounds[] = {
+	{ "x1", 0., 4., impf_BOUND_T_BS, impf_VAR_T_REAL },
+	{ "x2", 0., 4., impf_BOUND_T_BS, impf_VAR_T_REAL },
+	{ "x3", 0., 4., impf_BOUND_T_BS, impf_VAR_T_REAL }
+};
+
+double obj2[] = {-1., -2., 1., 1.};
+double constraint2_1_coef[] = {1., 1.,  1., 0.};
+double constraint2_2_coef[] = {1., 0., -1., 1.};
+double constraint2_3_coef[] = {0., 1.,  0., 1.};
+
+struct impf_LinearConstraint constraints2[] = {
+	{ "", constraint2_1_coef, 6., impf_CONS_T_LE },
+	{ "", constraint2_2_coef, 1., impf_CONS_T_EQ },
+	{ "", constraint2_3_coef, 1., impf_CONS_T_GE }
+};
+struct impf_VariableBound bounds2[] = {
+	{ "x1",  0., 0., impf_BOUND_T_FR, impf_VAR_T_REAL },
+	{ "x2",  0., 3., impf_BOUND_T_UP, impf_VAR_T_REAL },
+	{ "x3",  1., 1., impf_BOUND_T_BS, impf_VAR_T_REAL },
+	{ "x4", -2., 0., impf_BOUND_T_LO, impf_VAR_T_REAL }
+};
+
+int main(void)
+{
+	struct impf_Model_LP model;
+	double x[N + 1], value;
+	int colptr[N + 1] = {0, 2, 5, 7}, rowidx[7] = {0, 2, 0, 1, 2, 0, 1};
+	double values[7] = {1., 1., 1., 1., -1., 1., 1.};
+	int code, state;
+
+	state = impf_lp_interior(obj, constraints, bounds, M, N, 100, x, &value, &code);
+	printf("Error code = %u, value = %f\n", code, value);
+	assert(state == impf_EXIT_SUCCESS);
+	assert(__impf_ABS__(value + 15.) < 1e-6);
+	assert(__impf_ABS__(x[0] - 3.) < 1e-6);
+	assert(__impf_ABS__(x[1] - 0.) < 1e-6);
+	assert(__impf_ABS__(x[2] - 4.) < 1e-6);
+
+	/* the point is inside the optimal face */
+	state = impf_lp_interior(obj2, constraints2, bounds2, M, N + 1, 100, x, &value, &code);
+	printf("Error code = %u, value = %f\n", code, value);
+	assert(state == impf_EXIT_SUCCESS);
+	assert(__impf_ABS__(value + 7.) < 1e-6);
+	assert(__impf_ABS__(x[2] - 1.) < 1e-8);
+	assert(__impf_ABS__(x[0] + x[1] - 5.) < 1e-6);
+	assert(__impf_ABS__(x[0] + x[3] - 2.) < 1e-6);
+
+	/* sparse input */
+	state = impf_lp_interior_csc(obj, colptr, rowidx, values, constraints, bounds, M, N, 100,
+				     x, &value, &code);
+	assert(state == impf_EXIT_SUCCESS);
+	assert(__impf_ABS__(value + 15.) < 1e-6);
+	model.m = M;
+	model.n = N;
+	model.nnz = 7;
+	model.objective = obj;
+	model.coefficients = NULL;
+	model.colptr = colptr;
+	model.rowidx = rowidx;
+	model.values = values;
+	model.constraints = constraints;
+	model.bounds = bounds;
+	state = impf_lp_interior_wrp(&model, 100, x, &value, &code);
+	assert(state == impf_EXIT_SUCCESS);
+	assert(__impf_ABS__(value + 15.) < 1e-6);
+
+	/* infeasible */
+	constraints[0].rhs = 3.;
+	state = impf_lp_interior(obj, constraints, bounds, M, N, 100, x, &value, &code);
+	printf("Error code = %u\n", code);
+	assert(state == impf_EXIT_FAILURE);
+	assert(code == impf_Infeasibility);
+	constraints[0].rhs = 7.;
+
+	/* unbounded without the first constraint and the upper bounds */
+	state = impf_lp_interior(obj, constraints + 1, NULL, M - 1, N, 100, x, &value, &code);
+	printf("Error code = %u\n", code);
+	assert(state == impf_EXIT_FAILURE);
+	assert(code == impf_Unboundedness);
+	return 0;
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <impf/fmin_lp.h>
+#include <stdio.h>
+
+/* MIP Example (integer variables)
+ *
+ *         max    x1 + x2
+ *         s.t.   -2 * x1 +  2 * x2 >=  1
+ *                -8 * x1 + 10 * x2 <= 13
+ *                0 <= x1, x2 integer
+ *
+ * The LP relaxation is solved at (4, 4.5) with value 8.5, the integer
+ * solution is (1, 2) with value 3
+ */
+#define M 2        /* number of constraints */
+#define N 2        /* number of variables   */
+
+double obj[] = {-1., -1.};        /* transform "max" into "min" */
+double constraint_1_coef[] = {-2., 2.};
+double constraint_2_coef[] = {-8., 10.};
+
+struct impf_LinearConstraint constraints[] = {
+	{ "", constraint_1_coef,  1., impf_CONS_T_GE },
+	{ "", constraint_2_coef, 13., impf_CONS_T_LE }
+};
+struct impf_VariableBound bounds[] = {
+	{ "x1", 0., 0., impf_BOUND_T_LO, impf_VAR_T_INT },
+	{ "x2", 0., 0., impf_BOUND_T_LO, impf_VAR_T_INT }
+};
+
+/* Knapsack (binary variables)
+ *
+ *         max    sum_j v_j * y_j
+ *         s.t.   sum_j w_j * y_j <= 26
+ *                sum_j y_j       <=  5
+ *                y_j binary
+ *
+ * checked by enumerating all 2^10 choices
+ */
+#define NK 10
+
+double value_k[] = {-10., -13., -7., -8., -15., -4., -9., -12., -6., -11.};
+double weight_k[] = {5., 7., 4., 5., 9., 2., 6., 7., 3., 6.};
+double count_k[] = {1., 1., 1., 1., 1., 1., 1., 1., 1., 1.};
+
+struct impf_LinearConstraint constraints_k[] = {
+	{ "", weight_k, 26., impf_CONS_T_LE },
+	{ "", count_k,   5., impf_CONS_T_LE }
+};
+
+static double knapsack_enum(void)
+{
+	int s, j;
+	double w, c, v, best = 0.;
+
+	for (s = 0; s < (1 << NK); s++) {
+		for (j = 0, w = 0., c = 0., v = 0.; j < NK; j++) {
+			if (s >> j & 1) {
+				w += weight_k[j];
+				c += 1.;
+				v += value_k[j];
+			}
+		}
+		if (w <= 26. && c <= 5. && v < best)
+			best = v;
+	}
+	return best;
+}
+
+int main(void)
+{
+	struct impf_VariableBound bounds_k[NK];
+	double x[NK], value, best, w;
+	const char *criteria[] = {"", "best", "depth"};
+	int code, j, k, nthreads;
+	int state;
+
+	state = impf_lp_mip(obj, constraints, bounds, M, N, "", 1000, 1000, 1, x, &value, &code);
+	printf("Error code = %u, value = %f\n", code, value);
+	assert(state == impf_EXIT_SUCCESS);
+	assert(__impf_ABS__(value + 3.) < 1e-8);
+	assert(x[0] == 1.);
+	assert(x[1] == 2.);
+
+	/* the same values by node selections and threads */
+	for (j = 0; j < NK; j++) {
+		impf_memset(bounds_k[j].name, '\0', 16);
+		bounds_k[j].lb = 0.;
+		bounds_k[j].ub = 1.;
+		bounds_k[j].b_type = impf_BOUND_T_LO;  /* [0, 1] by `v_type` */
+		bounds_k[j].v_type = impf_VAR_T_BIN;
+	}
+	best = knapsack_enum();
+	for (k = 0; k < 3; k++) {
+		for (nthreads = 1; nthreads <= 4; nthreads += 3) {
+			state = impf_lp_mip(value_k, constraints_k, bounds_k, 2, NK, criteria[k], 1000, 10000,
+					    nthreads, x, &value, &code);
+			printf("criteria = \"%s\", threads = %i, value = %f\n", criteria[k], nthreads, value);
+			assert(state == impf_EXIT_SUCCESS);
+			assert(__impf_ABS__(value - best) < 1e-8);
+			for (j = 0, w = 0.; j < NK; j++) {
+				assert(x[j] == 0. || x[j] == 1.);
+				w += weight_k[j] * x[j];
+			}
+			assert(w <= 26.);
+		}
+	}
+
+	/* mixed: x1 continuous, the solution is (3.5, 4) with value 7.5 */
+	bounds[0].v_type = impf_VAR_T_REAL;
+	state = impf_lp_mip(obj, constraints, bounds, M, N, "", 1000, 1000, 2, x, &value, &code);
+	assert(state == impf_EXIT_SUCCESS);
+	assert(__impf_ABS__(value + 7.5) < 1e-8);
+	assert(__impf_ABS__(x[0] - 3.5) < 1e-8);
+	assert(x[1] == 4.);
+	bounds[0].v_type = impf_VAR_T_INT;
+
+	/* infeasible: 2 * x1 + 2 * x2 == 1 has no integer solution */
+	constraint_1_coef[0] = 2.;
+	constraints[0].type = impf_CONS_T_EQ;
+	state = impf_lp_mip(obj, constraints, bounds, M, N, "", 1000, 1000, 1, x, &value, &code);
+	assert(state == impf_EXIT_FAILURE);
+	assert(code == impf_Infeasibility);
+
+	/* too few nodes */
+	state = impf_lp_mip(value_k, constraints_k, bounds_k, 2, NK, "best", 1000, 2, 1, x, &value, &code);
+	assert(state == impf_EXIT_FAILURE);
+	assert(code == impf_ExceedIterLimit);
+	return 0;
+}
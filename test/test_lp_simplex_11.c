@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <impf/fmin_lp.h>
+#include <stdio.h>
+
+/* LP Example (dual simplex re-optimization)
+ *
+ *         max    x1 + 2 * x2 + 3 * x3
+ *         s.t.   x1 +     x2 +     x3 <= 10
+ *                         x2 +     x3 ==  7
+ *                x1 -     x2          >= -2
+ *                0 <= x1 <= 4, 1 <= x2 <= 5, 2 <= x3 <= 6
+ *
+ * The solution is (3, 1, 6) and the optimal value is 23. After changing the
+ * rhs of the first constraint to 9, the solution is (2, 1, 6) and the optimal
+ * value is 22.
+ */
+#define m 3        /* number of constraints */
+#define n 3        /* number of variables   */
+
+double obj[] = {-1., -2., -3.};        /* transform "max" into "min" */
+double constraint_1_coef[] = {1.,  1., 1.};
+double constraint_2_coef[] = {0.,  1., 1.};
+double constraint_3_coef[] = {1., -1., 0.};
+
+struct impf_LinearConstraint constraints[] = {
+	{ "", constraint_1_coef, 10., impf_CONS_T_LE },
+	{ "", constraint_2_coef,  7., impf_CONS_T_EQ },
+	{ "", constraint_3_coef, -2., impf_CONS_T_GE }
+};
+struct impf_VariableBound bounds[] = {
+	{ "x1", 0., 4., impf_BOUND_T_BS, impf_VAR_T_REAL },
+	{ "x2", 1., 5., impf_BOUND_T_BS, impf_VAR_T_REAL },
+	{ "x3", 2., 6., impf_BOUND_T_BS, impf_VAR_T_REAL }
+};
+
+int main(void)
+{
+	double x[n], value;
+	int basis[m] = {n, n + 1, n + 2};  /* slack basis */
+	int code;
+	int state = impf_lp_simplex_dual(obj, constraints, bounds, m, n, 1000, basis, x, &value, &code);
+
+	printf("Error code = %u\n", code);
+	assert(state == impf_EXIT_SUCCESS);
+	assert(__impf_ABS__(value + 23.) < 1e-8);
+	assert(__impf_ABS__(x[0] - 3.) < 1e-8);
+
+	/* re-optimize from the optimal basis */
+	constraints[0].rhs = 9.;
+	state = impf_lp_simplex_dual(obj, constraints, bounds, m, n, 1000, basis, x, &value, &code);
+	printf("Error code = %u\n", code);
+	assert(state == impf_EXIT_SUCCESS);
+	assert(__impf_ABS__(value + 22.) < 1e-8);
+	assert(__impf_ABS__(x[0] - 2.) < 1e-8);
+	assert(__impf_ABS__(x[1] - 1.) < 1e-8);
+	assert(__impf_ABS__(x[2] - 6.) < 1e-8);
+	return 0;
+}
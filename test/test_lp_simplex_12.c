@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <impf/fmin_lp.h>
+#include <stdio.h>
+
+/* LP Example (user defined pricing rule)
+ *
+ *         max    x1 + 2 * x2 + 3 * x3
+ *         s.t.   x1 +     x2 +     x3 <= 10
+ *                         x2 +     x3 ==  7
+ *                x1 -     x2          >= -2
+ *                0 <= x1 <= 4, 1 <= x2 <= 5, 2 <= x3 <= 6
+ *
+ * The solution is (3, 1, 6) and the optimal value is 23
+ */
+#define m 3        /* number of constraints */
+#define n 3        /* number of variables   */
+
+double obj[] = {-1., -2., -3.};        /* transform "max" into "min" */
+double constraint_1_coef[] = {1.,  1., 1.};
+double constraint_2_coef[] = {0.,  1., 1.};
+double constraint_3_coef[] = {1., -1., 0.};
+
+struct impf_LinearConstraint constraints[] = {
+	{ "", constraint_1_coef, 10., impf_CONS_T_LE },
+	{ "", constraint_2_coef,  7., impf_CONS_T_EQ },
+	{ "", constraint_3_coef, -2., impf_CONS_T_GE }
+};
+struct impf_VariableBound bounds[] = {
+	{ "x1", 0., 4., impf_BOUND_T_BS, impf_VAR_T_REAL },
+	{ "x2", 1., 5., impf_BOUND_T_BS, impf_VAR_T_REAL },
+	{ "x3", 2., 6., impf_BOUND_T_BS, impf_VAR_T_REAL }
+};
+
+/* State of the rule: number of calls of each callback */
+struct counter {
+	int ninit;
+	int nenter;
+	int nupdate;
+};
+
+void last_init(void *state, const double *table, const int ldtable, const int *basis,
+	       const int _m, const int _n)
+{
+	((struct counter *)state)->ninit++;
+}
+
+/* Choose the attractive variable of the largest index */
+int last_enter(void *state, const double *table, const int ldtable, const int *basis,
+	       const int *isbasic, const double *ub, const int _m, const int _n)
+{
+	int j;
+
+	((struct counter *)state)->nenter++;
+	for (j = _n - 1; j >= 0; j--) {
+		if (!isbasic[j] && table[j] > 1e-9)
+			return j;
+	}
+	return _n;
+}
+
+void last_update(void *state, const double *table, const int ldtable, const int *basis,
+		 const int _m, const int _n, const int p, const int q)
+{
+	assert(0 <= p && p < _m);
+	assert(0 <= q && q < _n);
+	((struct counter *)state)->nupdate++;
+}
+
+int main(void)
+{
+	double x[n], value;
+	int code, state;
+	struct counter cnt = { 0, 0, 0 };
+	struct impf_PricingRule rule = { "last", last_init, last_enter, last_update, NULL };
+
+	rule.state = &cnt;
+	assert(impf_lp_pricing_register(&rule) == impf_EXIT_SUCCESS);
+	assert(impf_lp_pricing_find("last") == &rule);
+	assert(impf_lp_pricing_find("dantzig") != &rule);
+
+	state = impf_lp_simplex_gen(obj, constraints, bounds, m, n, "last", 1000, x, &value, &code);
+	printf("error code = %u, init = %i, enter = %i, update = %i\n",
+	       code, cnt.ninit, cnt.nenter, cnt.nupdate);
+	assert(state == impf_EXIT_SUCCESS);
+	assert(__impf_ABS__(value + 23.) < 1e-8);
+	assert(__impf_ABS__(x[0] - 3.) < 1e-8);
+	assert(__impf_ABS__(x[1] - 1.) < 1e-8);
+	assert(__impf_ABS__(x[2] - 6.) < 1e-8);
+	assert(cnt.ninit == 2);  /* phase 1 and phase 2 */
+	assert(cnt.nenter > cnt.nupdate && cnt.nupdate > 0);
+	return 0;
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <impf/fmin_lp.h>
+#include <stdio.h>
+
+/* LP Example (presolve and postsolve)
+ *
+ *         min    x1 + 2 * x2 + 3 * x3 + x4
+ *         s.t.   x1 +     x2 +     x3      >= 4
+ *                     2 * x2               == 2
+ *                x1                   + x4 <= 3
+ *                0 <= x1 <= 5, 0 <= x2, 0 <= x3 <= 4, 0 <= x4
+ *
+ * Row 2 fixes x2 = 1 and column x4 is dominated at its lower bound 0, so
+ * that presolve leaves a smaller LP. The solution is (3, 1, 0, 0) and the
+ * optimal value is 5
+ *
+ * The LP becomes infeasible if the rhs of row 3 is -1
+ */
+#define M 3        /* number of constraints */
+#define N 4        /* number of variables   */
+
+double obj[] = {1., 2., 3., 1.};
+double constraint_1_coef[] = {1., 1., 1., 0.};
+double constraint_2_coef[] = {0., 2., 0., 0.};
+double constraint_3_coef[] = {1., 0., 0., 1.};
+
+struct impf_LinearConstraint constraints[] = {
+	{ "", constraint_1_coef, 4., impf_CONS_T_GE },
+	{ "", constraint_2_coef, 2., impf_CONS_T_EQ },
+	{ "", constraint_3_coef, 3., impf_CONS_T_LE }
+};
+struct impf_VariableBound bounds[] = {
+	{ "x1", 0., 5., impf_BOUND_T_BS, impf_VAR_T_REAL },
+	{ "x2", 0., 0., impf_BOUND_T_LO, impf_VAR_T_REAL },
+	{ "x3", 0., 4., impf_BOUND_T_BS, impf_VAR_T_REAL },
+	{ "x4", 0., 0., impf_BOUND_T_LO, impf_VAR_T_REAL }
+};
+
+int main(void)
+{
+	struct impf_LP_Presolve ps;
+	double x[N], x2[N], value;
+	int code, i, j;
+	int state = impf_lp_presolve(obj, constraints, bounds, M, N, &ps, &code);
+
+	printf("Error code = %u, m = %i, n = %i\n", code, ps.m, ps.n);
+	assert(state == impf_EXIT_SUCCESS);
+	assert(ps.m < M && ps.n < N);
+
+	/* solve the presolved LP (feasible by construction of the example) */
+	if (ps.n > 0) {
+		state = impf_lp_simplex(ps.objective, ps.constraints, ps.bounds,
+					ps.m, ps.n, "", 1000, x2, &value, &code);
+		assert(state == impf_EXIT_SUCCESS);
+	} else
+		value = 0.;
+	impf_lp_postsolve(&ps, x2, value, x, &value);
+	impf_lp_presolve_free(&ps);
+
+	assert(__impf_ABS__(value - 5.) < 1e-8);
+	assert(__impf_ABS__(x[0] - 3.) < 1e-8);
+	assert(__impf_ABS__(x[1] - 1.) < 1e-8);
+	assert(__impf_ABS__(x[2] - 0.) < 1e-8);
+	assert(__impf_ABS__(x[3] - 0.) < 1e-8);
+
+	/* the original LP is satisfied by the postsolved solution */
+	for (i = 0; i < M; i++) {
+		double ax = 0.;
+
+		for (j = 0; j < N; j++)
+			ax += constraints[i].coef[j] * x[j];
+		assert(constraints[i].type != impf_CONS_T_GE || ax >= constraints[i].rhs - 1e-8);
+		assert(constraints[i].type != impf_CONS_T_LE || ax <= constraints[i].rhs + 1e-8);
+		assert(constraints[i].type != impf_CONS_T_EQ
+		       || __impf_ABS__(ax - constraints[i].rhs) < 1e-8);
+	}
+
+	/* infeasibility is detected by presolve */
+	constraints[2].rhs = -1.;
+	state = impf_lp_presolve(obj, constraints, bounds, M, N, &ps, &code);
+	printf("Error code = %u\n", code);
+	assert(state == impf_EXIT_FAILURE);
+	assert(code == impf_Infeasibility);
+
+	state = impf_lp_simplex(obj, constraints, bounds, M, N, "", 1000, x, &value, &code);
+	assert(state == impf_EXIT_FAILURE);
+	assert(code == impf_Infeasibility);
+	return 0;
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <impf/fmin_lp.h>
+#include <stdio.h>
+
+/* LP Example (badly scaled)
+ *
+ *         max    3 * x + 4e-4 * y
+ *         s.t.   1e6 * x +  2e2 * y <= 14e6
+ *                  3 * x - 1e-4 * y >=  0
+ *               1e-3 * x - 1e-7 * y <=  2e-3
+ *                x, y >= 0
+ *
+ * This is the LP of `test_lp_simplex_2.c` with rows scaled by 1e6 and 1e-3
+ * and y scaled by 1e4. The solution is (6., 4e4) and the optimal value is 34
+ *
+ * With y further scaled by 1e236, the exponents of coefficients spread over
+ * 480 binades. With an infinite coefficient of y in the last row, y is
+ * forced to 0, the solution is (2, 0) and the optimal value is 6
+ */
+#define m 3        /* number of constraints */
+#define n 2        /* number of variables   */
+
+double obj[] = {-3., -4e-4};     /* transform "max" into "min" */
+double constraint_1_coef[] = {1e6, 2e2};
+double constraint_2_coef[] = {3., -1e-4};
+double constraint_3_coef[] = {1e-3, -1e-7};
+
+struct impf_LinearConstraint constraints[] = {
+	{ "", constraint_1_coef, 14e6, impf_CONS_T_LE },
+	{ "", constraint_2_coef,   0., impf_CONS_T_GE },
+	{ "", constraint_3_coef, 2e-3, impf_CONS_T_LE }
+};
+
+int main(void)
+{
+	/* call simplex subroutine */
+	double x[n], value;
+	int code;
+	int state = impf_lp_simplex_std(obj, constraints, m, n, "", 1000, x, &value, &code);
+
+	printf("Error code = %u\n", code);
+	assert(state == impf_EXIT_SUCCESS);
+	assert(__impf_ABS__(value + 34.) < 1e-8);
+	assert(__impf_ABS__(x[0] - 6.) < 1e-8);
+	assert(__impf_ABS__(x[1] - 4e4) < 1e-4);
+
+	/* wide exponents */
+	obj[1] *= 1e236;
+	constraint_1_coef[1] *= 1e236;
+	constraint_2_coef[1] *= 1e236;
+	constraint_3_coef[1] *= 1e236;
+	state = impf_lp_simplex_std(obj, constraints, m, n, "", 1000, x, &value, &code);
+	printf("Error code = %u\n", code);
+	assert(state == impf_EXIT_SUCCESS);
+	assert(__impf_ABS__(value + 34.) < 1e-8);
+	assert(__impf_ABS__(x[0] - 6.) < 1e-8);
+	assert(__impf_ABS__(x[1] - 4e-232) < 1e-240);
+
+	/* infinite coefficient is not scaled */
+	constraint_3_coef[1] = __impf_INF__;
+	state = impf_lp_simplex_std(obj, constraints, m, n, "", 1000, x, &value, &code);
+	printf("Error code = %u\n", code);
+	assert(state == impf_EXIT_SUCCESS);
+	assert(__impf_ABS__(value + 6.) < 1e-8);
+	assert(__impf_ABS__(x[0] - 2.) < 1e-8);
+	assert(x[1] == 0.);
+	return 0;
+}
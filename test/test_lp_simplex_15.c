@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <impf/fmin_lp.h>
+#include <stdio.h>
+
+/* LP Example (warm start)
+ *
+ *         max    x1 + 2 * x2 + 3 * x3
+ *         s.t.   x1 +     x2 +     x3 <=  7
+ *                         x2 +     x3 ==  4
+ *                x1 -     x2          >= -1
+ *                0 <= x1, x2, x3 <= 4
+ *
+ * The solution is (3, 0, 4) and the optimal value is 15
+ *
+ * With objective x1 + 2 * x2 + x3, the solution is (3, 4, 0) and the optimal
+ * value is 11
+ */
+#define M 3        /* number of constraints */
+#define N 3        /* number of variables   */
+
+double obj[] = {-1., -2., -3.};        /* transform "max" into "min" */
+double obj2[] = {-1., -2., -1.};
+double constraint_1_coef[] = {1.,  1., 1.};
+double constraint_2_coef[] = {0.,  1., 1.};
+double constraint_3_coef[] = {1., -1., 0.};
+
+struct impf_LinearConstraint constraints[] = {
+	{ "", constraint_1_coef,  7., impf_CONS_T_LE },
+	{ "", constraint_2_coef,  4., impf_CONS_T_EQ },
+	{ "", constraint_3_coef, -1., impf_CONS_T_GE }
+};
+double ub[] = {4., 4., 4.};
+
+/* State of the rule: number of calls of each callback */
+struct counter {
+	int ninit;
+	int nupdate;
+};
+
+void count_init(void *state, const double *table, const int ldtable, const int *basis,
+		const int _m, const int _n)
+{
+	((struct counter *)state)->ninit++;
+}
+
+/* Dantzig's rule */
+int count_enter(void *state, const double *table, const int ldtable, const int *basis,
+		const int *isbasic, const double *ub, const int _m, const int _n)
+{
+	int j, q = _n;
+
+	for (j = 0; j < _n; j++) {
+		if (!isbasic[j] && table[j] > 1e-9 && (q == _n || table[j] > table[q]))
+			q = j;
+	}
+	return q;
+}
+
+void count_update(void *state, const double *table, const int ldtable, const int *basis,
+		  const int _m, const int _n, const int p, const int q)
+{
+	((struct counter *)state)->nupdate++;
+}
+
+int main(void)
+{
+	struct counter cnt = {0, 0};
+	struct impf_PricingRule rule = {"count", count_init, count_enter, count_update, NULL};
+	int status[N + M], status2[N + M], lower[N + M];
+	double x[N], value;
+	int code, j;
+	int state;
+
+	rule.state = &cnt;
+	assert(impf_lp_pricing_register(&rule) == impf_EXIT_SUCCESS);
+
+	/* cold start, exporting the optimal basis */
+	state = impf_lp_simplex_warm(obj, constraints, ub, M, N, "count", 1000, NULL, status,
+				     x, &value, &code);
+	printf("Error code = %u, init = %i, update = %i\n", code, cnt.ninit, cnt.nupdate);
+	assert(state == impf_EXIT_SUCCESS);
+	assert(cnt.ninit == 2);
+	assert(__impf_ABS__(value + 15.) < 1e-8);
+	assert(__impf_ABS__(x[0] - 3.) < 1e-8);
+	assert(__impf_ABS__(x[1] - 0.) < 1e-8);
+	assert(__impf_ABS__(x[2] - 4.) < 1e-8);
+	assert(status[4] == impf_BASIS_T_LOWER);  /* slack of "EQ" constraint */
+
+	/* warm start from the optimal basis: no Phase 1 and no pivot */
+	cnt.ninit = 0;
+	cnt.nupdate = 0;
+	state = impf_lp_simplex_warm(obj, constraints, ub, M, N, "count", 1000, status, status2,
+				     x, &value, &code);
+	printf("Error code = %u, init = %i, update = %i\n", code, cnt.ninit, cnt.nupdate);
+	assert(state == impf_EXIT_SUCCESS);
+	assert(cnt.ninit == 1);
+	assert(cnt.nupdate == 0);
+	assert(__impf_ABS__(value + 15.) < 1e-8);
+	for (j = 0; j < N + M; j++)
+		assert(status[j] == status2[j]);
+
+	/* warm start after the objective changes */
+	cnt.ninit = 0;
+	state = impf_lp_simplex_warm(obj2, constraints, ub, M, N, "count", 1000, status, status2,
+				     x, &value, &code);
+	printf("Error code = %u, init = %i, update = %i\n", code, cnt.ninit, cnt.nupdate);
+	assert(state == impf_EXIT_SUCCESS);
+	assert(cnt.ninit == 1);
+	assert(__impf_ABS__(value + 11.) < 1e-8);
+	assert(__impf_ABS__(x[0] - 3.) < 1e-8);
+	assert(__impf_ABS__(x[1] - 4.) < 1e-8);
+	assert(__impf_ABS__(x[2] - 0.) < 1e-8);
+
+	/* not a basis: solved from scratch */
+	for (j = 0; j < N + M; j++)
+		lower[j] = impf_BASIS_T_LOWER;
+	cnt.ninit = 0;
+	state = impf_lp_simplex_warm(obj2, constraints, ub, M, N, "count", 1000, lower, NULL,
+				     x, &value, &code);
+	assert(state == impf_EXIT_SUCCESS);
+	assert(cnt.ninit == 2);
+	assert(__impf_ABS__(value + 11.) < 1e-8);
+	return 0;
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <impf/fmin_lp.h>
+#include <stdio.h>
+
+/* LP Example (multithreaded simplex table)
+ *
+ *         min    c'x
+ *         s.t.   A x <= b, x >= 0
+ *
+ * where c < 0, A > 0 and b > 0 are pseudo-random, so that the LP is feasible
+ * and bounded. The LP is solved in workspaces of 1 and 4 threads, which should
+ * follow the same pivots
+ *
+ * The tall LP of M2 rows shares the ratio test and pricing among threads as
+ * well (see `__impf_CTR_SPLX_PARALLEL__`), not only the pivot update
+ */
+#define M 80       /* number of constraints */
+#define N 400      /* number of variables   */
+#define M2 2048    /* number of constraints of the tall LP */
+#define N2 64      /* number of variables of the tall LP   */
+
+double obj[N];
+double coef[M * N];
+struct impf_LinearConstraint constraints[M];
+double coef2[M2 * N2];
+struct impf_LinearConstraint constraints2[M2];
+
+static double lcg(unsigned long *seed)
+{
+	*seed = (*seed * 1103515245UL + 12345UL) % 2147483648UL;
+	return (double)(*seed) / 2147483648.;
+}
+
+int main(void)
+{
+	struct impf_LP_Workspace ws1, ws4;
+	double x1[N], x2[N], value1, value2;
+	int code, i, j, k, state;
+	unsigned long seed = 1;
+	const char *criteria[] = {"dantzig", "steepest", ""};
+
+	for (j = 0; j < N; j++)
+		obj[j] = -1. - lcg(&seed);
+	for (i = 0; i < M; i++) {
+		for (j = 0; j < N; j++)
+			coef[j + i * N] = lcg(&seed) < .5 ? 0. : .1 + lcg(&seed);
+		constraints[i].coef = coef + i * N;
+		constraints[i].rhs = 10. + 10. * lcg(&seed);
+		constraints[i].type = impf_CONS_T_LE;
+	}
+	assert(impf_lp_workspace_init(&ws1, M, N, &code) == impf_EXIT_SUCCESS);
+	assert(impf_lp_workspace_init(&ws4, M, N, &code) == impf_EXIT_SUCCESS);
+	assert(ws1.nthreads == 1);
+	ws4.nthreads = 4;
+	for (k = 0; k < 3; k++) {
+		state = impf_lp_simplex_ws(obj, constraints, NULL, M, N, criteria[k], 10000, NULL, NULL,
+					   x1, &value1, &ws1, &code);
+		printf("Error code = %u, value = %f\n", code, value1);
+		assert(state == impf_EXIT_SUCCESS);
+
+		state = impf_lp_simplex_ws(obj, constraints, NULL, M, N, criteria[k], 10000, NULL, NULL,
+					   x2, &value2, &ws4, &code);
+		printf("Error code = %u, value = %f\n", code, value2);
+		assert(state == impf_EXIT_SUCCESS);
+		assert(__impf_ABS__(value1 - value2) < 1e-8);
+		for (j = 0; j < N; j++)
+			assert(__impf_ABS__(x1[j] - x2[j]) < 1e-8);
+	}
+
+	/* tall LP */
+	for (i = 0; i < M2; i++) {
+		for (j = 0; j < N2; j++)
+			coef2[j + i * N2] = lcg(&seed) < .5 ? 0. : .1 + lcg(&seed);
+		constraints2[i].coef = coef2 + i * N2;
+		constraints2[i].rhs = 10. + 10. * lcg(&seed);
+		constraints2[i].type = impf_CONS_T_LE;
+	}
+	for (k = 0; k < 3; k++) {
+		state = impf_lp_simplex_ws(obj, constraints2, NULL, M2, N2, criteria[k], 10000, NULL, NULL,
+					   x1, &value1, &ws1, &code);
+		printf("Error code = %u, value = %f\n", code, value1);
+		assert(state == impf_EXIT_SUCCESS);
+
+		state = impf_lp_simplex_ws(obj, constraints2, NULL, M2, N2, criteria[k], 10000, NULL, NULL,
+					   x2, &value2, &ws4, &code);
+		printf("Error code = %u, value = %f\n", code, value2);
+		assert(state == impf_EXIT_SUCCESS);
+		assert(__impf_ABS__(value1 - value2) < 1e-8);
+		for (j = 0; j < N2; j++)
+			assert(__impf_ABS__(x1[j] - x2[j]) < 1e-8);
+	}
+
+	ws1.nthreads = 0;
+	state = impf_lp_simplex_ws(obj, constraints, NULL, M, N, "", 10000, NULL, NULL, x1, &value1, &ws1, &code);
+	assert(state == impf_EXIT_FAILURE);
+	assert(code == impf_CondUnsatisfied);
+	impf_lp_workspace_free(&ws1);
+	impf_lp_workspace_free(&ws4);
+	return 0;
+}
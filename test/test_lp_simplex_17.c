@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <impf/fmin_lp.h>
+#include <stdio.h>
+
+/* LP Example (repeated solves in a workspace)
+ *
+ *         max    x1 + 2 * x2 + 3 * x3
+ *         s.t.   x1 +     x2 +     x3 <=  b1
+ *                         x2 +     x3 ==  4
+ *                x1 -     x2          >= -1
+ *                0 <= x1, x2, x3 <= 4
+ *
+ * For b1 = 5, 6, 7 the solution is (b1 - 4, 0, 4) and the optimal value is
+ * b1 + 8
+ *
+ * The constraints together with x1 + x2 + x3 + x4 <= 9 (0 <= x4) need a
+ * larger workspace, the solution is (3, 0, 4, 2) and the optimal value is 16
+ * for objective x1 + 2 * x2 + 3 * x3 + 0.5 * x4
+ */
+#define M 3        /* number of constraints */
+#define N 3        /* number of variables   */
+
+double obj[] = {-1., -2., -3.};        /* transform "max" into "min" */
+double constraint_1_coef[] = {1.,  1., 1.};
+double constraint_2_coef[] = {0.,  1., 1.};
+double constraint_3_coef[] = {1., -1., 0.};
+
+struct impf_LinearConstraint constraints[] = {
+	{ "", constraint_1_coef,  7., impf_CONS_T_LE },
+	{ "", constraint_2_coef,  4., impf_CONS_T_EQ },
+	{ "", constraint_3_coef, -1., impf_CONS_T_GE }
+};
+double ub[] = {4., 4., 4.};
+
+double obj4[] = {-1., -2., -3., -.5};
+double constraint4_1_coef[] = {1.,  1., 1., 0.};
+double constraint4_2_coef[] = {0.,  1., 1., 0.};
+double constraint4_3_coef[] = {1., -1., 0., 0.};
+double constraint4_4_coef[] = {1.,  1., 1., 1.};
+
+struct impf_LinearConstraint constraints4[] = {
+	{ "", constraint4_1_coef,  7., impf_CONS_T_LE },
+	{ "", constraint4_2_coef,  4., impf_CONS_T_EQ },
+	{ "", constraint4_3_coef, -1., impf_CONS_T_GE },
+	{ "", constraint4_4_coef,  9., impf_CONS_T_LE }
+};
+double ub4[] = {4., 4., 4., __impf_INF__};
+
+int main(void)
+{
+	struct impf_LP_Workspace ws;
+	int status[N + M], status2[N + M];
+	double x[N + 1], x2[N], value, value2, *dbl;
+	int code, k, state;
+
+	assert(impf_lp_workspace_init(&ws, M, N, &code) == impf_EXIT_SUCCESS);
+	dbl = ws.dbl;
+
+	/* the same results as solving without workspace, buffers are reused */
+	for (k = 5; k <= 7; k++) {
+		constraints[0].rhs = k;
+		state = impf_lp_simplex_ws(obj, constraints, ub, M, N, "", 1000, NULL, status,
+					   x, &value, &ws, &code);
+		printf("Error code = %u, value = %f\n", code, value);
+		assert(state == impf_EXIT_SUCCESS);
+		assert(ws.dbl == dbl);
+		assert(__impf_ABS__(value + k + 8.) < 1e-8);
+		assert(__impf_ABS__(x[0] - k + 4.) < 1e-8);
+		assert(__impf_ABS__(x[1] - 0.) < 1e-8);
+		assert(__impf_ABS__(x[2] - 4.) < 1e-8);
+
+		state = impf_lp_simplex_bnd(obj, constraints, ub, M, N, "", 1000, x2, &value2, &code);
+		assert(state == impf_EXIT_SUCCESS);
+		assert(value == value2);
+	}
+
+	/* warm start in workspace */
+	state = impf_lp_simplex_ws(obj, constraints, ub, M, N, "", 1000, status, status2,
+				   x, &value, &ws, &code);
+	assert(state == impf_EXIT_SUCCESS);
+	assert(ws.dbl == dbl);
+	assert(__impf_ABS__(value + 15.) < 1e-8);
+	for (k = 0; k < N + M; k++)
+		assert(status[k] == status2[k]);
+
+	/* failures leave the workspace usable */
+	constraints[0].rhs = 3.;
+	state = impf_lp_simplex_ws(obj, constraints, ub, M, N, "", 1000, NULL, NULL,
+				   x, &value, &ws, &code);
+	assert(state == impf_EXIT_FAILURE);
+	assert(code == impf_Infeasibility);
+	constraints[0].rhs = 7.;
+
+	/* a larger LP enlarges the workspace */
+	state = impf_lp_simplex_ws(obj4, constraints4, ub4, M + 1, N + 1, "", 1000, NULL, NULL,
+				   x, &value, &ws, &code);
+	printf("Error code = %u, value = %f\n", code, value);
+	assert(state == impf_EXIT_SUCCESS);
+	assert(ws.m == M + 1 && ws.n == N + 1);
+	assert(__impf_ABS__(value + 16.) < 1e-8);
+	assert(__impf_ABS__(x[0] - 3.) < 1e-8);
+	assert(__impf_ABS__(x[2] - 4.) < 1e-8);
+	assert(__impf_ABS__(x[3] - 2.) < 1e-8);
+	dbl = ws.dbl;
+	state = impf_lp_simplex_ws(obj, constraints, ub, M, N, "", 1000, NULL, NULL,
+				   x, &value, &ws, &code);
+	assert(state == impf_EXIT_SUCCESS);
+	assert(ws.dbl == dbl);
+	assert(__impf_ABS__(value + 15.) < 1e-8);
+	impf_lp_workspace_free(&ws);
+	return 0;
+}
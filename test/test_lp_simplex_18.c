@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <impf/fmin_lp.h>
+#include <stdio.h>
+
+/* LP Example (batch solving)
+ *
+ *         max    c1 * x1 + c2 * x2 + 3 * x3
+ *         s.t.   x1 +     x2 +     x3 <=  b1
+ *                         x2 +     x3 ==  4
+ *                x1 -     x2          >= -1
+ *                0 <= x1, x2, x3 <= 4
+ *
+ * Instances of different c1, c2 and b1 are solved in a batch, with the same
+ * results as solved one by one. The LP is infeasible if b1 < 4
+ */
+#define M 3        /* number of constraints */
+#define N 3        /* number of variables   */
+#define K 64       /* number of instances   */
+
+double constraint_1_coef[] = {1.,  1., 1.};
+double constraint_2_coef[] = {0.,  1., 1.};
+double constraint_3_coef[] = {1., -1., 0.};
+
+struct impf_LinearConstraint constraints[] = {
+	{ "", constraint_1_coef,  7., impf_CONS_T_LE },
+	{ "", constraint_2_coef,  4., impf_CONS_T_EQ },
+	{ "", constraint_3_coef, -1., impf_CONS_T_GE }
+};
+double ub[] = {4., 4., 4.};
+struct impf_VariableBound bounds[] = {
+	{ "x1", 0., 4., impf_BOUND_T_BS, impf_VAR_T_REAL },
+	{ "x2", 0., 4., impf_BOUND_T_BS, impf_VAR_T_REAL },
+	{ "x3", 0., 4., impf_BOUND_T_BS, impf_VAR_T_REAL }
+};
+
+double objs[K * N], rhs[K * M], x[K * N], value[K];
+int code[K];
+
+int main(void)
+{
+	struct impf_LinearConstraint cons[M];
+	struct impf_Model_LP models[2];
+	double x1[N], value1, coef[M * N], *xs[2];
+	int i, j, k, nthreads, code1, state;
+
+	for (k = 0; k < K; k++) {
+		objs[k * N] = -1. - (k % 5) * .5;  /* transform "max" into "min" */
+		objs[k * N + 1] = -2. + (k % 3) * .7;
+		objs[k * N + 2] = -3.;
+		rhs[k * M] = 4.5 + (k % 7) * .5;
+		rhs[k * M + 1] = 4.;
+		rhs[k * M + 2] = -1.;
+	}
+	for (nthreads = 1; nthreads <= 4; nthreads += 3) {
+		state = impf_lp_simplex_bnd_batch(objs, constraints, rhs, ub, M, N, K, "", 1000, nthreads,
+						  x, value, code);
+		assert(state == impf_EXIT_SUCCESS);
+		for (k = 0; k < K; k++) {
+			for (i = 0; i < M; i++) {
+				cons[i] = constraints[i];
+				cons[i].rhs = rhs[k * M + i];
+			}
+			state = impf_lp_simplex_bnd(objs + k * N, cons, ub, M, N, "", 1000, x1, &value1, &code1);
+			assert(state == impf_EXIT_SUCCESS);
+			assert(code[k] == impf_Success);
+			assert(value[k] == value1);
+			for (j = 0; j < N; j++)
+				assert(x[k * N + j] == x1[j]);
+		}
+		printf("threads = %i, value[0] = %f\n", nthreads, value[0]);
+	}
+
+	/* an infeasible instance fails alone */
+	rhs[5 * M] = 3.;
+	state = impf_lp_simplex_bnd_batch(objs, constraints, rhs, ub, M, N, K, "", 1000, 4, x, value, code);
+	assert(state == impf_EXIT_FAILURE);
+	for (k = 0; k < K; k++)
+		assert(code[k] == (k == 5 ? impf_Infeasibility : impf_Success));
+
+	/* the rhs of constraints for all instances */
+	state = impf_lp_simplex_bnd_batch(objs, constraints, NULL, ub, M, N, K, "", 1000, 4, x, value, code);
+	assert(state == impf_EXIT_SUCCESS);
+	assert(__impf_ABS__(value[0] + 15.) < 1e-8);
+
+	/* batch of models */
+	for (i = 0; i < M; i++) {
+		for (j = 0; j < N; j++)
+			coef[j + i * N] = constraints[i].coef[j];
+	}
+	for (k = 0; k < 2; k++) {
+		models[k].m = M;
+		models[k].n = N;
+		models[k].nnz = 0;
+		models[k].objective = objs + k * N;
+		models[k].coefficients = coef;
+		models[k].colptr = NULL;
+		models[k].rowidx = NULL;
+		models[k].values = NULL;
+		models[k].constraints = constraints;
+		models[k].bounds = bounds;
+		xs[k] = x + k * N;
+	}
+	state = impf_lp_simplex_batch(models, 2, "", 1000, 2, xs, value, code);
+	assert(state == impf_EXIT_SUCCESS);
+	for (k = 0; k < 2; k++) {
+		state = impf_lp_simplex(objs + k * N, constraints, bounds, M, N, "", 1000, x1, &value1, &code1);
+		assert(state == impf_EXIT_SUCCESS);
+		assert(code[k] == impf_Success);
+		assert(__impf_ABS__(value[k] - value1) < 1e-8);
+		for (j = 0; j < N; j++)
+			assert(__impf_ABS__(xs[k][j] - x1[j]) < 1e-8);
+	}
+	return 0;
+}
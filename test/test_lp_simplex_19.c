@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <impf/fmin_lp.h>
+#include <stdio.h>
+
+/* LP Example (sensitivity analysis)
+ *
+ *         max    3 * x1 + 5 * x2 + x3
+ *         s.t.   x1                     <=  4
+ *                         2 * x2        <= 12
+ *                3 * x1 + 2 * x2 + 2 * x3 == 18
+ *                0 <= x1, x2, x3
+ *
+ * The solution is (2, 6, 0) and the optimal value is 36. In "min" form
+ *	duals		(0, -1.5, -1)
+ *	reduced costs	(0, 0, 1)
+ *	cost ranges	[-7.5, -1.5], (-inf, -2], [-2, inf)
+ *	rhs ranges	[2, inf), [6, 18], [12, 24]
+ */
+#define M 3        /* number of constraints */
+#define N 3        /* number of variables   */
+
+double obj[] = {-3., -5., -1.};        /* transform "max" into "min" */
+double constraint_1_coef[] = {1., 0., 0.};
+double constraint_2_coef[] = {0., 2., 0.};
+double constraint_3_coef[] = {3., 2., 2.};
+
+struct impf_LinearConstraint constraints[] = {
+	{ "", constraint_1_coef,  4., impf_CONS_T_LE },
+	{ "", constraint_2_coef, 12., impf_CONS_T_LE },
+	{ "", constraint_3_coef, 18., impf_CONS_T_EQ }
+};
+
+double dual0[] = {0., -1.5, -1.};
+double redcost0[] = {0., 0., 1.};
+double objlo0[] = {-7.5, __impf_NINF__, -2.};
+double objup0[] = {-1.5, -2., __impf_INF__};
+double rhslo0[] = {2., 6., 12.};
+double rhsup0[] = {__impf_INF__, 18., 24.};
+
+static int is_close(const double a, const double b)
+{
+	if (a == b)  /* infinities */
+		return 1;
+	return __impf_ABS__(a - b) < 1e-8;
+}
+
+int main(void)
+{
+	double x[N], value;
+	double dual[M], redcost[N], objlo[N], objup[N], rhslo[M], rhsup[M];
+	struct impf_LP_Sensitivity sens;
+	int code, i, j;
+	int state;
+
+	sens.dual = dual;
+	sens.redcost = redcost;
+	sens.objlo = objlo;
+	sens.objup = objup;
+	sens.rhslo = rhslo;
+	sens.rhsup = rhsup;
+	state = impf_lp_simplex_sens(obj, constraints, NULL, M, N, "", 1000, x, &value, &sens, &code);
+	printf("Error code = %u, value = %f\n", code, value);
+	assert(state == impf_EXIT_SUCCESS);
+	assert(__impf_ABS__(value + 36.) < 1e-8);
+	assert(__impf_ABS__(x[0] - 2.) < 1e-8);
+	assert(__impf_ABS__(x[1] - 6.) < 1e-8);
+	assert(__impf_ABS__(x[2] - 0.) < 1e-8);
+
+	for (i = 0; i < M; i++) {
+		printf("row %i: dual = %f, rhs in [%f, %f]\n", i, dual[i], rhslo[i], rhsup[i]);
+		assert(is_close(dual[i], dual0[i]));
+		assert(is_close(rhslo[i], rhslo0[i]));
+		assert(is_close(rhsup[i], rhsup0[i]));
+	}
+	for (j = 0; j < N; j++) {
+		printf("col %i: reduced cost = %f, cost in [%f, %f]\n", j, redcost[j], objlo[j], objup[j]);
+		assert(is_close(redcost[j], redcost0[j]));
+		assert(is_close(objlo[j], objlo0[j]));
+		assert(is_close(objup[j], objup0[j]));
+	}
+
+	/* only some of the results */
+	sens.dual = NULL;
+	sens.rhslo = NULL;
+	sens.rhsup = NULL;
+	sens.objup = NULL;
+	state = impf_lp_simplex_sens(obj, constraints, NULL, M, N, "", 1000, x, &value, &sens, &code);
+	assert(state == impf_EXIT_SUCCESS);
+	assert(is_close(objlo[0], objlo0[0]));
+	assert(is_close(redcost[2], redcost0[2]));
+	return 0;
+}
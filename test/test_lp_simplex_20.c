@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <impf/fmin_lp.h>
+#include <stdio.h>
+
+/* LP Example (parametric LP)
+ *
+ *         max    3 * x1 + 5 * x2 + x3
+ *         s.t.   x1                     <=  4
+ *                         2 * x2        <= 12
+ *                3 * x1 + 2 * x2 + 2 * x3 == 18 + t * db
+ *                0 <= x1, x2, x3
+ *
+ * In "min" form, the optimal value is
+ *	db = 1:		-36 - t on [0, 6], -42 - (t - 6) / 2 on [6, 10]
+ *	db = -1:	-36 + t on [0, 6], -30 + 2.5 * (t - 6) on [6, 18], and the
+ *			LP is infeasible for t > 18
+ *
+ * With the cost of x2 being -5 + t instead, the solution is (2, 6, 0) on
+ * [0, 3], (4, 3, 0) on [3, 4] and (4, 0, 3) on [4, 10]
+ */
+#define M 3        /* number of constraints */
+#define N 3        /* number of variables   */
+
+double obj[] = {-3., -5., -1.};        /* transform "max" into "min" */
+double constraint_1_coef[] = {1., 0., 0.};
+double constraint_2_coef[] = {0., 2., 0.};
+double constraint_3_coef[] = {3., 2., 2.};
+
+struct impf_LinearConstraint constraints[] = {
+	{ "", constraint_1_coef,  4., impf_CONS_T_LE },
+	{ "", constraint_2_coef, 12., impf_CONS_T_LE },
+	{ "", constraint_3_coef, 18., impf_CONS_T_EQ }
+};
+
+double drhs_up[] = {0., 0., 1.};
+double drhs_down[] = {0., 0., -1.};
+double dobj[] = {0., 1., 0.};
+
+double t_up[] = {0., 6., 10.}, value_up[] = {-36., -42., -44.};
+double t_down[] = {0., 6., 18.}, value_down[] = {-36., -30., 0.};
+double t_obj[] = {0., 3., 4., 10.}, value_obj[] = {-36., -18., -15., -15.};
+double x_obj[] = {2., 6., 0., 4., 3., 0., 4., 0., 3., 4., 0., 3.};
+
+/* The trace agrees with solving LPs at a grid of t one by one
+ */
+static void check_grid(const struct impf_LP_Parametric *trace, const double *drhs, const double *dc)
+{
+	struct impf_LinearConstraint cons[M];
+	double c[N], x[N], value, t, v;
+	int i, j, k, code;
+
+	for (t = 0.; t <= trace->t[trace->nseg]; t += .25) {
+		for (i = 0; i < M; i++) {
+			cons[i] = constraints[i];
+			cons[i].rhs += drhs != NULL ? t * drhs[i] : 0.;
+		}
+		for (j = 0; j < N; j++)
+			c[j] = obj[j] + (dc != NULL ? t * dc[j] : 0.);
+		assert(impf_lp_simplex_bnd(c, cons, NULL, M, N, "", 1000, x, &value, &code) == impf_EXIT_SUCCESS);
+		for (k = 0; k < trace->nseg - 1 && trace->t[k + 1] < t; k++)
+			;
+		v = trace->value[k] + (trace->value[k + 1] - trace->value[k])
+		    * (t - trace->t[k]) / (trace->t[k + 1] - trace->t[k]);
+		assert(__impf_ABS__(value - v) < 1e-8);
+	}
+}
+
+static void check_trace(const struct impf_LP_Parametric *trace, const int nseg,
+			const double *t, const double *value)
+{
+	int k;
+
+	assert(trace->nseg == nseg);
+	for (k = 0; k <= nseg; k++) {
+		printf("t = %f, value = %f\n", trace->t[k], trace->value[k]);
+		assert(__impf_ABS__(trace->t[k] - t[k]) < 1e-8);
+		assert(__impf_ABS__(trace->value[k] - value[k]) < 1e-8);
+	}
+}
+
+int main(void)
+{
+	struct impf_LP_Parametric trace;
+	int code, j, k, state;
+
+	state = impf_lp_simplex_param(obj, constraints, NULL, M, N, "", 1000, drhs_up, NULL, 10.,
+				      &trace, &code);
+	printf("Error code = %u, segments = %i\n", code, trace.nseg);
+	assert(state == impf_EXIT_SUCCESS);
+	assert(trace.stop == impf_Success);
+	check_trace(&trace, 2, t_up, value_up);
+	check_grid(&trace, drhs_up, NULL);
+	assert(trace.status[N + M] == impf_BASIS_T_BASIC);       /* x1 of segment 1 */
+	assert(trace.status[N + M + N] == impf_BASIS_T_LOWER);   /* slack of row 1 */
+	impf_lp_parametric_free(&trace);
+
+	state = impf_lp_simplex_param(obj, constraints, NULL, M, N, "", 1000, drhs_down, NULL, 25.,
+				      &trace, &code);
+	assert(state == impf_EXIT_SUCCESS);
+	assert(trace.stop == impf_Infeasibility);
+	check_trace(&trace, 2, t_down, value_down);
+	check_grid(&trace, drhs_down, NULL);
+	impf_lp_parametric_free(&trace);
+
+	state = impf_lp_simplex_param(obj, constraints, NULL, M, N, "steepest", 1000, NULL, dobj, 10.,
+				      &trace, &code);
+	assert(state == impf_EXIT_SUCCESS);
+	assert(trace.stop == impf_Success);
+	check_trace(&trace, 3, t_obj, value_obj);
+	check_grid(&trace, NULL, dobj);
+	for (k = 0; k <= trace.nseg; k++) {
+		for (j = 0; j < N; j++)
+			assert(__impf_ABS__(trace.x[j + k * N] - x_obj[j + k * N]) < 1e-8);
+	}
+	impf_lp_parametric_free(&trace);
+
+	/* only one direction */
+	state = impf_lp_simplex_param(obj, constraints, NULL, M, N, "", 1000, drhs_up, dobj, 10.,
+				      &trace, &code);
+	assert(state == impf_EXIT_FAILURE);
+	assert(code == impf_CondUnsatisfied);
+	return 0;
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <impf/fmin_lp.h>
+#include <stdio.h>
+
+/* LP Example (column-major simplex table)
+ *
+ *         min    c'x
+ *         s.t.   a_i'x <= b_i, a_i'x >= b_i or a_i'x == b_i
+ *                0 <= x <= u
+ *
+ * where c, A and u are pseudo-random, and b is taken from a point within the
+ * bounds, so that the LP is feasible and bounded. Some rows are tight at the
+ * point against degeneracy. The LP is solved on the row-major and on the
+ * column-major tables, which should follow the same pivots
+ *
+ * The tall LP of M2 rows is solved on the column-major table by default (see
+ * `impf_LP_Workspace`)
+ */
+#define M 40       /* number of constraints */
+#define N 60       /* number of variables   */
+#define M2 2048    /* number of constraints of the tall LP */
+#define N2 96      /* number of variables of the tall LP   */
+
+double obj[N];
+double coef[M * N];
+double ub[N];
+struct impf_LinearConstraint constraints[M];
+double obj2[N2];
+double coef2[M2 * N2];
+struct impf_LinearConstraint constraints2[M2];
+
+static double lcg(unsigned long *seed)
+{
+	*seed = (*seed * 1103515245UL + 12345UL) % 2147483648UL;
+	return (double)(*seed) / 2147483648.;
+}
+
+/* Choose the attractive variable of the largest index, from row-major table */
+int last_enter(void *state, const double *table, const int ldtable, const int *basis,
+	       const int *isbasic, const double *ub, const int _m, const int _n)
+{
+	int j;
+
+	assert(ldtable > _n);
+	for (j = _n - 1; j >= 0; j--) {
+		if (!isbasic[j] && table[j] > 1e-9)
+			return j;
+	}
+	return _n;
+}
+
+/* Solve the LP in workspaces of both layouts and compare */
+static void solve_both(const double *c, const struct impf_LinearConstraint *cons, const double *u,
+		       const int m, const int n, const char *criteria,
+		       struct impf_LP_Workspace *wsr, struct impf_LP_Workspace *wsc)
+{
+	double xr[N2], xc[N2], valuer, valuec;
+	int statusr[N2 + M2], statusc[N2 + M2];
+	int code, j, state;
+
+	state = impf_lp_simplex_ws(c, cons, u, m, n, criteria, 100000, NULL, statusr, xr, &valuer, wsr, &code);
+	printf("criteria = \"%s\", error code = %u, value = %f\n", criteria, code, valuer);
+	assert(state == impf_EXIT_SUCCESS);
+
+	state = impf_lp_simplex_ws(c, cons, u, m, n, criteria, 100000, NULL, statusc, xc, &valuec, wsc, &code);
+	printf("criteria = \"%s\", error code = %u, value = %f\n", criteria, code, valuec);
+	assert(state == impf_EXIT_SUCCESS);
+	assert(__impf_ABS__(valuer - valuec) < 1e-8);
+	for (j = 0; j < n; j++)
+		assert(__impf_ABS__(xr[j] - xc[j]) < 1e-8);
+	for (j = 0; j < n + m; j++)
+		assert(statusr[j] == statusc[j]);
+}
+
+int main(void)
+{
+	struct impf_LP_Workspace wsr, wsc;
+	struct impf_PricingRule rule = { "last", NULL, last_enter, NULL, NULL };
+	double x0[N], ax;
+	int code, i, j, k;
+	unsigned long seed = 3;
+	const char *criteria[] = {"dantzig", "bland", "devex", "steepest", "partial", "", "last"};
+
+	assert(impf_lp_pricing_register(&rule) == impf_EXIT_SUCCESS);
+	for (j = 0; j < N; j++) {
+		obj[j] = lcg(&seed) - .7;
+		ub[j] = 1. + 4. * lcg(&seed);
+		x0[j] = lcg(&seed) < .3 ? 0. : ub[j] * lcg(&seed);
+	}
+	for (i = 0; i < M; i++) {
+		ax = 0.;
+		for (j = 0; j < N; j++) {
+			coef[j + i * N] = lcg(&seed) < .6 ? 0. : 2. * lcg(&seed) - .5;
+			ax += coef[j + i * N] * x0[j];
+		}
+		constraints[i].coef = coef + i * N;
+		constraints[i].type = i % 5 == 0 ? impf_CONS_T_EQ : (i % 2 ? impf_CONS_T_LE : impf_CONS_T_GE);
+		if (i % 3 == 0 || constraints[i].type == impf_CONS_T_EQ)
+			constraints[i].rhs = ax;
+		else
+			constraints[i].rhs = constraints[i].type == impf_CONS_T_LE ? ax + lcg(&seed) : ax - lcg(&seed);
+	}
+	assert(impf_lp_workspace_init(&wsr, M, N, &code) == impf_EXIT_SUCCESS);
+	assert(impf_lp_workspace_init(&wsc, M, N, &code) == impf_EXIT_SUCCESS);
+	assert(wsc.layout == impf_TABLE_T_AUTO);
+	wsr.layout = impf_TABLE_T_ROW;
+	wsc.layout = impf_TABLE_T_COL;
+	for (k = 0; k < 7; k++)
+		solve_both(obj, constraints, ub, M, N, criteria[k], &wsr, &wsc);
+
+	/* tall LP */
+	for (j = 0; j < N2; j++)
+		obj2[j] = -1. - lcg(&seed);
+	for (i = 0; i < M2; i++) {
+		for (j = 0; j < N2; j++)
+			coef2[j + i * N2] = lcg(&seed) < .5 ? 0. : .1 + lcg(&seed);
+		constraints2[i].coef = coef2 + i * N2;
+		constraints2[i].rhs = 10. + 10. * lcg(&seed);
+		constraints2[i].type = impf_CONS_T_LE;
+	}
+	wsc.layout = impf_TABLE_T_AUTO;
+	for (k = 3; k < 6; k += 2)
+		solve_both(obj2, constraints2, NULL, M2, N2, criteria[k], &wsr, &wsc);
+	impf_lp_workspace_free(&wsr);
+	impf_lp_workspace_free(&wsc);
+	return 0;
+}
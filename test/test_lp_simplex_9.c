@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2022 Zhuang Linsheng <zhuanglinsheng@outlook.com>
+ * License: LGPL 3.0 <https://www.gnu.org/licenses/lgpl-3.0.html>
+ */
+#include <impf/fmin_lp.h>
+#include <stdio.h>
+
+/* LP Example (column compressed model)
+ *
+ *         max    x1 + 2 * x2 + 3 * x3
+ *         s.t.   x1 +     x2 +     x3 <= 10
+ *                         x2 +     x3 ==  7
+ *                x1 -     x2          >= -2
+ *                0 <= x1 <= 4, 1 <= x2 <= 5, 2 <= x3 <= 6
+ *
+ * The solution is (3, 1, 6) and the optimal value is 23
+ */
+#define m 3        /* number of constraints */
+#define n 3        /* number of variables   */
+
+double obj[] = {-1., -2., -3.};        /* transform "max" into "min" */
+int colptr[] = {0, 2, 5, 7};
+int rowidx[] = {0, 2, 0, 1, 2, 0, 1};
+double values[] = {1., 1., 1., 1., -1., 1., 1.};
+
+struct impf_LinearConstraint constraints[] = {
+	{ "", NULL, 10., impf_CONS_T_LE },
+	{ "", NULL,  7., impf_CONS_T_EQ },
+	{ "", NULL, -2., impf_CONS_T_GE }
+};
+struct impf_VariableBound bounds[] = {
+	{ "x1", 0., 4., impf_BOUND_T_BS, impf_VAR_T_REAL },
+	{ "x2", 1., 5., impf_BOUND_T_BS, impf_VAR_T_REAL },
+	{ "x3", 2., 6., impf_BOUND_T_BS, impf_VAR_T_REAL }
+};
+
+int main(void)
+{
+	/* a model without dense coefficients */
+	struct impf_Model_LP model = { m, n, 7, obj, NULL, colptr, rowidx, values, constraints, bounds };
+	double x[n], value;
+	int code;
+	int state = impf_lp_simplex_wrp(&model, "", 1000, x, &value, &code);
+
+	printf("Error code = %u\n", code);
+	assert(state == impf_EXIT_SUCCESS);
+	assert(__impf_ABS__(value + 23.) < 1e-8);
+	assert(__impf_ABS__(x[0] - 3.) < 1e-8);
+	assert(__impf_ABS__(x[1] - 1.) < 1e-8);
+	assert(__impf_ABS__(x[2] - 6.) < 1e-8);
+	return 0;
+}